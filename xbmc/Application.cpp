@@ -1263,6 +1263,8 @@ bool CApplication::LoadSkin(const std::string& skinID)
       currentFocusedControlID = pWindow->GetFocusedControlID();
   }
 
+  int64_t skinStart = CurrentHostCounter();
+
   UnloadSkin();
 
   skin->Start();
@@ -1280,6 +1282,11 @@ bool CApplication::LoadSkin(const std::string& skinID)
   CLog::Log(LOGNOTICE, "  load skin from: %s (version: %s)", skin->Path().c_str(), skin->Version().asString().c_str());
   g_SkinInfo = skin;
 
+  // parse the window XMLs in the background while includes and fonts are loaded
+  const bool parallelLoad = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiParallelSkinLoad;
+  if (parallelLoad)
+    g_SkinInfo->PrefetchSkinFiles();
+
   CLog::Log(LOGINFO, "  load fonts for skin...");
   CServiceBroker::GetWinSystem()->GetGfxContext().SetMediaDir(skin->Path());
   g_directoryCache.ClearSubPaths(skin->Path());
@@ -1325,7 +1332,8 @@ bool CApplication::LoadSkin(const std::string& skinID)
   if (g_SkinInfo->HasSkinFile("DialogFullScreenInfo.xml"))
     CServiceBroker::GetGUI()->GetWindowManager().Add(new CGUIDialogFullScreenInfo);
 
-  CLog::Log(LOGINFO, "  skin loaded...");
+  CLog::Log(LOGINFO, "  skin loaded in %.2fms (%s)...", 1000.f * (CurrentHostCounter() - skinStart) / CurrentHostFrequency(),
+            parallelLoad ? "parallel" : "sequential");
 
   // leave the graphics lock
   lock.Leave();
@@ -1364,6 +1372,10 @@ bool CApplication::LoadSkin(const std::string& skinID)
     }
   }
 
+  // on a reload the UI is ready already, the restored windows took their files
+  if (currentWindowID != WINDOW_INVALID)
+    g_SkinInfo->ReleasePrefetchedSkinFiles();
+
   return true;
 }
 
@@ -1529,6 +1541,9 @@ void CApplication::Render()
   if(!CServiceBroker::GetRenderSystem()->BeginRender())
     return;
 
+  // hand background loaded images to the GPU before they are drawn
+  CServiceBroker::GetGUI()->GetLargeTextureManager().UploadTextures();
+
   // render gui layer
   if (m_renderGUI && !m_skipGuiRender)
   {
@@ -3725,6 +3740,9 @@ bool CApplication::OnMessage(CGUIMessage& message)
         // remove splash window
         CServiceBroker::GetGUI()->GetWindowManager().Delete(WINDOW_SPLASH);
 
+        if (g_SkinInfo)
+          g_SkinInfo->ReleasePrefetchedSkinFiles();
+
         // show the volumebar if the volume is muted
         if (IsMuted() || GetVolume(false) <= VOLUME_MINIMUM)
           ShowVolumeBar();
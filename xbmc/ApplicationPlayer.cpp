@@ -15,6 +15,7 @@
 #include "guilib/GUIWindowManager.h"
 #include "Application.h"
 #include "PlayListPlayer.h"
+#include "rendering/RenderSystem.h"
 #include "ServiceBroker.h"
 #include "settings/MediaSettings.h"
 
@@ -829,7 +830,11 @@ void CApplicationPlayer::Render(bool clear, uint32_t alpha, bool gui)
 {
   std::shared_ptr<IPlayer> player = GetInternal();
   if (player)
+  {
+    // the video has to end up on top of the GUI rendered so far
+    CServiceBroker::GetRenderSystem()->FlushGUIBatch();
     player->Render(clear, alpha, gui);
+  }
 }
 
 void CApplicationPlayer::FlushRenderer()
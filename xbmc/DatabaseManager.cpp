@@ -7,6 +7,7 @@
  */
 
 #include "DatabaseManager.h"
+#include "dbwrappers/dataset.h"
 #include "utils/log.h"
 #include "addons/AddonDatabase.h"
 #include "view/ViewDatabase.h"
@@ -29,7 +30,10 @@ CDatabaseManager::CDatabaseManager() :
   UpdateDatabase(db);
 }
 
-CDatabaseManager::~CDatabaseManager() = default;
+CDatabaseManager::~CDatabaseManager()
+{
+  ClearPool();
+}
 
 void CDatabaseManager::Initialize()
 {
@@ -37,6 +41,9 @@ void CDatabaseManager::Initialize()
 
   m_dbStatus.clear();
 
+  // databases are about to be updated, possibly to a new file
+  ClearPool();
+
   CLog::Log(LOGDEBUG, "%s, updating databases...", __FUNCTION__);
 
   const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
@@ -65,6 +72,76 @@ bool CDatabaseManager::CanOpen(const std::string &name)
   return false; // db isn't even attempted to update yet
 }
 
+std::unique_ptr<dbiplus::Database> CDatabaseManager::AcquireConnection(const std::string &key)
+{
+  CSingleLock lock(m_poolSection);
+  auto it = m_pool.find(key);
+  if (it == m_pool.end() || it->second.empty())
+    return std::unique_ptr<dbiplus::Database>();
+
+  std::unique_ptr<dbiplus::Database> connection = std::move(it->second.back());
+  it->second.pop_back();
+  return connection;
+}
+
+void CDatabaseManager::ReleaseConnection(const std::string &key, std::unique_ptr<dbiplus::Database> connection)
+{
+  const unsigned int poolSize = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databasePoolSize;
+
+  {
+    CSingleLock lock(m_poolSection);
+    std::vector<std::unique_ptr<dbiplus::Database>> &connections = m_pool[key];
+    if (connections.size() < poolSize)
+    {
+      connections.push_back(std::move(connection));
+      return;
+    }
+  }
+
+  // pool is full, close outside of the lock
+  connection->disconnect();
+}
+
+void CDatabaseManager::AddConnectionWait(bool pooled, unsigned int waitMs)
+{
+  CSingleLock lock(m_poolSection);
+  if (pooled)
+    m_poolStats.reused++;
+  else
+    m_poolStats.opened++;
+  m_poolStats.totalWaitMs += waitMs;
+  if (waitMs > m_poolStats.maxWaitMs)
+    m_poolStats.maxWaitMs = waitMs;
+}
+
+CDatabaseManager::PoolStats CDatabaseManager::GetPoolStats() const
+{
+  CSingleLock lock(m_poolSection);
+  return m_poolStats;
+}
+
+void CDatabaseManager::ClearPool()
+{
+  std::map<std::string, std::vector<std::unique_ptr<dbiplus::Database>>> pool;
+  {
+    CSingleLock lock(m_poolSection);
+    pool.swap(m_pool);
+
+    const unsigned int connects = m_poolStats.reused + m_poolStats.opened;
+    if (connects > 0)
+      CLog::Log(LOGDEBUG, "CDatabaseManager::ClearPool - %u connections reused, %u opened, wait avg %u ms, max %u ms",
+                m_poolStats.reused, m_poolStats.opened,
+                static_cast<unsigned int>(m_poolStats.totalWaitMs / connects), m_poolStats.maxWaitMs);
+    m_poolStats = PoolStats();
+  }
+
+  for (auto &entry : pool)
+  {
+    for (auto &connection : entry.second)
+      connection->disconnect();
+  }
+}
+
 void CDatabaseManager::UpdateDatabase(CDatabase &db, DatabaseSettings *settings)
 {
   std::string name = db.GetBaseDBName();
@@ -10,12 +10,20 @@
 
 #include <atomic>
 #include <map>
+#include <memory>
+#include <stdint.h>
 #include <string>
+#include <vector>
 #include "threads/CriticalSection.h"
 
 class CDatabase;
 class DatabaseSettings;
 
+namespace dbiplus
+{
+  class Database;
+}
+
 /*!
  \ingroup database
  \brief Database manager class for handling database updating
@@ -50,7 +58,37 @@ public:
 
   bool IsUpgrading() const { return m_bIsUpgrading; }
 
+  /*! \brief Take an idle connection from the connection pool.
+   \param key identifies the database file and connection mode.
+   \return the connection, or an empty pointer if none is available.
+   */
+  std::unique_ptr<dbiplus::Database> AcquireConnection(const std::string &key);
+
+  /*! \brief Hand a connection back to the pool for reuse.
+   The connection is closed if the pool for this key is full.
+   \param key identifies the database file and connection mode.
+   \param connection the connected database, must not be in a transaction.
+   */
+  void ReleaseConnection(const std::string &key, std::unique_ptr<dbiplus::Database> connection);
+
+  /*! \brief Account the time a database waited for a usable connection.
+   \param pooled whether the connection came from the pool.
+   \param waitMs the time taken to get the connection ready.
+   */
+  void AddConnectionWait(bool pooled, unsigned int waitMs);
+
+  struct PoolStats
+  {
+    unsigned int reused = 0; ///< connections taken from the pool
+    unsigned int opened = 0; ///< connections that had to be opened
+    uint64_t totalWaitMs = 0;
+    unsigned int maxWaitMs = 0;
+  };
+  PoolStats GetPoolStats() const;
+
 private:
+  void ClearPool();
+
   std::atomic<bool> m_bIsUpgrading;
 
   enum DB_STATUS { DB_CLOSED, DB_UPDATING, DB_READY, DB_FAILED };
@@ -61,4 +99,8 @@ private:
 
   CCriticalSection            m_section;     ///< Critical section protecting m_dbStatus.
   std::map<std::string, DB_STATUS> m_dbStatus;    ///< Our database status map.
+
+  mutable CCriticalSection m_poolSection; ///< Critical section protecting m_pool and m_poolStats.
+  std::map<std::string, std::vector<std::unique_ptr<dbiplus::Database>>> m_pool; ///< Idle connections by key.
+  PoolStats m_poolStats;
 };
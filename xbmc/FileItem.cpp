@@ -13,6 +13,7 @@
 #include "guilib/LocalizeStrings.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
+#include "utils/LabelFormatter.h"
 #include "utils/Archive.h"
 #include "Util.h"
 #include "playlists/PlayListFactory.h"
@@ -362,6 +363,7 @@ CFileItem& CFileItem::operator=(const CFileItem& item)
 
   CGUIListItem::operator=(item);
   m_bLabelPreformatted=item.m_bLabelPreformatted;
+  m_deferredLabelFormatter = item.m_deferredLabelFormatter;
   FreeMemory();
   m_strPath = item.m_strPath;
   m_strDynPath = item.m_strDynPath;
@@ -480,6 +482,7 @@ void CFileItem::Reset()
   // CGUIListItem members...
   m_strLabel2.clear();
   SetLabel("");
+  m_deferredLabelFormatter.reset();
   FreeIcons();
   m_overlayIcon = ICON_OVERLAY_NONE;
   m_bSelected = false;
@@ -1414,6 +1417,16 @@ void CFileItem::SetLabel(const std::string &strLabel)
   CGUIListItem::SetLabel(strLabel);
 }
 
+void CFileItem::FormatDeferredLabels()
+{
+  if (!m_deferredLabelFormatter)
+    return;
+
+  std::shared_ptr<const CLabelFormatter> formatter = std::move(m_deferredLabelFormatter);
+  m_deferredLabelFormatter.reset();
+  formatter->FormatLabels(this);
+}
+
 void CFileItem::SetFileSizeLabel()
 {
   if(m_bIsFolder && m_dwSize == 0)
@@ -34,6 +34,7 @@ namespace MUSIC_INFO
 {
   class CMusicInfoTag;
 }
+class CLabelFormatter;
 class CVideoInfoTag;
 class CPictureInfoTag;
 
@@ -249,6 +250,13 @@ public:
   int GetVideoContentType() const; /* return VIDEODB_CONTENT_TYPE, but don't want to include videodb in this header */
   bool IsLabelPreformatted() const { return m_bLabelPreformatted; }
   void SetLabelPreformatted(bool bYesNo) { m_bLabelPreformatted=bYesNo; }
+
+  /*! \brief Defer formatting the labels until a container shows the item
+   \param formatter formatter to apply in FormatDeferredLabels(), nullptr to drop a pending one
+   */
+  void SetDeferredLabelFormatter(std::shared_ptr<const CLabelFormatter> formatter) { m_deferredLabelFormatter = std::move(formatter); }
+  bool HasDeferredLabels() const { return m_deferredLabelFormatter != nullptr; }
+  void FormatDeferredLabels() override;
   bool SortsOnTop() const { return m_specialSort == SortSpecialOnTop; }
   bool SortsOnBottom() const { return m_specialSort == SortSpecialOnBottom; }
   void SetSpecialSort(SortSpecial sort) { m_specialSort = sort; }
@@ -558,6 +566,7 @@ private:
   bool m_bIsParentFolder;
   bool m_bCanQueue;
   bool m_bLabelPreformatted;
+  std::shared_ptr<const CLabelFormatter> m_deferredLabelFormatter;
   std::string m_mimetype;
   std::string m_extrainfo;
   bool m_doContentLookup;
@@ -21,6 +21,7 @@
 #include "Util.h"
 #include "cores/DataCacheCore.h"
 #include "filesystem/File.h"
+#include "guilib/GUIControlProfiler.h"
 #include "guilib/guiinfo/GUIInfo.h"
 #include "guilib/guiinfo/GUIInfoHelper.h"
 #include "guilib/guiinfo/GUIInfoLabels.h"
@@ -28,6 +29,8 @@
 #include "interfaces/AnnouncementManager.h"
 #include "interfaces/info/InfoExpression.h"
 #include "messaging/ApplicationMessenger.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "settings/SkinSettings.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
@@ -9248,6 +9251,7 @@ bool CGUIInfoManager::GetBool(int condition1, int contextWindow, const CGUIListI
 {
   bool bReturn = false;
   int condition = std::abs(condition1);
+  m_boolEvaluations.fetch_add(1, std::memory_order_relaxed);
 
   if (condition >= LISTITEM_START && condition < LISTITEM_END)
   {
@@ -9273,6 +9277,50 @@ bool CGUIInfoManager::GetBool(int condition1, int contextWindow, const CGUIListI
   return (condition1 < 0) ? !bReturn : bReturn;
 }
 
+bool CGUIInfoManager::GetBoolDependencies(int condition1, INFO::InfoBool::Dependencies &dependencies) const
+{
+  if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTrackInfoDependencies)
+    return false;
+
+  int condition = std::abs(condition1);
+  const std::atomic<unsigned int>* counter = nullptr;
+  if (condition >= MULTI_INFO_START && condition <= MULTI_INFO_END)
+  {
+    const CGUIInfo &info = m_multiInfo[condition - MULTI_INFO_START];
+    condition = std::abs(info.m_info);
+    if (condition < LISTITEM_START || condition > LISTITEM_END)
+      counter = m_infoProviders.GetBoolChangeCounter(info);
+  }
+  else if (condition < LISTITEM_START || condition >= LISTITEM_END)
+    counter = m_infoProviders.GetBoolChangeCounter(CGUIInfo(condition));
+
+  if (!counter)
+    return false;
+
+  dependencies.push_back(&m_clearCounter);
+  dependencies.push_back(counter);
+  return true;
+}
+
+bool CGUIInfoManager::IsConstantCondition(int condition) const
+{
+  switch (std::abs(condition))
+  {
+    case SYSTEM_ALWAYS_TRUE:
+    case SYSTEM_ALWAYS_FALSE:
+    case SYSTEM_PLATFORM_LINUX:
+    case SYSTEM_PLATFORM_WINDOWS:
+    case SYSTEM_PLATFORM_UWP:
+    case SYSTEM_PLATFORM_DARWIN:
+    case SYSTEM_PLATFORM_DARWIN_OSX:
+    case SYSTEM_PLATFORM_DARWIN_IOS:
+    case SYSTEM_PLATFORM_ANDROID:
+    case SYSTEM_PLATFORM_LINUX_RASPBERRY_PI:
+      return true;
+  }
+  return false;
+}
+
 bool CGUIInfoManager::GetMultiInfoBool(const CGUIInfo &info, int contextWindow, const CGUIListItem *item)
 {
   bool bReturn = false;
@@ -9541,6 +9589,7 @@ void CGUIInfoManager::Clear()
 {
   CSingleLock lock(m_critInfo);
   m_skinVariableStrings.clear();
+  ++m_clearCounter;
 
   /*
     Erase any info bools that are unused. We do this repeatedly as each run
@@ -9800,6 +9849,10 @@ void CGUIInfoManager::ResetCache()
   // mark our infobools as dirty
   CSingleLock lock(m_critInfo);
   ++m_refreshCounter;
+
+  m_lastBoolEvaluations = m_boolEvaluations.exchange(0, std::memory_order_relaxed);
+  if (CGUIControlProfiler::IsRunning())
+    CGUIControlProfiler::Instance().AddBoolEvaluations(m_lastBoolEvaluations);
 }
 
 void CGUIInfoManager::SetCurrentVideoTag(const CVideoInfoTag &tag)
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
@@ -89,6 +90,22 @@ public:
    */
   bool EvaluateBool(const std::string &expression, int context = 0, const CGUIListItemPtr &item = nullptr);
 
+  /*! \brief Get the change counters a boolean condition depends on
+   \param condition the condition, as returned by TranslateSingleString
+   \param dependencies the change counters are appended to this
+   \return true if the condition only changes when one of the counters changes,
+           false if it needs to be evaluated every frame.
+   */
+  bool GetBoolDependencies(int condition, INFO::InfoBool::Dependencies &dependencies) const;
+
+  /*! \brief Whether a boolean condition always has the same value, e.g. "true" or a platform check
+   \param condition the condition, as returned by TranslateSingleString
+   */
+  bool IsConstantCondition(int condition) const;
+
+  /*! \brief Number of boolean conditions evaluated between the last two calls to ResetCache */
+  unsigned int GetBoolEvaluations() const { return m_lastBoolEvaluations; }
+
   int TranslateString(const std::string &strCondition);
   int TranslateSingleString(const std::string &strCondition, bool &listItemDependent);
 
@@ -202,6 +219,9 @@ private:
   typedef std::set<INFO::InfoPtr, bool(*)(const INFO::InfoPtr&, const INFO::InfoPtr&)> INFOBOOLTYPE;
   INFOBOOLTYPE m_bools;
   unsigned int m_refreshCounter = 0;
+  std::atomic<unsigned int> m_clearCounter{0}; ///< invalidates all tracked info bools on Clear()
+  std::atomic<unsigned int> m_boolEvaluations{0};
+  unsigned int m_lastBoolEvaluations = 0;
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   CCriticalSection m_critInfo;
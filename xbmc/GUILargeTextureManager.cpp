@@ -8,7 +8,11 @@
 
 #include "threads/SystemClock.h"
 #include "GUILargeTextureManager.h"
+#include "ServiceBroker.h"
+#include "guilib/GUIControlProfiler.h"
 #include "guilib/Texture.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/TimeUtils.h"
 #include "utils/JobManager.h"
@@ -17,6 +21,7 @@
 #include "TextureCache.h"
 
 #include <cassert>
+#include <cstring>
 
 CImageLoader::CImageLoader(const std::string &path, const bool useCache):
   m_path(path)
@@ -123,6 +128,30 @@ void CGUILargeTextureManager::CLargeTexture::SetTexture(CBaseTexture* texture)
     m_texture.Set(texture, texture->GetWidth(), texture->GetHeight());
 }
 
+std::shared_ptr<CEvent> CGUILargeTextureManager::CLargeTexture::StageUpload()
+{
+  CBaseTexture* texture = m_texture.m_textures[0];
+  unsigned char* buffer = texture->MapUploadBuffer();
+  if (!buffer)
+    return nullptr;
+
+  // the texture isn't touched until the event is set, so the job may use its pixels
+  auto copied = std::make_shared<CEvent>(true);
+  const unsigned char* pixels = texture->GetPixels();
+  size_t size = texture->GetPitch() * texture->GetRows();
+  CJobManager::GetInstance().Submit([copied, buffer, pixels, size]() {
+    memcpy(buffer, pixels, size);
+    copied->Set();
+  }, CJob::PRIORITY_HIGH);
+  return copied;
+}
+
+void CGUILargeTextureManager::CLargeTexture::Upload()
+{
+  for (auto texture : m_texture.m_textures)
+    texture->LoadToGPU();
+}
+
 CGUILargeTextureManager::CGUILargeTextureManager() = default;
 
 CGUILargeTextureManager::~CGUILargeTextureManager() = default;
@@ -159,6 +188,28 @@ bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &t
     }
   }
 
+  // loaded, but not uploaded yet
+  for (listIterator it = m_decoded.begin(); it != m_decoded.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->GetPath() == path)
+    {
+      if (firstRequest)
+        image->AddRef();
+      return true;
+    }
+  }
+  for (stagedIterator it = m_staged.begin(); it != m_staged.end(); ++it)
+  {
+    CLargeTexture *image = it->second;
+    if (image->GetPath() == path)
+    {
+      if (firstRequest)
+        image->AddRef();
+      return true;
+    }
+  }
+
   if (firstRequest)
     QueueImage(path, useCache);
 
@@ -178,6 +229,27 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
       return;
     }
   }
+  for (listIterator it = m_decoded.begin(); it != m_decoded.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->GetPath() == path)
+    {
+      if (image->DecrRef(true))
+        m_decoded.erase(it);
+      return;
+    }
+  }
+  for (stagedIterator it = m_staged.begin(); it != m_staged.end(); ++it)
+  {
+    CLargeTexture *image = it->second;
+    if (image->GetPath() == path)
+    {
+      // the copy to the upload buffer can't be cancelled, the image
+      // is cleaned up once it moved to the allocated list
+      image->DecrRef(false);
+      return;
+    }
+  }
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
     unsigned int id = it->first;
@@ -228,8 +300,61 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
       image->SetTexture(loader->m_texture);
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
       m_queued.erase(it);
-      m_allocated.push_back(image);
+      // failed images go straight to the allocated list, so GetImage() reports the failure
+      if (image->GetTexture().size())
+        m_decoded.push_back(image);
+      else
+        m_allocated.push_back(image);
       return;
     }
   }
 }
+
+void CGUILargeTextureManager::UploadTextures()
+{
+  CSingleLock lock(m_listSection);
+  if (m_decoded.empty() && m_staged.empty())
+    return;
+
+  int64_t start = CurrentHostCounter();
+  int64_t budget = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureUploadBudget * CurrentHostFrequency() / 1000;
+  bool uploaded = false;
+  auto withinBudget = [&]() {
+    return !uploaded || budget == 0 || CurrentHostCounter() - start < budget;
+  };
+
+  // create the textures whose pixels have been copied to their upload buffer
+  stagedIterator it = m_staged.begin();
+  while (it != m_staged.end() && withinBudget())
+  {
+    if (!it->first->Signaled())
+    {
+      ++it;
+      continue;
+    }
+    CLargeTexture *image = it->second;
+    image->Upload();
+    uploaded = true;
+    it = m_staged.erase(it);
+    m_allocated.push_back(image);
+  }
+
+  // then start the uploads of newly loaded textures, in the order they arrived
+  while (!m_decoded.empty() && withinBudget())
+  {
+    CLargeTexture *image = m_decoded.front();
+    m_decoded.erase(m_decoded.begin());
+    std::shared_ptr<CEvent> copied = image->StageUpload();
+    if (copied)
+      m_staged.push_back(std::make_pair(copied, image));
+    else
+    {
+      image->Upload();
+      m_allocated.push_back(image);
+    }
+    uploaded = true;
+  }
+
+  if (CGUIControlProfiler::IsRunning())
+    CGUIControlProfiler::Instance().AddTextureUploadTime((CurrentHostCounter() - start) * 1000000 / CurrentHostFrequency());
+}
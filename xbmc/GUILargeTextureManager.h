@@ -8,11 +8,13 @@
 
 #pragma once
 
+#include <memory>
 #include <utility>
 #include <vector>
 
 #include "guilib/TextureManager.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "utils/Job.h"
 
 /*!
@@ -46,6 +48,9 @@ public:
  Used to load textures for the user interface asynchronously, allowing fluid framerates
  while background loading textures.
 
+ Loaded textures are handed to the GPU by UploadTextures() on the render thread, a few
+ per frame, so that a page full of thumbs arriving at once doesn't stall a single frame.
+
  \sa IJobCallback, CGUITexture
  */
 class CGUILargeTextureManager : public IJobCallback
@@ -103,6 +108,18 @@ public:
    */
   void CleanupUnusedImages(bool immediately = false);
 
+  /*!
+   \brief Upload loaded textures to the GPU within the per frame budget.
+
+   Called once per frame on the render thread. At least one texture is uploaded per call, further
+   ones as long as the time spent stays within the budget set by <gui><textureuploadbudget>.
+   Where the renderer supports it, the pixels are copied to an upload buffer on a worker thread
+   first and the texture is created from that buffer in a later frame.
+
+   \sa CBaseTexture::MapUploadBuffer
+   */
+  void UploadTextures();
+
 private:
   class CLargeTexture
   {
@@ -115,6 +132,13 @@ private:
     bool DeleteIfRequired(bool deleteImmediately = false);
     void SetTexture(CBaseTexture* texture);
 
+    /*!
+     \brief Start copying the pixels to the renderer's upload buffer on a worker thread
+     \return event set once the copy finished, nullptr if the texture has to be uploaded directly
+     */
+    std::shared_ptr<CEvent> StageUpload();
+    void Upload();
+
     const std::string &GetPath() const { return m_path; };
     const CTextureArray &GetTexture() const { return m_texture; };
 
@@ -130,9 +154,12 @@ private:
   void QueueImage(const std::string &path, bool useCache = true);
 
   std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
+  std::vector<CLargeTexture *> m_decoded; ///< loaded textures waiting for their upload
+  std::vector< std::pair<std::shared_ptr<CEvent>, CLargeTexture *> > m_staged; ///< textures being copied to an upload buffer
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
   typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
+  typedef std::vector< std::pair<std::shared_ptr<CEvent>, CLargeTexture *> >::iterator stagedIterator;
 
   CCriticalSection m_listSection;
 };
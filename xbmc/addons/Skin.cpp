@@ -294,12 +294,47 @@ bool CSkinInfo::HasSkinFile(const std::string &strFile) const
   return CFile::Exists(GetSkinPath(strFile));
 }
 
+void CSkinInfo::PrefetchSkinFiles()
+{
+  m_xmlCache.Clear();
+
+  std::vector<std::string> skinPaths;
+  GetSkinPaths(skinPaths);
+
+  std::vector<std::string> files;
+  for (const auto& skinPath : skinPaths)
+  {
+    CFileItemList items;
+    if (!CDirectory::GetDirectory(skinPath, items, ".xml", DIR_FLAG_NO_FILE_DIRS))
+      continue;
+
+    for (const auto& item : items)
+    {
+      if (!item->m_bIsFolder)
+        files.push_back(item->GetPath());
+    }
+  }
+
+  CLog::Log(LOGINFO, "Prefetching %u skin files", static_cast<unsigned int>(files.size()));
+  m_xmlCache.Prefetch(files);
+}
+
+bool CSkinInfo::LoadSkinXML(const std::string& file, CXBMCTinyXML& doc)
+{
+  return m_xmlCache.LoadFile(file, doc);
+}
+
+void CSkinInfo::ReleasePrefetchedSkinFiles()
+{
+  m_xmlCache.Clear();
+}
+
 void CSkinInfo::LoadIncludes()
 {
   std::string includesPath = CSpecialProtocol::TranslatePathConvertCase(GetSkinPath("includes.xml"));
   CLog::Log(LOGINFO, "Loading skin includes from %s", includesPath.c_str());
   m_includes.Clear();
-  m_includes.Load(includesPath);
+  m_includes.Load(includesPath, &m_xmlCache);
 }
 
 void CSkinInfo::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */)
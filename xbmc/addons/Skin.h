@@ -16,6 +16,7 @@
 #include "addons/Addon.h"
 #include "windowing/GraphicContext.h" // needed for the RESOLUTION members
 #include "guilib/GUIIncludes.h"    // needed for the GUIInclude member
+#include "guilib/GUIXMLCache.h"
 
 #define CREDIT_LINE_LENGTH 50
 
@@ -164,6 +165,24 @@ public:
 
   const std::string& GetCurrentAspect() const { return m_currentAspect; }
 
+  /*! \brief Start parsing the skin's XML files in the background
+   Files are then taken from the cache by LoadIncludes() and LoadSkinXML().
+   */
+  void PrefetchSkinFiles();
+
+  /*! \brief Load a skin XML file, using the tree parsed by PrefetchSkinFiles() if available
+   \param file path of the file to load
+   \param doc [out] document to load the file into
+   \return true if the file was loaded, false otherwise
+   */
+  bool LoadSkinXML(const std::string& file, CXBMCTinyXML& doc);
+
+  /*! \brief Drop the prefetched trees nothing asked for yet
+   Called once the first window is shown, windows opened later read their file
+   themselves instead of keeping every tree of the skin in memory.
+   */
+  void ReleasePrefetchedSkinFiles();
+
   void LoadIncludes();
   void ToggleDebug();
   const INFO::CSkinVariableString* CreateSkinVariable(const std::string& name, int context);
@@ -222,6 +241,7 @@ protected:
 
   float m_effectsSlowDown;
   CGUIIncludes m_includes;
+  CGUIXMLCache m_xmlCache;
   std::string m_currentAspect;
 
   std::vector<CStartupWindow> m_startupWindows;
@@ -8,6 +8,8 @@
 
 #include "AEResampleFactory.h"
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResampleFFMPEG.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
 #if defined(TARGET_RASPBERRY_PI)
   #include "ServiceBroker.h"
   #include "settings/Settings.h"
@@ -27,4 +29,108 @@ IAEResample *CAEResampleFactory::Create(uint32_t flags /* = 0 */)
   return new CActiveAEResampleFFMPEG();
 }
 
+#define AERESAMPLE_CACHE_SIZE 8
+
+std::list<CAEResampleFactory::CacheEntry> CAEResampleFactory::m_cache;
+AEResampleStats CAEResampleFactory::m_stats;
+CCriticalSection CAEResampleFactory::m_cacheLock;
+
+static bool operator==(const SampleConfig &lhs, const SampleConfig &rhs)
+{
+  return lhs.fmt == rhs.fmt &&
+         lhs.channel_layout == rhs.channel_layout &&
+         lhs.channels == rhs.channels &&
+         lhs.sample_rate == rhs.sample_rate &&
+         lhs.bits_per_sample == rhs.bits_per_sample &&
+         lhs.dither_bits == rhs.dither_bits;
+}
+
+bool AEResampleParams::operator==(const AEResampleParams &rhs) const
+{
+  return dstConfig == rhs.dstConfig &&
+         srcConfig == rhs.srcConfig &&
+         upmix == rhs.upmix &&
+         normalize == rhs.normalize &&
+         centerMix == rhs.centerMix &&
+         remap == rhs.remap &&
+         (!remap || remapLayout == rhs.remapLayout) &&
+         quality == rhs.quality &&
+         forceResample == rhs.forceResample;
+}
+
+IAEResample *CAEResampleFactory::Acquire(const AEResampleParams &params)
+{
+  {
+    CSingleLock lock(m_cacheLock);
+    for (auto it = m_cache.begin(); it != m_cache.end(); ++it)
+    {
+      if (it->params == params)
+      {
+        IAEResample *resampler = it->resampler;
+        m_cache.erase(it);
+        m_stats.reused++;
+        return resampler;
+      }
+    }
+    m_stats.created++;
+  }
+
+  IAEResample *resampler = Create();
+  CAEChannelInfo remapLayout = params.remapLayout;
+  resampler->Init(params.dstConfig, params.srcConfig,
+                  params.upmix,
+                  params.normalize,
+                  params.centerMix,
+                  params.remap ? &remapLayout : nullptr,
+                  params.quality,
+                  params.forceResample);
+  return resampler;
+}
+
+void CAEResampleFactory::Release(IAEResample *resampler, const AEResampleParams &params)
+{
+  if (!resampler)
+    return;
+
+  if (!resampler->Reset())
+  {
+    delete resampler;
+    return;
+  }
+
+  IAEResample *evicted = nullptr;
+  {
+    CSingleLock lock(m_cacheLock);
+    m_cache.push_front(CacheEntry{params, resampler});
+    if (m_cache.size() > AERESAMPLE_CACHE_SIZE)
+    {
+      evicted = m_cache.back().resampler;
+      m_cache.pop_back();
+      m_stats.evicted++;
+    }
+  }
+  delete evicted;
+}
+
+void CAEResampleFactory::ClearCache()
+{
+  std::list<CacheEntry> cache;
+  {
+    CSingleLock lock(m_cacheLock);
+    if (m_stats.created || m_stats.reused)
+      CLog::Log(LOGDEBUG, "CAEResampleFactory::%s - %u resamplers created, %u reused, %u evicted",
+                __FUNCTION__, m_stats.created, m_stats.reused, m_stats.evicted);
+    cache.swap(m_cache);
+  }
+
+  for (auto &entry : cache)
+    delete entry.resampler;
+}
+
+AEResampleStats CAEResampleFactory::GetStats()
+{
+  CSingleLock lock(m_cacheLock);
+  return m_stats;
+}
+
 }
@@ -9,8 +9,10 @@
 #pragma once
 
 #include "cores/AudioEngine/Interfaces/AEResample.h"
+#include "cores/AudioEngine/Utils/AEChannelInfo.h"
+#include "threads/CriticalSection.h"
 
-class IAEResample;
+#include <list>
 
 namespace ActiveAE
 {
@@ -24,10 +26,62 @@ enum AEResampleFactoryOptions
   AERESAMPLEFACTORY_QUICK_RESAMPLE = 0x01
 };
 
+/*! \brief Parameters of IAEResample::Init(), identifying resamplers that can be reused */
+struct AEResampleParams
+{
+  SampleConfig dstConfig;
+  SampleConfig srcConfig;
+  bool upmix = false;
+  bool normalize = false;
+  double centerMix = 0.0;
+  bool remap = false;
+  CAEChannelInfo remapLayout;
+  AEQuality quality = AE_QUALITY_UNKNOWN;
+  bool forceResample = false;
+
+  bool operator==(const AEResampleParams& rhs) const;
+};
+
+struct AEResampleStats
+{
+  unsigned int created = 0; ///< resamplers constructed and initialized
+  unsigned int reused = 0;  ///< resamplers handed out again after a reset
+  unsigned int evicted = 0; ///< released resamplers deleted to bound the cache
+};
+
 class CAEResampleFactory
 {
 public:
   static IAEResample *Create(uint32_t flags = 0U);
+
+  /*! \brief Get an initialized resampler, reusing a released one with the same parameters
+   Building the filter bank of a resampler is expensive, streams of the same
+   format, crossfades and flushes hand their resamplers over this way.
+   \param params parameters to initialize the resampler with
+   \return the resampler, to be handed back with Release()
+   */
+  static IAEResample *Acquire(const AEResampleParams &params);
+
+  /*! \brief Hand a resampler from Acquire() back for reuse
+   \param resampler the resampler, reset or deleted by the call
+   \param params parameters it was acquired with
+   */
+  static void Release(IAEResample *resampler, const AEResampleParams &params);
+
+  /*! \brief Delete all released resamplers */
+  static void ClearCache();
+
+  static AEResampleStats GetStats();
+
+protected:
+  struct CacheEntry
+  {
+    AEResampleParams params;
+    IAEResample *resampler;
+  };
+  static std::list<CacheEntry> m_cache;
+  static AEResampleStats m_stats;
+  static CCriticalSection m_cacheLock;
 };
 
 }
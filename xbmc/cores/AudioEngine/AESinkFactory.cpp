@@ -26,6 +26,11 @@ void CAESinkFactory::RegisterSink(AESinkRegEntry regEntry)
     ae->DeviceChange();
 }
 
+void CAESinkFactory::UnregisterSink(const std::string &sinkName)
+{
+  m_AESinkRegEntry.erase(sinkName);
+}
+
 void CAESinkFactory::ClearSinks()
 {
   m_AESinkRegEntry.clear();
@@ -36,6 +41,11 @@ bool CAESinkFactory::HasSinks()
   return !m_AESinkRegEntry.empty();
 }
 
+bool CAESinkFactory::HasSink(const std::string &sinkName)
+{
+  return m_AESinkRegEntry.find(sinkName) != m_AESinkRegEntry.end();
+}
+
 void CAESinkFactory::ParseDevice(std::string &device, std::string &driver)
 {
   int pos = device.find_first_of(':');
@@ -42,8 +42,10 @@ class CAESinkFactory
 {
 public:
   static void RegisterSink(AESinkRegEntry regEntry);
+  static void UnregisterSink(const std::string &sinkName);
   static void ClearSinks();
   static bool HasSinks();
+  static bool HasSink(const std::string &sinkName);
 
   static void ParseDevice(std::string &device, std::string &driver);
   static IAESink *Create(std::string &device, AEAudioFormat &desiredFormat);
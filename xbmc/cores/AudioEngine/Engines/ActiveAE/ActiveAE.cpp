@@ -25,6 +25,7 @@ using namespace ActiveAE;
 #include "settings/SettingsComponent.h"
 #include "windowing/WinSystem.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 
 #define MAX_CACHE_LEVEL 0.4   // total cache time of stream in seconds
 #define MAX_WATER_LEVEL 0.2   // buffered time after stream stages in seconds
@@ -40,6 +41,19 @@ void CEngineStats::Reset(unsigned int sampleRate, bool pcm)
   m_pcmOutput = pcm;
 }
 
+void CEngineStats::GetStageTimes(double (&seconds)[STAGE_MAX])
+{
+  double frequency = static_cast<double>(CurrentHostFrequency());
+  for (int i = 0; i < STAGE_MAX; i++)
+    seconds[i] = m_stageTicks[i].load(std::memory_order_relaxed) / frequency;
+}
+
+void CEngineStats::ResetStageTimes()
+{
+  for (auto& ticks : m_stageTicks)
+    ticks.store(0, std::memory_order_relaxed);
+}
+
 void CEngineStats::UpdateSinkDelay(const AEDelayStatus& status, int samples)
 {
   CSingleLock lock(m_lock);
@@ -296,6 +310,9 @@ void CActiveAE::Dispose()
   m_controlPort.Purge();
   m_dataPort.Purge();
   m_sink.Dispose();
+
+  // the buffer pools handed their resamplers over on their way out
+  CAEResampleFactory::ClearCache();
 }
 
 //-----------------------------------------------------------------------------
@@ -751,21 +768,6 @@ void CActiveAE::StateMachine(int signal, Protocol *port, Message *msg)
           else
             msg->Reply(CActiveAEDataProtocol::ERR);
           return;
-        case CActiveAEDataProtocol::STREAMSAMPLE:
-          MsgStreamSample *msgData;
-          CSampleBuffer *samples;
-          msgData = reinterpret_cast<MsgStreamSample*>(msg->data);
-          samples = msgData->stream->m_processingSamples.front();
-          msgData->stream->m_processingSamples.pop_front();
-          if (samples != msgData->buffer)
-            CLog::Log(LOGERROR, "CActiveAE - inconsistency in stream sample message");
-          if (msgData->buffer->pkt->nb_samples == 0)
-            msgData->buffer->Return();
-          else
-            msgData->stream->m_processingBuffers->m_inputSamples.push_back(msgData->buffer);
-          m_extTimeout = 0;
-          m_state = AE_TOP_CONFIGURED_PLAY;
-          return;
         case CActiveAEDataProtocol::FREESTREAM:
           MsgStreamFree *msgStreamFree;
           msgStreamFree = reinterpret_cast<MsgStreamFree*>(msg->data);
@@ -1068,6 +1070,12 @@ void CActiveAE::Process()
       continue;
     }
 
+    // samples filled by the streams
+    else if (!m_extDeferData && ReceiveStreamSamples())
+    {
+      continue;
+    }
+
     // wait for message
     else if (m_outMsgEvent.WaitMSec(m_extTimeout))
     {
@@ -1491,6 +1499,12 @@ void CActiveAE::DiscardStream(CActiveAEStream *stream)
 
 void CActiveAE::SFlushStream(CActiveAEStream *stream)
 {
+  // the stream waits for the flush to complete, so both ends of its rings are ours
+  CSampleBuffer *buffer;
+  while (stream->m_freeRing.Pop(buffer))
+    ;
+  while (stream->m_filledRing.Pop(buffer))
+    ;
   while (!stream->m_processingSamples.empty())
   {
     stream->m_processingSamples.front()->Return();
@@ -1513,6 +1527,38 @@ void CActiveAE::SFlushStream(CActiveAEStream *stream)
   m_stats.UpdateStream(stream);
 }
 
+bool CActiveAE::ReceiveStreamSamples()
+{
+  // samples stay in the rings until the engine is configured
+  if (m_state < AE_TOP_CONFIGURED)
+    return false;
+
+  bool received = false;
+  for (auto stream : m_streams)
+  {
+    CSampleBuffer *buffer;
+    while (stream->m_filledRing.Pop(buffer))
+    {
+      CSampleBuffer *samples = stream->m_processingSamples.front();
+      stream->m_processingSamples.pop_front();
+      if (samples != buffer)
+        CLog::Log(LOGERROR, "CActiveAE::%s - inconsistency in stream samples", __FUNCTION__);
+      if (buffer->pkt->nb_samples == 0)
+        buffer->Return();
+      else
+        stream->m_processingBuffers->m_inputSamples.push_back(buffer);
+      received = true;
+    }
+  }
+
+  if (received)
+  {
+    m_extTimeout = 0;
+    m_state = AE_TOP_CONFIGURED_PLAY;
+  }
+  return received;
+}
+
 void CActiveAE::FlushEngine()
 {
   if (m_sinkBuffers)
@@ -1853,13 +1899,18 @@ void CActiveAE::UnconfigureSink()
 bool CActiveAE::RunStages()
 {
   bool busy = false;
+  int64_t streamTicks = 0;
 
   // serve input streams
   std::list<CActiveAEStream*>::iterator it;
   for (it = m_streams.begin(); it != m_streams.end(); ++it)
   {
     if ((*it)->m_processingBuffers && !(*it)->m_paused)
+    {
+      int64_t start = CurrentHostCounter();
       busy = (*it)->m_processingBuffers->ProcessBuffers();
+      streamTicks += CurrentHostCounter() - start;
+    }
 
     if ((*it)->m_streamIsBuffering &&
         (*it)->m_processingBuffers &&
@@ -1877,14 +1928,20 @@ bool CActiveAE::RunStages()
       float buftime = (float)(*it)->m_inputBuffers->m_format.m_frames / (*it)->m_inputBuffers->m_format.m_sampleRate;
       if ((*it)->m_inputBuffers->m_format.m_dataFormat == AE_FMT_RAW)
         buftime = (*it)->m_inputBuffers->m_format.m_streamInfo.GetDuration() / 1000;
-      while ((time < MAX_CACHE_LEVEL || (*it)->m_streamIsBuffering) && !(*it)->m_inputBuffers->m_freeSamples.empty())
+      bool provided = false;
+      while ((time < MAX_CACHE_LEVEL || (*it)->m_streamIsBuffering) &&
+             !(*it)->m_inputBuffers->m_freeSamples.empty() &&
+             (*it)->m_processingSamples.size() < (*it)->m_freeRing.Capacity())
       {
         buffer = (*it)->m_inputBuffers->GetFreeBuffer();
         (*it)->m_processingSamples.push_back(buffer);
-        (*it)->m_streamPort->SendInMessage(CActiveAEDataProtocol::STREAMBUFFER, &buffer, sizeof(CSampleBuffer*));
         (*it)->IncFreeBuffers();
+        (*it)->m_freeRing.Push(buffer);
         time += buftime;
+        provided = true;
       }
+      if (provided)
+        (*it)->m_inMsgEvent.Set();
     }
     else
     {
@@ -1916,6 +1973,9 @@ bool CActiveAE::RunStages()
     }
   }
 
+  m_stats.AddStageTime(CEngineStats::STAGE_STREAMS, streamTicks);
+  int64_t mixStart = CurrentHostCounter();
+
   if (m_stats.GetWaterLevel() < MAX_WATER_LEVEL &&
      (m_mode != MODE_TRANSCODE || (m_encoderBuffers && !m_encoderBuffers->m_freeSamples.empty())))
   {
@@ -2066,15 +2126,7 @@ bool CActiveAE::RunStages()
 
               for(int j=0; j<out->pkt->planes; j++)
               {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
+                CAEUtil::MulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
               }
             }
           }
@@ -2135,24 +2187,9 @@ bool CActiveAE::RunStages()
               {
                 float *dst = (float*)out->pkt->data[j]+i*nb_floats;
                 float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
+                CAEUtil::MulAddArray(dst, src, volume, nb_floats);
+                if (!needClamp && CAEUtil::PeakArray(dst, nb_floats) > 1.0f)
+                  needClamp = true;
               }
             }
             mix->Return();
@@ -2283,8 +2320,12 @@ bool CActiveAE::RunStages()
     }
   }
 
+  int64_t outputStart = CurrentHostCounter();
+  m_stats.AddStageTime(CEngineStats::STAGE_MIX, outputStart - mixStart);
+
   // serve sink buffers
   busy |= m_sinkBuffers->ResampleBuffers();
+  m_stats.AddStageTime(CEngineStats::STAGE_OUTPUT, CurrentHostCounter() - outputStart);
   while(!m_sinkBuffers->m_outputSamples.empty())
   {
     CSampleBuffer *out = NULL;
@@ -2535,12 +2576,7 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
       out = (float*)dstSample.data[j];
       sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
       int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      CAEUtil::MulAddArray(out, sample_buffer, volume, nb_floats);
     }
 
     it->samples_played += mix_samples;
@@ -2565,13 +2601,7 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      CAEUtil::MulArray(buffer, volume, nb_floats);
     }
   }
 }
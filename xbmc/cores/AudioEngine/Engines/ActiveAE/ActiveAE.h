@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <list>
 #include <string>
 #include <vector>
@@ -112,14 +113,12 @@ public:
     FREESOUND,
     NEWSTREAM,
     FREESTREAM,
-    STREAMSAMPLE,
     DRAINSTREAM,
   };
   enum InSignal
   {
     ACC,
     ERR,
-    STREAMBUFFER,
     STREAMDRAINED,
   };
 };
@@ -137,12 +136,6 @@ struct MsgStreamFree
   bool finish; // if true switch back to gui sound mode
 };
 
-struct MsgStreamSample
-{
-  CSampleBuffer *buffer;
-  CActiveAEStream *stream;
-};
-
 struct MsgStreamParameter
 {
   CActiveAEStream *stream;
@@ -173,6 +166,17 @@ struct MsgStreamFFmpegInfo
 class CEngineStats
 {
 public:
+  /*! \brief Processing stages timed for benchmarking the engine */
+  enum Stage
+  {
+    STAGE_STREAMS, ///< conversion, resampling and tempo change of the streams
+    STAGE_MIX,     ///< mixing, volume, sounds, visualisation and encoding
+    STAGE_OUTPUT,  ///< conversion to the sink format
+    STAGE_PACK,    ///< iec packing and byte swapping of passthrough data
+    STAGE_SINK,    ///< handing the data to the sink, including its blocking
+    STAGE_MAX
+  };
+
   void Reset(unsigned int sampleRate, bool pcm);
   void UpdateSinkDelay(const AEDelayStatus& status, int samples);
   void AddSamples(int samples, std::list<CActiveAEStream*> &streams);
@@ -192,8 +196,17 @@ public:
   void SetSinkLatency(float time) { m_sinkLatency = time; }
   bool IsSuspended();
   AEAudioFormat GetCurrentSinkFormat();
+
+  /*! \brief Account time spent in a stage, called by the engine and the sink thread
+   \param stage the stage
+   \param ticks duration in host counter ticks
+   */
+  void AddStageTime(Stage stage, int64_t ticks) { m_stageTicks[stage].fetch_add(ticks, std::memory_order_relaxed); }
+  /*! \brief Seconds spent in each stage since the last ResetStageTimes() */
+  void GetStageTimes(double (&seconds)[STAGE_MAX]);
+  void ResetStageTimes();
 protected:
-  float m_sinkCacheTotal;
+  std::atomic<float> m_sinkCacheTotal{0}; ///< updated by the sink thread, sinks may adapt their buffering
   float m_sinkLatency;
   int m_bufferedSamples;
   unsigned int m_sinkSampleRate;
@@ -212,6 +225,7 @@ protected:
     CAESyncInfo::AESyncState m_syncState;
   };
   std::vector<StreamStats> m_streamStats;
+  std::atomic<int64_t> m_stageTicks[STAGE_MAX] = {};
 };
 
 class CActiveAE : public IAE, public IDispResource, private CThread
@@ -263,6 +277,9 @@ public:
   void OnResetDisplay() override;
   void OnAppFocusChange(bool focus) override;
 
+  /*! \brief Statistics of the engine, e.g. for benchmarks of the processing stages */
+  CEngineStats& GetStats() { return m_stats; }
+
 protected:
   void PlaySound(CActiveAESound *sound);
   static uint8_t **AllocSoundSample(SampleConfig &config, int &samples, int &bytes_per_sample, int &planes, int &linesize);
@@ -299,6 +316,7 @@ protected:
   CActiveAEStream* CreateStream(MsgStreamNew *streamMsg);
   void DiscardStream(CActiveAEStream *stream);
   void SFlushStream(CActiveAEStream *stream);
+  bool ReceiveStreamSamples();
   void FlushEngine();
   void ClearDiscardedBuffers();
   void SStopSound(CActiveAESound *sound);
@@ -149,7 +149,7 @@ CActiveAEBufferPoolResample::~CActiveAEBufferPoolResample()
 {
   Flush();
 
-  delete m_resampler;
+  CAEResampleFactory::Release(m_resampler, m_resampleParams);
 }
 
 bool CActiveAEBufferPoolResample::Create(unsigned int totaltime, bool remap, bool upmix, bool normalize)
@@ -175,36 +175,38 @@ bool CActiveAEBufferPoolResample::Create(unsigned int totaltime, bool remap, boo
 
 void CActiveAEBufferPoolResample::ChangeResampler()
 {
+  AEResampleParams params;
+  params.dstConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_format.m_channelLayout);
+  params.dstConfig.channels = m_format.m_channelLayout.Count();
+  params.dstConfig.sample_rate = m_format.m_sampleRate;
+  params.dstConfig.fmt = CAEUtil::GetAVSampleFormat(m_format.m_dataFormat);
+  params.dstConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_format.m_dataFormat);
+  params.dstConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_format.m_dataFormat);
+
+  params.srcConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_inputFormat.m_channelLayout);
+  params.srcConfig.channels = m_inputFormat.m_channelLayout.Count();
+  params.srcConfig.sample_rate = m_inputFormat.m_sampleRate;
+  params.srcConfig.fmt = CAEUtil::GetAVSampleFormat(m_inputFormat.m_dataFormat);
+  params.srcConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_inputFormat.m_dataFormat);
+  params.srcConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_inputFormat.m_dataFormat);
+
+  params.upmix = m_stereoUpmix;
+  params.normalize = m_normalize;
+  params.centerMix = m_centerMixLevel;
+  params.remap = m_remap;
+  params.remapLayout = m_format.m_channelLayout;
+  params.quality = m_resampleQuality;
+  params.forceResample = m_forceResampler;
+
+  // on a flush this hands back the same resampler, reset instead of rebuilt
   if (m_resampler)
   {
-    delete m_resampler;
+    CAEResampleFactory::Release(m_resampler, m_resampleParams);
     m_resampler = NULL;
   }
 
-  m_resampler = CAEResampleFactory::Create();
-
-  SampleConfig dstConfig, srcConfig;
-  dstConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_format.m_channelLayout);
-  dstConfig.channels = m_format.m_channelLayout.Count();
-  dstConfig.sample_rate = m_format.m_sampleRate;
-  dstConfig.fmt = CAEUtil::GetAVSampleFormat(m_format.m_dataFormat);
-  dstConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_format.m_dataFormat);
-  dstConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_format.m_dataFormat);
-
-  srcConfig.channel_layout = CAEUtil::GetAVChannelLayout(m_inputFormat.m_channelLayout);
-  srcConfig.channels = m_inputFormat.m_channelLayout.Count();
-  srcConfig.sample_rate = m_inputFormat.m_sampleRate;
-  srcConfig.fmt = CAEUtil::GetAVSampleFormat(m_inputFormat.m_dataFormat);
-  srcConfig.bits_per_sample = CAEUtil::DataFormatToUsedBits(m_inputFormat.m_dataFormat);
-  srcConfig.dither_bits = CAEUtil::DataFormatToDitherBits(m_inputFormat.m_dataFormat);
-
-  m_resampler->Init(dstConfig, srcConfig,
-                    m_stereoUpmix,
-                    m_normalize,
-                    m_centerMixLevel,
-                    m_remap ? &m_format.m_channelLayout : nullptr,
-                    m_resampleQuality,
-                    m_forceResampler);
+  m_resampler = CAEResampleFactory::Acquire(params);
+  m_resampleParams = params;
 
   m_changeResampler = false;
 }
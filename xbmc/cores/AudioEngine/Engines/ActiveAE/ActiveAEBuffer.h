@@ -9,6 +9,7 @@
 #pragma once
 
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
+#include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include <cmath>
 #include <deque>
@@ -103,6 +104,7 @@ protected:
   bool m_remap = false;
   CSampleBuffer *m_procSample = nullptr;
   IAEResample *m_resampler = nullptr;
+  AEResampleParams m_resampleParams;
   double m_resampleRatio = 1.0f;
   double m_centerMixLevel = M_SQRT1_2;
   bool m_fillPackets = false;
@@ -169,6 +169,15 @@ bool CActiveAEResampleFFMPEG::Init(SampleConfig dstConfig, SampleConfig srcConfi
   return true;
 }
 
+bool CActiveAEResampleFFMPEG::Reset()
+{
+  // swr_init drops buffered samples but keeps the filter bank if the options didn't change
+  if (!m_pContext || swr_init(m_pContext) < 0)
+    return false;
+
+  return true;
+}
+
 int CActiveAEResampleFFMPEG::Resample(uint8_t **dst_buffer, int dst_samples, uint8_t **src_buffer, int src_samples, double ratio)
 {
   int delta = 0;
@@ -13,6 +13,7 @@
 #include "cores/AudioEngine/Utils/AEStreamInfo.h"
 #include "cores/AudioEngine/Utils/AEBitstreamPacker.h"
 #include "utils/EndianSwap.h"
+#include "utils/TimeUtils.h"
 #include "ActiveAE.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "utils/log.h"
@@ -898,6 +899,7 @@ unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
   std::unique_ptr<uint8_t[]> mergebuffer;
   uint8_t* p_mergebuffer = NULL;
   AEDelayStatus status;
+  int64_t packStart = CurrentHostCounter();
 
   if (m_requestedFormat.m_dataFormat == AE_FMT_RAW)
   {
@@ -993,6 +995,9 @@ unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
     }
   }
 
+  int64_t sinkStart = CurrentHostCounter();
+  m_stats->AddStageTime(CEngineStats::STAGE_PACK, sinkStart - packStart);
+
   int framesOrPackets;
 
   while (frames > 0)
@@ -1036,6 +1041,9 @@ unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
       m_stats->UpdateSinkDelay(status, samples->pool ? written : 0);
   }
 
+  m_stats->AddStageTime(CEngineStats::STAGE_SINK, CurrentHostCounter() - sinkStart);
+  m_stats->SetSinkCacheTotal(m_sink->GetCacheTotal());
+
   if (m_requestedFormat.m_dataFormat == AE_FMT_RAW)
     m_stats->UpdateSinkDelay(status, samples->pool ? 1 : 0);
 
@@ -16,7 +16,12 @@
 
 using namespace ActiveAE;
 
+// buffers a stream may have in flight, covers the cache level down to periods of ~3ms
+#define MAX_STREAM_BUFFERS 128
+
 CActiveAEStream::CActiveAEStream(AEAudioFormat *format, unsigned int streamid, CActiveAE *ae)
+  : m_freeRing(MAX_STREAM_BUFFERS)
+  , m_filledRing(MAX_STREAM_BUFFERS)
 {
   m_activeAE = ae;
   m_format = *format;
@@ -63,22 +68,27 @@ CActiveAEStream::~CActiveAEStream()
 
 void CActiveAEStream::IncFreeBuffers()
 {
-  CSingleLock lock(m_streamLock);
   m_streamFreeBuffers++;
 }
 
 void CActiveAEStream::DecFreeBuffers()
 {
-  CSingleLock lock(m_streamLock);
   m_streamFreeBuffers--;
 }
 
 void CActiveAEStream::ResetFreeBuffers()
 {
-  CSingleLock lock(m_streamLock);
   m_streamFreeBuffers = 0;
 }
 
+void CActiveAEStream::PushSample(CSampleBuffer *buffer)
+{
+  // can't fail, the engine keeps no more buffers in flight than the rings hold
+  if (!m_filledRing.Push(buffer))
+    CLog::Log(LOGERROR, "CActiveAEStream::%s - sample ring overflow", __FUNCTION__);
+  m_activeAE->m_outMsgEvent.Set();
+}
+
 void CActiveAEStream::InitRemapper()
 {
   // check if input format follows ffmpeg channel mask
@@ -224,7 +234,6 @@ int CActiveAEStream::GetErrorInterval()
 
 unsigned int CActiveAEStream::GetSpace()
 {
-  CSingleLock lock(m_streamLock);
   if (m_format.m_dataFormat == AE_FMT_RAW)
     return m_streamFreeBuffers;
   else
@@ -311,33 +320,25 @@ unsigned int CActiveAEStream::AddData(const uint8_t* const *data, unsigned int o
 
       if (m_currentBuffer->pkt->nb_samples == m_currentBuffer->pkt->max_nb_samples || rawPktComplete)
       {
-        MsgStreamSample msgData;
-        msgData.buffer = m_currentBuffer;
-        msgData.stream = this;
         RemapBuffer();
-        m_streamPort->SendOutMessage(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
+        PushSample(m_currentBuffer);
         m_currentBuffer = nullptr;
       }
       continue;
     }
+    else if (m_freeRing.Pop(m_currentBuffer))
+    {
+      m_currentBuffer->timestamp = 0;
+      m_currentBuffer->pkt->nb_samples = 0;
+      m_currentBuffer->pkt->pause_burst_ms = 0;
+      DecFreeBuffers();
+      continue;
+    }
     else if (m_streamPort->ReceiveInMessage(&msg))
     {
-      if (msg->signal == CActiveAEDataProtocol::STREAMBUFFER)
-      {
-        m_currentBuffer = *((CSampleBuffer**)msg->data);
-        m_currentBuffer->timestamp = 0;
-        m_currentBuffer->pkt->nb_samples = 0;
-        m_currentBuffer->pkt->pause_burst_ms = 0;
-        msg->Release();
-        DecFreeBuffers();
-        continue;
-      }
-      else
-      {
-        CLog::Log(LOGERROR, "CActiveAEStream::AddData - unknown signal");
-        msg->Release();
-        break;
-      }
+      CLog::Log(LOGERROR, "CActiveAEStream::AddData - unknown signal");
+      msg->Release();
+      break;
     }
     if (!m_inMsgEvent.WaitMSec(200))
       break;
@@ -413,33 +414,30 @@ void CActiveAEStream::Drain(bool wait)
 
   if (m_currentBuffer)
   {
-    MsgStreamSample msgData;
-    msgData.buffer = m_currentBuffer;
-    msgData.stream = this;
     RemapBuffer();
-    m_streamPort->SendOutMessage(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
+    PushSample(m_currentBuffer);
     m_currentBuffer = NULL;
   }
 
   XbmcThreads::EndTime timer(2000);
   while (!timer.IsTimePast())
   {
+    // hand back unused buffers, the engine signals drained once it got all of them
+    CSampleBuffer *buffer;
+    while (m_freeRing.Pop(buffer))
+    {
+      buffer->pkt->nb_samples = 0;
+      PushSample(buffer);
+      DecFreeBuffers();
+    }
+
     if (m_streamPort->ReceiveInMessage(&msg))
     {
-      if (msg->signal == CActiveAEDataProtocol::STREAMBUFFER)
-      {
-        MsgStreamSample msgData;
-        msgData.stream = this;
-        msgData.buffer = *((CSampleBuffer**)msg->data);
-        msg->Reply(CActiveAEDataProtocol::STREAMSAMPLE, &msgData, sizeof(MsgStreamSample));
-        DecFreeBuffers();
-        continue;
-      }
-      else if (msg->signal == CActiveAEDataProtocol::STREAMDRAINED)
-      {
-        msg->Release();
+      bool drained = msg->signal == CActiveAEDataProtocol::STREAMDRAINED;
+      msg->Release();
+      if (drained)
         return;
-      }
+      continue;
     }
     else if (!wait)
       return;
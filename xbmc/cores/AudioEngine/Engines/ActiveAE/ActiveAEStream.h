@@ -11,6 +11,7 @@
 #include "cores/AudioEngine/Interfaces/AEStream.h"
 #include "cores/AudioEngine/Utils/AEAudioFormat.h"
 #include "cores/AudioEngine/Utils/AELimiter.h"
+#include "threads/SPSCRingBuffer.h"
 #include <atomic>
 
 namespace ActiveAE
@@ -133,6 +134,7 @@ protected:
   void IncFreeBuffers();
   void DecFreeBuffers();
   void ResetFreeBuffers();
+  void PushSample(CSampleBuffer *buffer);
   void InitRemapper();
   void RemapBuffer();
   double CalcResampleRatio(double error);
@@ -192,7 +194,7 @@ protected:
   bool m_streamDraining;
   bool m_streamDrained;
   bool m_streamFading;
-  int m_streamFreeBuffers;
+  std::atomic_int m_streamFreeBuffers;
   bool m_streamIsBuffering;
   bool m_streamIsFlushed;
   IAEStream *m_streamSlave;
@@ -213,6 +215,11 @@ protected:
   std::deque<CSampleBuffer*> m_processingSamples;
   CActiveAEDataProtocol *m_streamPort;
   CEvent m_inMsgEvent;
+
+  // steady-state buffer exchange with the engine, bypassing the stream port
+  CSPSCRingBuffer<CSampleBuffer*> m_freeRing;   // engine -> stream, empty buffers
+  CSPSCRingBuffer<CSampleBuffer*> m_filledRing; // stream -> engine, filled buffers
+
   bool m_drain;
   bool m_paused;
   bool m_started;
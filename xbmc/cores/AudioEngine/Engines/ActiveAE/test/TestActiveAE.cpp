@@ -0,0 +1,314 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAE.h"
+#include "cores/AudioEngine/Sinks/AESinkNULL.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
+#include "utils/TimeUtils.h"
+
+#if defined(TARGET_POSIX)
+#include "platform/linux/XTimeUtils.h"
+#endif
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <iostream>
+#include <vector>
+
+using namespace ActiveAE;
+
+namespace
+{
+const unsigned int AC3_PACKET_SIZE = 1536; // 384 kbit/s, 32 ms per packet
+
+struct RenderStream
+{
+  AEAudioFormat format;
+  IAEStream* stream = nullptr;
+  std::vector<uint8_t> period; // one packet for passthrough
+  unsigned int periodFrames = 0; // frames per AddData, bytes for passthrough
+  unsigned int total = 0; // frames, packets for passthrough
+  unsigned int written = 0;
+};
+
+struct RenderResult
+{
+  AEAudioFormat sinkFormat;
+  double cpu = 0;
+  double wall = 0;
+  double stages[CEngineStats::STAGE_MAX] = {};
+};
+
+CAEChannelInfo ChannelLayout(unsigned int channels)
+{
+  for (int layout = AE_CH_LAYOUT_1_0; layout < AE_CH_LAYOUT_MAX; layout++)
+  {
+    CAEChannelInfo info(static_cast<AEStdChLayout>(layout));
+    if (info.Count() == channels)
+      return info;
+  }
+  return CAEChannelInfo();
+}
+
+// a 440 Hz tone, one packet of the size the engine hands out at a time
+RenderStream PCMStream(unsigned int sampleRate, unsigned int channels, unsigned int seconds)
+{
+  RenderStream render;
+  render.format.m_dataFormat = AE_FMT_FLOAT;
+  render.format.m_sampleRate = sampleRate;
+  render.format.m_channelLayout = ChannelLayout(channels);
+  render.periodFrames = sampleRate / 10;
+  render.total = sampleRate * seconds;
+
+  std::vector<float> samples(render.periodFrames * channels);
+  for (unsigned int i = 0; i < render.periodFrames; i++)
+  {
+    float sample = 0.5f * std::sin(2.0f * static_cast<float>(M_PI) * 440.0f * i / sampleRate);
+    for (unsigned int c = 0; c < channels; c++)
+      samples[i * channels + c] = sample;
+  }
+  render.period.resize(samples.size() * sizeof(float));
+  memcpy(render.period.data(), samples.data(), render.period.size());
+  return render;
+}
+
+// ac3 frames with a sync word and silent payload, the engine doesn't decode them
+RenderStream AC3Stream(unsigned int seconds)
+{
+  RenderStream render;
+  render.format.m_dataFormat = AE_FMT_RAW;
+  render.format.m_sampleRate = 48000;
+  render.format.m_frameSize = 1;
+  render.format.m_channelLayout += AE_CH_RAW;
+  render.format.m_channelLayout += AE_CH_RAW;
+  render.format.m_streamInfo.m_type = CAEStreamInfo::STREAM_TYPE_AC3;
+  render.format.m_streamInfo.m_sampleRate = 48000;
+  render.format.m_streamInfo.m_channels = 6;
+  render.format.m_streamInfo.m_ac3FrameSize = AC3_PACKET_SIZE;
+  render.periodFrames = AC3_PACKET_SIZE;
+  render.total = seconds * 1000 / 32;
+
+  render.period.assign(AC3_PACKET_SIZE, 0);
+  render.period[0] = 0x0B;
+  render.period[1] = 0x77;
+  return render;
+}
+
+class TestActiveAE : public ::testing::Test
+{
+protected:
+  TestActiveAE()
+    : m_settings(CServiceBroker::GetSettingsComponent()->GetSettings())
+  {
+    m_device = m_settings->GetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE);
+    m_passthroughDevice = m_settings->GetString(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGHDEVICE);
+    m_config = m_settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_CONFIG);
+    m_channels = m_settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_CHANNELS);
+    m_stereoUpmix = m_settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_STEREOUPMIX);
+    m_passthrough = m_settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH);
+    m_ac3Passthrough = m_settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_AC3PASSTHROUGH);
+    m_ac3Transcode = m_settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_AC3TRANSCODE);
+
+    // only remove the null sink again if it wasn't there before
+    m_registeredNull = !AE::CAESinkFactory::HasSink("NULL");
+    if (m_registeredNull)
+      CAESinkNULL::Register();
+
+    m_settings->SetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE, "NULL:offline");
+    m_settings->SetString(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGHDEVICE, "NULL:offline");
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CONFIG, AE_CONFIG_AUTO);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_STEREOUPMIX, false);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH, false);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_AC3TRANSCODE, false);
+  }
+
+  ~TestActiveAE() override
+  {
+    m_settings->SetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE, m_device);
+    m_settings->SetString(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGHDEVICE, m_passthroughDevice);
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CONFIG, m_config);
+    m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CHANNELS, m_channels);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_STEREOUPMIX, m_stereoUpmix);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH, m_passthrough);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_AC3PASSTHROUGH, m_ac3Passthrough);
+    m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_AC3TRANSCODE, m_ac3Transcode);
+
+    if (m_registeredNull)
+      AE::CAESinkFactory::UnregisterSink("NULL");
+  }
+
+  // renders all streams through the engine until they are drained
+  void Render(CActiveAE& ae, std::vector<RenderStream>& streams, RenderResult& result)
+  {
+    for (auto& render : streams)
+    {
+      render.stream = ae.MakeStream(render.format);
+      ASSERT_TRUE(render.stream != nullptr);
+    }
+
+    ae.GetStats().ResetStageTimes();
+    std::clock_t cpuStart = std::clock();
+    int64_t wallStart = CurrentHostCounter();
+
+    bool done = false;
+    while (!done)
+    {
+      done = true;
+      bool added = false;
+      for (auto& render : streams)
+      {
+        if (render.written >= render.total)
+          continue;
+        done = false;
+
+        const uint8_t* data = render.period.data();
+        if (render.format.m_dataFormat == AE_FMT_RAW)
+        {
+          // space is counted in packets
+          if (render.stream->GetSpace() == 0)
+            continue;
+          if (render.stream->AddData(&data, 0, render.periodFrames, nullptr) > 0)
+            render.written++;
+        }
+        else
+        {
+          unsigned int frames = std::min(render.periodFrames, render.total - render.written);
+          if (render.stream->GetSpace() < frames * render.format.m_channelLayout.Count() * sizeof(float))
+            continue;
+          render.written += render.stream->AddData(&data, 0, frames, nullptr);
+        }
+        added = true;
+      }
+      if (!done && !added)
+        Sleep(1);
+    }
+
+    for (auto& render : streams)
+      render.stream->Drain(true);
+
+    result.cpu = static_cast<double>(std::clock() - cpuStart) / CLOCKS_PER_SEC;
+    result.wall = static_cast<double>(CurrentHostCounter() - wallStart) / CurrentHostFrequency();
+    ae.GetStats().GetStageTimes(result.stages);
+    ae.GetCurrentSinkFormat(result.sinkFormat);
+
+    for (auto& render : streams)
+      ae.FreeStream(render.stream, false);
+  }
+
+  std::shared_ptr<CSettings> m_settings;
+
+private:
+  std::string m_device;
+  std::string m_passthroughDevice;
+  int m_config;
+  int m_channels;
+  bool m_stereoUpmix;
+  bool m_passthrough;
+  bool m_ac3Passthrough;
+  bool m_ac3Transcode;
+  bool m_registeredNull;
+};
+}
+
+/*
+ * Renders a mix of streams through the whole engine into the offline null
+ * sink and reports the cpu time per second of audio and where it was spent.
+ * KODI_TEST_AE_MIX lists the streams as samplerate:channels, e.g.
+ * "44100:2,48000:6", KODI_TEST_AE_SECONDS the seconds of audio per stream.
+ */
+TEST_F(TestActiveAE, OfflineRendering)
+{
+  const char* mix = getenv("KODI_TEST_AE_MIX");
+  if (!mix)
+  {
+    std::cout << "KODI_TEST_AE_MIX not set, skipping the offline rendering benchmark" << std::endl;
+    return;
+  }
+  const char* secondsEnv = getenv("KODI_TEST_AE_SECONDS");
+  unsigned int seconds = secondsEnv ? atoi(secondsEnv) : 60;
+
+  std::vector<RenderStream> streams;
+  for (const auto& spec : StringUtils::Split(mix, ","))
+  {
+    std::vector<std::string> values = StringUtils::Split(spec, ":");
+    ASSERT_EQ(2u, values.size()) << "invalid stream " << spec;
+
+    RenderStream render = PCMStream(atoi(values[0].c_str()), atoi(values[1].c_str()), seconds);
+    ASSERT_NE(0u, render.format.m_sampleRate) << "invalid stream " << spec;
+    ASSERT_NE(0u, render.format.m_channelLayout.Count()) << "invalid stream " << spec;
+    streams.push_back(render);
+  }
+
+  CActiveAE ae;
+  ae.Start();
+  RenderResult result;
+  Render(ae, streams, result);
+  ae.Shutdown();
+
+  const char* names[CEngineStats::STAGE_MAX] = { "streams", "mix", "output", "pack", "sink" };
+  std::cout << streams.size() << " streams, " << seconds << " s each, sink "
+            << result.sinkFormat.m_sampleRate << " Hz " << result.sinkFormat.m_channelLayout.Count()
+            << " channels" << std::endl;
+  std::cout << "wall " << result.wall << " s (" << seconds / result.wall << "x real time), cpu "
+            << result.cpu * 1000 / seconds << " ms per second of audio" << std::endl;
+  for (int i = 0; i < CEngineStats::STAGE_MAX; i++)
+    std::cout << "  " << names[i] << ": " << result.stages[i] * 1000 / seconds << " ms per second of audio" << std::endl;
+
+  EXPECT_LT(result.cpu, static_cast<double>(seconds));
+}
+
+TEST_F(TestActiveAE, StereoUpmix)
+{
+  m_settings->SetInt(CSettings::SETTING_AUDIOOUTPUT_CHANNELS, AE_CH_LAYOUT_5_1);
+  m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_STEREOUPMIX, true);
+
+  std::vector<RenderStream> streams;
+  streams.push_back(PCMStream(48000, 2, 2));
+
+  CActiveAE ae;
+  ae.Start();
+  RenderResult result;
+  Render(ae, streams, result);
+  ae.Shutdown();
+
+  EXPECT_EQ(streams[0].total, streams[0].written);
+  EXPECT_EQ(6u, result.sinkFormat.m_channelLayout.Count());
+  EXPECT_GT(result.stages[CEngineStats::STAGE_STREAMS], 0.0);
+}
+
+TEST_F(TestActiveAE, Passthrough)
+{
+  m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH, true);
+  m_settings->SetBool(CSettings::SETTING_AUDIOOUTPUT_AC3PASSTHROUGH, true);
+
+  std::vector<RenderStream> streams;
+  streams.push_back(AC3Stream(2));
+
+  CActiveAE ae;
+  ae.Start();
+  ASSERT_TRUE(ae.SupportsRaw(streams[0].format));
+  RenderResult result;
+  Render(ae, streams, result);
+  ae.Shutdown();
+
+  // the sink gets iec 61937 bursts on two raw channels
+  EXPECT_EQ(streams[0].total, streams[0].written);
+  ASSERT_EQ(2u, result.sinkFormat.m_channelLayout.Count());
+  EXPECT_EQ(AE_CH_RAW, result.sinkFormat.m_channelLayout[0]);
+  EXPECT_EQ(48000u, result.sinkFormat.m_sampleRate);
+  EXPECT_GT(result.stages[CEngineStats::STAGE_PACK], 0.0);
+}
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/AEResampleFactory.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+extern "C" {
+#include "libavutil/channel_layout.h"
+}
+
+using namespace ActiveAE;
+
+namespace
+{
+AEResampleParams StereoParams(int srcRate, int dstRate)
+{
+  AEResampleParams params;
+  params.srcConfig.fmt = AV_SAMPLE_FMT_FLT;
+  params.srcConfig.channel_layout = AV_CH_LAYOUT_STEREO;
+  params.srcConfig.channels = 2;
+  params.srcConfig.sample_rate = srcRate;
+  params.srcConfig.bits_per_sample = 32;
+  params.srcConfig.dither_bits = 0;
+  params.dstConfig = params.srcConfig;
+  params.dstConfig.sample_rate = dstRate;
+  params.normalize = true;
+  params.quality = AE_QUALITY_MID;
+  return params;
+}
+
+std::vector<float> Resample(IAEResample* resampler, const std::vector<float>& input)
+{
+  std::vector<float> output(input.size() * 2);
+  uint8_t* src = reinterpret_cast<uint8_t*>(const_cast<float*>(input.data()));
+  uint8_t* dst = reinterpret_cast<uint8_t*>(output.data());
+  int frames = resampler->Resample(&dst, output.size() / 2, &src, input.size() / 2, 1.0);
+  output.resize(frames > 0 ? frames * 2 : 0);
+  return output;
+}
+}
+
+TEST(TestActiveAEResample, ReuseResampler)
+{
+  AEResampleParams params = StereoParams(44100, 48000);
+  AEResampleStats stats = CAEResampleFactory::GetStats();
+
+  IAEResample* resampler = CAEResampleFactory::Acquire(params);
+  ASSERT_TRUE(resampler != nullptr);
+  CAEResampleFactory::Release(resampler, params);
+
+  // same parameters get the released resampler, others a new one
+  IAEResample* reused = CAEResampleFactory::Acquire(params);
+  EXPECT_EQ(resampler, reused);
+  AEResampleParams otherParams = StereoParams(48000, 44100);
+  IAEResample* other = CAEResampleFactory::Acquire(otherParams);
+  EXPECT_NE(reused, other);
+
+  AEResampleStats newStats = CAEResampleFactory::GetStats();
+  EXPECT_EQ(stats.created + 2, newStats.created);
+  EXPECT_EQ(stats.reused + 1, newStats.reused);
+
+  CAEResampleFactory::Release(reused, params);
+  CAEResampleFactory::Release(other, otherParams);
+  CAEResampleFactory::ClearCache();
+}
+
+TEST(TestActiveAEResample, ResetDropsState)
+{
+  AEResampleParams params = StereoParams(44100, 48000);
+
+  std::vector<float> tone(4410 * 2);
+  std::vector<float> noise(tone.size());
+  for (size_t i = 0; i < tone.size(); i++)
+  {
+    tone[i] = 0.5f * std::sin(0.0627f * (i / 2));
+    noise[i] = (i * 7919 % 1000) / 1000.0f - 0.5f;
+  }
+
+  IAEResample* resampler = CAEResampleFactory::Acquire(params);
+  ASSERT_TRUE(resampler != nullptr);
+  std::vector<float> fresh = Resample(resampler, tone);
+  ASSERT_FALSE(fresh.empty());
+
+  // leave samples and filter history behind, a reused resampler must not carry them over
+  CAEResampleFactory::Release(resampler, params);
+  resampler = CAEResampleFactory::Acquire(params);
+  Resample(resampler, noise);
+  CAEResampleFactory::Release(resampler, params);
+  resampler = CAEResampleFactory::Acquire(params);
+
+  EXPECT_EQ(fresh, Resample(resampler, tone));
+
+  CAEResampleFactory::Release(resampler, params);
+  CAEResampleFactory::ClearCache();
+}
@@ -29,6 +29,11 @@ public:
   virtual int CalcDstSampleCount(int src_samples, int dst_rate, int src_rate) = 0;
   virtual int GetSrcBufferSize(int samples) = 0;
   virtual int GetDstBufferSize(int samples) = 0;
+
+  /*! \brief Drop buffered samples and state, keeping the configuration of Init()
+   \return false if the resampler can't be reused
+   */
+  virtual bool Reset() { return false; }
 };
 
 }
@@ -37,6 +37,7 @@ public:
 
   /*
     This method returns the total time in seconds of the cache.
+    It is queried again after every write, so it may change while open.
   */
   virtual double GetCacheTotal() = 0;
 
@@ -8,6 +8,8 @@
 
 #include <stdint.h>
 #include <limits.h>
+#include <time.h>
+#include <unistd.h>
 #include <sys/utsname.h>
 #include <set>
 #include <sstream>
@@ -22,6 +24,7 @@
 #include "utils/log.h"
 #include "utils/MathUtils.h"
 #include "utils/SystemInfo.h"
+#include "utils/TimeUtils.h"
 #include "threads/SingleLock.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -35,6 +38,15 @@
 
 #define ALSA_OPTIONS (SND_PCM_NO_AUTO_FORMAT | SND_PCM_NO_AUTO_CHANNELS | SND_PCM_NO_AUTO_RESAMPLE)
 
+#define ALSA_LOWLATENCY_PERIOD_MS 5      // period requested in low latency mode
+#define ALSA_LOWLATENCY_MIN_PERIODS 2    // shortest fill level, in engine periods
+#define ALSA_LOWLATENCY_SHRINK_MS 10000  // time without underruns before the fill level shrinks by a period
+
+// monotonic status timestamps need alsa-lib 1.0.29
+#if SND_LIB_VERSION >= 0x01001d
+#define ALSA_MONOTONIC_TSTAMP 1
+#endif
+
 #define ALSA_MAX_CHANNELS 16
 static enum AEChannel LegacyALSAChannelMap[ALSA_MAX_CHANNELS + 1] = {
   AE_CH_FL      , AE_CH_FR      , AE_CH_BL      , AE_CH_BR      , AE_CH_FC      , AE_CH_LFE     , AE_CH_SL      , AE_CH_SR      ,
@@ -502,6 +514,7 @@ bool CAESinkALSA::Initialize(AEAudioFormat &format, std::string &device)
   {
     m_passthrough   = false;
   }
+  m_lowLatency = !m_passthrough && CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioLowLatency;
 #if defined(HAS_LIBAMCODEC)
   if (aml_present())
   {
@@ -730,6 +743,13 @@ bool CAESinkALSA::InitializeHW(const ALSAConfig &inconfig, ALSAConfig &outconfig
   periodSize  = std::min(periodSize, (snd_pcm_uframes_t) sampleRate / 20);
   bufferSize  = std::min(bufferSize, (snd_pcm_uframes_t) sampleRate / 5);
 
+  /*
+   In low latency mode the buffer keeps its size to have room for growing
+   the fill level after underruns, only the periods get short.
+  */
+  if (m_lowLatency)
+    periodSize = std::min(periodSize, (snd_pcm_uframes_t) std::max<unsigned int>(AE_MIN_PERIODSIZE, sampleRate * ALSA_LOWLATENCY_PERIOD_MS / 1000));
+
   /*
    According to upstream we should set buffer size first - so make sure it is always at least
    4x period size to not get underruns (some systems seem to have issues with only 2 periods)
@@ -819,6 +839,15 @@ bool CAESinkALSA::InitializeHW(const ALSAConfig &inconfig, ALSAConfig &outconfig
 
   CLog::Log(LOGDEBUG, "CAESinkALSA::InitializeHW - Setting timeout to %d ms", m_timeout);
 
+  if (m_lowLatency)
+  {
+    m_fillTargetMin = std::min(ALSA_LOWLATENCY_MIN_PERIODS * outconfig.periodSize, m_bufferSize);
+    m_fillTarget = std::min(m_fillTargetMin + outconfig.periodSize, m_bufferSize);
+    m_underruns = 0;
+    m_shrinkTimer.Set(ALSA_LOWLATENCY_SHRINK_MS);
+    CLog::Log(LOGDEBUG, "CAESinkALSA::InitializeHW - Low latency mode, fill level %u frames", m_fillTarget);
+  }
+
   return true;
 }
 
@@ -837,6 +866,15 @@ bool CAESinkALSA::InitializeSW(const ALSAConfig &inconfig)
   snd_pcm_sw_params_set_silence_size     (m_pcm, sw_params, boundary);
   snd_pcm_sw_params_set_avail_min        (m_pcm, sw_params, inconfig.periodSize);
 
+#ifdef ALSA_MONOTONIC_TSTAMP
+  if (m_lowLatency)
+  {
+    // timestamp the delay reported by snd_pcm_status, see GetDelay
+    snd_pcm_sw_params_set_tstamp_mode    (m_pcm, sw_params, SND_PCM_TSTAMP_ENABLE);
+    snd_pcm_sw_params_set_tstamp_type    (m_pcm, sw_params, SND_PCM_TSTAMP_TYPE_MONOTONIC);
+  }
+#endif
+
   if (snd_pcm_sw_params(m_pcm, sw_params) < 0)
   {
     CLog::Log(LOGERROR, "CAESinkALSA::InitializeSW - Failed to set the parameters");
@@ -871,6 +909,34 @@ void CAESinkALSA::GetDelay(AEDelayStatus& status)
     return;
   }
   snd_pcm_sframes_t frames = 0;
+
+#ifdef ALSA_MONOTONIC_TSTAMP
+  if (m_lowLatency)
+  {
+    // date the delay back to when the kernel took the status rather than when we got it,
+    // a scheduling hiccup in between matters when the whole buffer is a few periods
+    snd_pcm_status_t *pcmStatus;
+    snd_pcm_status_alloca(&pcmStatus);
+    if (snd_pcm_status(m_pcm, pcmStatus) == 0 &&
+        snd_pcm_status_get_state(pcmStatus) == SND_PCM_STATE_RUNNING)
+    {
+      snd_htimestamp_t tstamp;
+      snd_pcm_status_get_htstamp(pcmStatus, &tstamp);
+      frames = snd_pcm_status_get_delay(pcmStatus);
+
+      struct timespec now;
+      if ((tstamp.tv_sec || tstamp.tv_nsec) && frames >= 0 && clock_gettime(CLOCK_MONOTONIC, &now) == 0)
+      {
+        int64_t age = (int64_t)(now.tv_sec - tstamp.tv_sec) * 1000000000LL + (now.tv_nsec - tstamp.tv_nsec);
+        status.SetDelay((double)frames * m_formatSampleRateMul);
+        if (age > 0)
+          status.tick -= age * CurrentHostFrequency() / 1000000000LL;
+        return;
+      }
+    }
+  }
+#endif
+
   snd_pcm_delay(m_pcm, &frames);
 
   if (frames < 0)
@@ -884,6 +950,9 @@ void CAESinkALSA::GetDelay(AEDelayStatus& status)
 
 double CAESinkALSA::GetCacheTotal()
 {
+  if (m_lowLatency)
+    return (double)m_fillTarget * m_formatSampleRateMul;
+
   return (double)m_bufferSize * m_formatSampleRateMul;
 }
 
@@ -900,6 +969,9 @@ unsigned int CAESinkALSA::AddPackets(uint8_t **data, unsigned int frames, unsign
   int64_t data_left = (int64_t) frames;
   int frames_written = 0;
 
+  if (m_lowLatency)
+    LimitFillLevel(frames);
+
   while (data_left > 0)
   {
     if (m_fragmented)
@@ -910,6 +982,9 @@ unsigned int CAESinkALSA::AddPackets(uint8_t **data, unsigned int frames, unsign
     int ret = snd_pcm_writei(m_pcm, buffer, amount);
     if (ret < 0)
     {
+      if (m_lowLatency && ret == -EPIPE)
+        AdaptFillLevel(true);
+
       CLog::Log(LOGERROR, "CAESinkALSA - snd_pcm_writei(%d) %s - trying to recover", ret, snd_strerror(ret));
       ret = snd_pcm_recover(m_pcm, ret, 1);
       if(ret < 0)
@@ -934,9 +1009,51 @@ unsigned int CAESinkALSA::AddPackets(uint8_t **data, unsigned int frames, unsign
     data_left -= ret;
     buffer = data[0]+offset*m_format.m_frameSize + frames_written*m_format.m_frameSize;
   }
+
+  if (m_lowLatency)
+    AdaptFillLevel(false);
+
   return frames_written;
 }
 
+void CAESinkALSA::LimitFillLevel(unsigned int frames)
+{
+  if (snd_pcm_state(m_pcm) != SND_PCM_STATE_RUNNING)
+    return;
+
+  snd_pcm_sframes_t delay;
+  if (snd_pcm_delay(m_pcm, &delay) < 0)
+    return;
+
+  // snd_pcm_writei only blocks on a full buffer, wait until the frames fit below the fill level
+  int64_t excess = (int64_t)delay + frames - m_fillTarget;
+  if (excess > 0)
+    usleep(excess * 1000000 / m_format.m_sampleRate);
+}
+
+void CAESinkALSA::AdaptFillLevel(bool underrun)
+{
+  if (underrun)
+  {
+    m_underruns++;
+    if (m_fillTarget < m_bufferSize)
+    {
+      m_fillTarget = std::min(m_fillTarget + m_format.m_frames, m_bufferSize);
+      CLog::Log(LOGDEBUG, "CAESinkALSA::AdaptFillLevel - underrun %u, raised fill level to %u frames", m_underruns, m_fillTarget);
+    }
+    m_shrinkTimer.Set(ALSA_LOWLATENCY_SHRINK_MS);
+  }
+  else if (m_shrinkTimer.IsTimePast())
+  {
+    if (m_fillTarget > m_fillTargetMin)
+    {
+      m_fillTarget -= std::min(m_format.m_frames, m_fillTarget - m_fillTargetMin);
+      CLog::Log(LOGDEBUG, "CAESinkALSA::AdaptFillLevel - lowered fill level to %u frames", m_fillTarget);
+    }
+    m_shrinkTimer.Set(ALSA_LOWLATENCY_SHRINK_MS);
+  }
+}
+
 void CAESinkALSA::HandleError(const char* name, int err)
 {
   switch(err)
@@ -17,6 +17,7 @@
 #include <alsa/asoundlib.h>
 
 #include "threads/CriticalSection.h"
+#include "threads/SystemClock.h"
 
 // ARGH... this is apparently needed to avoid FDEventMonitor
 // being destructed before CALSA*Monitor below.
@@ -62,6 +63,8 @@ private:
 
   void GetAESParams(const AEAudioFormat& format, std::string& params);
   void HandleError(const char* name, int err);
+  void LimitFillLevel(unsigned int frames);
+  void AdaptFillLevel(bool underrun);
 
   std::string m_initDevice;
   AEAudioFormat m_initFormat;
@@ -75,6 +78,13 @@ private:
   // support fragmentation, e.g. looping in the sink to get a certain amount of data onto the device
   bool m_fragmented = false;
   unsigned int m_originalPeriodSize = AE_MIN_PERIODSIZE;
+  // low latency mode, no more than m_fillTarget frames are queued on the device
+  // and the target grows by a period on every underrun
+  bool m_lowLatency = false;
+  unsigned int m_fillTarget = 0;
+  unsigned int m_fillTargetMin = 0;
+  unsigned int m_underruns = 0;
+  XbmcThreads::EndTime m_shrinkTimer;
 
 #if HAVE_LIBUDEV
   static CALSADeviceMonitor m_deviceMonitor;
@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "AESinkNULL.h"
+#include "cores/AudioEngine/AESinkFactory.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+#include "utils/log.h"
+#include "utils/TimeUtils.h"
+
+#if defined(TARGET_POSIX)
+#include "platform/linux/XTimeUtils.h"
+#endif
+
+#include <algorithm>
+
+#define NULL_PERIOD_MS 20
+#define NULL_BUFFER_MS 200
+
+void CAESinkNULL::Register()
+{
+  AE::AESinkRegEntry entry;
+  entry.sinkName = "NULL";
+  entry.createFunc = CAESinkNULL::Create;
+  entry.enumerateFunc = CAESinkNULL::EnumerateDevicesEx;
+  AE::CAESinkFactory::RegisterSink(entry);
+}
+
+IAESink* CAESinkNULL::Create(std::string &device, AEAudioFormat &desiredFormat)
+{
+  IAESink* sink = new CAESinkNULL();
+  if (sink->Initialize(desiredFormat, device))
+    return sink;
+
+  delete sink;
+  return nullptr;
+}
+
+void CAESinkNULL::EnumerateDevicesEx(AEDeviceInfoList &list, bool force)
+{
+  CAEDeviceInfo info;
+  info.m_deviceType = AE_DEVTYPE_HDMI;
+  info.m_channels = AE_CH_LAYOUT_7_1;
+  info.m_sampleRates = { 32000, 44100, 48000, 88200, 96000, 176400, 192000 };
+  info.m_dataFormats = { AE_FMT_FLOAT, AE_FMT_S32NE, AE_FMT_S16NE, AE_FMT_RAW };
+  info.m_streamTypes = { CAEStreamInfo::STREAM_TYPE_AC3,
+                         CAEStreamInfo::STREAM_TYPE_EAC3,
+                         CAEStreamInfo::STREAM_TYPE_DTSHD,
+                         CAEStreamInfo::STREAM_TYPE_DTSHD_MA,
+                         CAEStreamInfo::STREAM_TYPE_DTSHD_CORE,
+                         CAEStreamInfo::STREAM_TYPE_DTS_512,
+                         CAEStreamInfo::STREAM_TYPE_DTS_1024,
+                         CAEStreamInfo::STREAM_TYPE_DTS_2048,
+                         CAEStreamInfo::STREAM_TYPE_TRUEHD };
+  info.m_wantsIECPassthrough = true;
+
+  info.m_deviceName = "realtime";
+  info.m_displayName = "Null output";
+  info.m_displayNameExtra = "real time";
+  list.push_back(info);
+
+  info.m_deviceName = "offline";
+  info.m_displayNameExtra = "faster than real time";
+  list.push_back(info);
+}
+
+bool CAESinkNULL::Initialize(AEAudioFormat &format, std::string &device)
+{
+  if (device != "realtime" && device != "offline")
+    device = "realtime";
+  m_realtime = device == "realtime";
+
+  if (format.m_dataFormat == AE_FMT_RAW)
+  {
+    // passthrough is handed over as iec packed 16 bit frames, see CActiveAESink::OpenSink
+    format.m_dataFormat = AE_FMT_S16NE;
+  }
+  else if (format.m_dataFormat != AE_FMT_FLOAT &&
+           format.m_dataFormat != AE_FMT_S32NE &&
+           format.m_dataFormat != AE_FMT_S16NE)
+  {
+    format.m_dataFormat = AE_FMT_FLOAT;
+  }
+
+  if (format.m_channelLayout.Count() == 0 || format.m_sampleRate == 0)
+    return false;
+
+  format.m_frameSize = format.m_channelLayout.Count() * (CAEUtil::DataFormatToBits(format.m_dataFormat) >> 3);
+  format.m_frames = std::max(format.m_sampleRate * NULL_PERIOD_MS / 1000, 1u);
+  m_format = format;
+
+  m_buffered = 0.0;
+  m_lastTime = CurrentHostCounter();
+
+  CLog::Log(LOGDEBUG, "CAESinkNULL::%s - %s device, %u frames per period",
+            __FUNCTION__, device.c_str(), m_format.m_frames);
+  return true;
+}
+
+void CAESinkNULL::Deinitialize()
+{
+  m_buffered = 0.0;
+}
+
+void CAESinkNULL::UpdateBuffered()
+{
+  // the virtual device played what was buffered since the last update
+  int64_t now = CurrentHostCounter();
+  m_buffered -= static_cast<double>(now - m_lastTime) / CurrentHostFrequency();
+  m_buffered = std::max(m_buffered, 0.0);
+  m_lastTime = now;
+}
+
+void CAESinkNULL::Consume(double duration)
+{
+  if (!m_realtime)
+    return;
+
+  UpdateBuffered();
+  double excess = m_buffered + duration - NULL_BUFFER_MS / 1000.0;
+  if (excess > 0.0)
+  {
+    Sleep(static_cast<unsigned int>(excess * 1000.0) + 1);
+    UpdateBuffered();
+  }
+
+  m_buffered += duration;
+}
+
+void CAESinkNULL::GetDelay(AEDelayStatus& status)
+{
+  if (!m_realtime)
+  {
+    status.SetDelay(0.0);
+    return;
+  }
+
+  double played = static_cast<double>(CurrentHostCounter() - m_lastTime) / CurrentHostFrequency();
+  status.SetDelay(std::max(m_buffered - played, 0.0));
+}
+
+double CAESinkNULL::GetCacheTotal()
+{
+  if (!m_realtime)
+    return static_cast<double>(m_format.m_frames) / m_format.m_sampleRate;
+
+  return NULL_BUFFER_MS / 1000.0;
+}
+
+unsigned int CAESinkNULL::AddPackets(uint8_t **data, unsigned int frames, unsigned int offset)
+{
+  Consume(static_cast<double>(frames) / m_format.m_sampleRate);
+  return frames;
+}
+
+void CAESinkNULL::AddPause(unsigned int millis)
+{
+  Consume(millis / 1000.0);
+}
+
+void CAESinkNULL::Drain()
+{
+  AEDelayStatus status;
+  GetDelay(status);
+  if (status.delay > 0.0)
+    Sleep(static_cast<unsigned int>(status.delay * 1000.0) + 1);
+
+  m_buffered = 0.0;
+  m_lastTime = CurrentHostCounter();
+}
@@ -0,0 +1,52 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Interfaces/AESink.h"
+#include "cores/AudioEngine/Utils/AEDeviceInfo.h"
+
+#include <stdint.h>
+
+/*!
+ \brief Sink discarding all samples, for benchmarks and tests of the engine
+
+ The device "realtime" consumes samples at the rate a sound card would, the
+ device "offline" consumes them as fast as they arrive, so the engine runs
+ as fast as the machine allows. The sink isn't registered by default.
+ */
+class CAESinkNULL : public IAESink
+{
+public:
+  const char *GetName() override { return "NULL"; }
+
+  CAESinkNULL() = default;
+  ~CAESinkNULL() override = default;
+
+  static void Register();
+  static IAESink* Create(std::string &device, AEAudioFormat &desiredFormat);
+  static void EnumerateDevicesEx(AEDeviceInfoList &list, bool force = false);
+
+  bool Initialize(AEAudioFormat &format, std::string &device) override;
+  void Deinitialize() override;
+
+  void GetDelay(AEDelayStatus& status) override;
+  double GetCacheTotal() override;
+  unsigned int AddPackets(uint8_t **data, unsigned int frames, unsigned int offset) override;
+  void AddPause(unsigned int millis) override;
+  void Drain() override;
+
+private:
+  void UpdateBuffered();
+  void Consume(double duration);
+
+  AEAudioFormat m_format;
+  bool m_realtime = false;
+  double m_buffered = 0.0;   ///< seconds of audio in the virtual device buffer
+  int64_t m_lastTime = 0;    ///< host counter of the last update of m_buffered
+};
@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ServiceBroker.h"
+#include "cores/AudioEngine/Sinks/AESinkALSA.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+TEST(TestAESinkALSA, LowLatency)
+{
+  // needs a device consuming samples in real time, e.g. "hw:Loopback,0,0" of snd-aloop
+  const char* device = getenv("KODI_TEST_ALSA_DEVICE");
+  if (!device)
+  {
+    std::cout << "KODI_TEST_ALSA_DEVICE not set, skipping the low latency test" << std::endl;
+    return;
+  }
+
+  auto advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  bool lowLatency = advancedSettings->m_audioLowLatency;
+  advancedSettings->m_audioLowLatency = true;
+
+  AEAudioFormat format;
+  format.m_dataFormat = AE_FMT_S16NE;
+  format.m_sampleRate = 48000;
+  format.m_channelLayout = AE_CH_LAYOUT_2_0;
+  std::string name = device;
+
+  CAESinkALSA sink;
+  bool initialized = sink.Initialize(format, name);
+  advancedSettings->m_audioLowLatency = lowLatency;
+  ASSERT_TRUE(initialized);
+
+  // two seconds of silence, one period at a time like the engine does
+  std::vector<uint8_t> silence(format.m_frames * format.m_frameSize, 0);
+  uint8_t* data = silence.data();
+  double maxDelay = 0.0;
+  for (unsigned int frames = 0; frames < format.m_sampleRate * 2; frames += format.m_frames)
+  {
+    ASSERT_EQ(format.m_frames, sink.AddPackets(&data, format.m_frames, 0));
+
+    AEDelayStatus status;
+    sink.GetDelay(status);
+    maxDelay = std::max(maxDelay, status.GetDelay());
+  }
+  double fillLevel = sink.GetCacheTotal();
+  sink.Deinitialize();
+
+  double period = static_cast<double>(format.m_frames) / format.m_sampleRate;
+  std::cout << "period " << period * 1000 << " ms, fill level " << fillLevel * 1000
+            << " ms, max delay " << maxDelay * 1000 << " ms" << std::endl;
+
+  // the fill level only grows on underruns, so it's the highest one of the run
+  EXPECT_LE(maxDelay, fillLevel + period);
+}
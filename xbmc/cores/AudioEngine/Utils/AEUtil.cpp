@@ -10,11 +10,20 @@
 #endif
 
 #include "AEUtil.h"
+#include "utils/CPUInfo.h"
 #include "utils/log.h"
 #include "utils/TimeUtils.h"
 
+#include <algorithm>
 #include <cassert>
 
+#if defined(HAVE_SSE) && defined(__SSE__)
+#include <immintrin.h>
+#endif
+#if defined(HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 extern "C" {
 #include "libavutil/channel_layout.h"
 }
@@ -268,7 +277,7 @@ void CAEUtil::SSEMulArray(float *data, const float mul, uint32_t count)
   }
 }
 
-void CAEUtil::SSEMulAddArray(float *data, float *add, const float mul, uint32_t count)
+void CAEUtil::SSEMulAddArray(float *data, const float *add, const float mul, uint32_t count)
 {
   const __m128 m = _mm_set_ps1(mul);
 
@@ -355,85 +364,240 @@ inline float CAEUtil::SoftClamp(const float x)
 #endif
 }
 
-void CAEUtil::ClampArray(float *data, uint32_t count)
+namespace
+{
+
+void MulArrayC(float *data, const float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] *= mul;
+}
+
+void MulAddArrayC(float *data, const float *add, const float mul, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] += add[i] * mul;
+}
+
+float PeakArrayC(const float *data, uint32_t count)
 {
-#if !defined(HAVE_SSE) || !defined(__SSE__)
+  float peak = 0.0f;
   for (uint32_t i = 0; i < count; ++i)
-    data[i] = SoftClamp(data[i]);
+    peak = std::max(peak, fabsf(data[i]));
+  return peak;
+}
+
+void ClampArrayC(float *data, uint32_t count)
+{
+  for (uint32_t i = 0; i < count; ++i)
+    data[i] = CAEUtil::SoftClamp(data[i]);
+}
+
+/* the vector versions of SoftClamp() limit the input to -3..3, where the
+   rational function reaches -1 and 1, and process the remainder in C */
+#if defined(HAVE_SSE) && defined(__SSE__)
+float PeakArraySSE(const float *data, uint32_t count)
+{
+  const __m128 sign = _mm_set_ps1(-0.0f);
+  __m128 peak = _mm_setzero_ps();
+
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i += 4)
+    peak = _mm_max_ps(peak, _mm_andnot_ps(sign, _mm_loadu_ps(data + i)));
+
+  MEMALIGN(16, float lanes[4]);
+  _mm_store_ps(lanes, peak);
+  float result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+  return std::max(result, PeakArrayC(data + even, count - even));
+}
+
+void ClampArraySSE(float *data, uint32_t count)
+{
+  const __m128 c27 = _mm_set_ps1(27.0f);
+  const __m128 c9  = _mm_set_ps1(9.0f);
+  const __m128 hi  = _mm_set_ps1(3.0f);
+  const __m128 lo  = _mm_set_ps1(-3.0f);
 
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i += 4)
+  {
+    __m128 x  = _mm_min_ps(_mm_max_ps(_mm_loadu_ps(data + i), lo), hi);
+    __m128 x2 = _mm_mul_ps(x, x);
+    _mm_storeu_ps(data + i, _mm_div_ps(_mm_mul_ps(x, _mm_add_ps(c27, x2)),
+                                       _mm_add_ps(c27, _mm_mul_ps(c9, x2))));
+  }
+  ClampArrayC(data + even, count - even);
+}
+
+/* AVX is picked at runtime, so only these functions may use it */
+#if defined(__GNUC__)
+#define AE_TARGET_AVX __attribute__((target("avx")))
 #else
-  const __m128 c1 = _mm_set_ps1(27.0f);
-  const __m128 c2 = _mm_set_ps1(27.0f + 9.0f);
+#define AE_TARGET_AVX
+#endif
 
-  /* work around invalid alignment */
-  while (((uintptr_t)data & 0xF) && count > 0)
+AE_TARGET_AVX void MulArrayAVX(float *data, const float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+
+  uint32_t even = count & ~0x7;
+  for (uint32_t i = 0; i < even; i += 8)
+    _mm256_storeu_ps(data + i, _mm256_mul_ps(_mm256_loadu_ps(data + i), m));
+  MulArrayC(data + even, mul, count - even);
+}
+
+AE_TARGET_AVX void MulAddArrayAVX(float *data, const float *add, const float mul, uint32_t count)
+{
+  const __m256 m = _mm256_set1_ps(mul);
+
+  uint32_t even = count & ~0x7;
+  for (uint32_t i = 0; i < even; i += 8)
   {
-    data[0] = SoftClamp(data[0]);
-    ++data;
-    --count;
+    __m256 ad = _mm256_mul_ps(_mm256_loadu_ps(add + i), m);
+    _mm256_storeu_ps(data + i, _mm256_add_ps(_mm256_loadu_ps(data + i), ad));
   }
+  MulAddArrayC(data + even, add + even, mul, count - even);
+}
 
-  uint32_t even = count & ~0x3;
-  for (uint32_t i = 0; i < even; i+=4, data+=4)
+AE_TARGET_AVX float PeakArrayAVX(const float *data, uint32_t count)
+{
+  const __m256 sign = _mm256_set1_ps(-0.0f);
+  __m256 peak = _mm256_setzero_ps();
+
+  uint32_t even = count & ~0x7;
+  for (uint32_t i = 0; i < even; i += 8)
+    peak = _mm256_max_ps(peak, _mm256_andnot_ps(sign, _mm256_loadu_ps(data + i)));
+
+  __m128 half = _mm_max_ps(_mm256_castps256_ps128(peak), _mm256_extractf128_ps(peak, 1));
+  MEMALIGN(16, float lanes[4]);
+  _mm_store_ps(lanes, half);
+  float result = std::max(std::max(lanes[0], lanes[1]), std::max(lanes[2], lanes[3]));
+  return std::max(result, PeakArrayC(data + even, count - even));
+}
+
+AE_TARGET_AVX void ClampArrayAVX(float *data, uint32_t count)
+{
+  const __m256 c27 = _mm256_set1_ps(27.0f);
+  const __m256 c9  = _mm256_set1_ps(9.0f);
+  const __m256 hi  = _mm256_set1_ps(3.0f);
+  const __m256 lo  = _mm256_set1_ps(-3.0f);
+
+  uint32_t even = count & ~0x7;
+  for (uint32_t i = 0; i < even; i += 8)
   {
-    /* tanh approx clamp */
-    __m128 dt = _mm_load_ps(data);
-    __m128 tmp     = _mm_mul_ps(dt, dt);
-    *(__m128*)data = _mm_div_ps(
-      _mm_mul_ps(
-        dt,
-        _mm_add_ps(c1, tmp)
-      ),
-      _mm_add_ps(c2, tmp)
-    );
+    __m256 x  = _mm256_min_ps(_mm256_max_ps(_mm256_loadu_ps(data + i), lo), hi);
+    __m256 x2 = _mm256_mul_ps(x, x);
+    _mm256_storeu_ps(data + i, _mm256_div_ps(_mm256_mul_ps(x, _mm256_add_ps(c27, x2)),
+                                             _mm256_add_ps(c27, _mm256_mul_ps(c9, x2))));
   }
+  ClampArrayC(data + even, count - even);
+}
+#endif
 
-  if (even != count)
+#if defined(HAS_NEON)
+void MulArrayNEON(float *data, const float mul, uint32_t count)
+{
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i += 4)
+    vst1q_f32(data + i, vmulq_n_f32(vld1q_f32(data + i), mul));
+  MulArrayC(data + even, mul, count - even);
+}
+
+void MulAddArrayNEON(float *data, const float *add, const float mul, uint32_t count)
+{
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i += 4)
+    vst1q_f32(data + i, vmlaq_n_f32(vld1q_f32(data + i), vld1q_f32(add + i), mul));
+  MulAddArrayC(data + even, add + even, mul, count - even);
+}
+
+float PeakArrayNEON(const float *data, uint32_t count)
+{
+  float32x4_t peak = vdupq_n_f32(0.0f);
+
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i += 4)
+    peak = vmaxq_f32(peak, vabsq_f32(vld1q_f32(data + i)));
+
+  float32x2_t half = vpmax_f32(vget_low_f32(peak), vget_high_f32(peak));
+  half = vpmax_f32(half, half);
+  return std::max(vget_lane_f32(half, 0), PeakArrayC(data + even, count - even));
+}
+
+void ClampArrayNEON(float *data, uint32_t count)
+{
+  const float32x4_t c27 = vdupq_n_f32(27.0f);
+  const float32x4_t hi  = vdupq_n_f32(3.0f);
+  const float32x4_t lo  = vdupq_n_f32(-3.0f);
+
+  uint32_t even = count & ~0x3;
+  for (uint32_t i = 0; i < even; i += 4)
   {
-    uint32_t odd = count - even;
-    if (odd == 1)
-      data[0] = SoftClamp(data[0]);
-    else
-    {
-      __m128 dt;
-      __m128 tmp;
-      __m128 out;
-      if (odd == 2)
-      {
-        /* tanh approx clamp */
-        dt  = _mm_setr_ps(data[0], data[1], 0, 0);
-        tmp = _mm_mul_ps(dt, dt);
-        out = _mm_div_ps(
-          _mm_mul_ps(
-            dt,
-            _mm_add_ps(c1, tmp)
-          ),
-          _mm_add_ps(c2, tmp)
-        );
-
-        data[0] = ((float*)&out)[0];
-        data[1] = ((float*)&out)[1];
-      }
-      else
-      {
-        /* tanh approx clamp */
-        dt  = _mm_setr_ps(data[0], data[1], data[2], 0);
-        tmp = _mm_mul_ps(dt, dt);
-        out = _mm_div_ps(
-          _mm_mul_ps(
-            dt,
-            _mm_add_ps(c1, tmp)
-          ),
-          _mm_add_ps(c2, tmp)
-        );
-
-        data[0] = ((float*)&out)[0];
-        data[1] = ((float*)&out)[1];
-        data[2] = ((float*)&out)[2];
-      }
-    }
+    float32x4_t x   = vminq_f32(vmaxq_f32(vld1q_f32(data + i), lo), hi);
+    float32x4_t x2  = vmulq_f32(x, x);
+    float32x4_t num = vmulq_f32(x, vaddq_f32(c27, x2));
+    float32x4_t den = vmlaq_n_f32(c27, x2, 9.0f);
+#if defined(__aarch64__)
+    vst1q_f32(data + i, vdivq_f32(num, den));
+#else
+    // no division on ARMv7, refine the reciprocal estimate twice
+    float32x4_t rcp = vrecpeq_f32(den);
+    rcp = vmulq_f32(vrecpsq_f32(den, rcp), rcp);
+    rcp = vmulq_f32(vrecpsq_f32(den, rcp), rcp);
+    vst1q_f32(data + i, vmulq_f32(num, rcp));
+#endif
   }
+  ClampArrayC(data + even, count - even);
+}
+#endif
+
+const CAEUtil::SSampleKernels& GetKernels()
+{
+  static const CAEUtil::SSampleKernels kernels = []
+  {
+    CAEUtil::SSampleKernels fastest = CAEUtil::GetSampleKernels().back();
+    CLog::Log(LOGDEBUG, "CAEUtil::GetKernels - using %s sample processing", fastest.name);
+    return fastest;
+  }();
+  return kernels;
+}
+
+} // unnamed namespace
+
+std::vector<CAEUtil::SSampleKernels> CAEUtil::GetSampleKernels()
+{
+  std::vector<SSampleKernels> kernels = { { "C", MulArrayC, MulAddArrayC, PeakArrayC, ClampArrayC } };
+
+#if defined(HAVE_SSE) && defined(__SSE__)
+  kernels.push_back({ "SSE", CAEUtil::SSEMulArray, CAEUtil::SSEMulAddArray, PeakArraySSE, ClampArraySSE });
+  if (g_cpuInfo.GetCPUFeatures() & CPU_FEATURE_AVX)
+    kernels.push_back({ "AVX", MulArrayAVX, MulAddArrayAVX, PeakArrayAVX, ClampArrayAVX });
+#elif defined(HAS_NEON)
+  if (g_cpuInfo.GetCPUFeatures() & CPU_FEATURE_NEON)
+    kernels.push_back({ "NEON", MulArrayNEON, MulAddArrayNEON, PeakArrayNEON, ClampArrayNEON });
 #endif
+
+  return kernels;
+}
+
+void CAEUtil::MulArray(float *data, const float mul, uint32_t count)
+{
+  GetKernels().mulArray(data, mul, count);
+}
+
+void CAEUtil::MulAddArray(float *data, const float *add, const float mul, uint32_t count)
+{
+  GetKernels().mulAddArray(data, add, mul, count);
+}
+
+float CAEUtil::PeakArray(const float *data, uint32_t count)
+{
+  return GetKernels().peakArray(data, count);
+}
+
+void CAEUtil::ClampArray(float *data, uint32_t count)
+{
+  GetKernels().clampArray(data, count);
 }
 
 bool CAEUtil::S16NeedsByteSwap(AEDataFormat in, AEDataFormat out)
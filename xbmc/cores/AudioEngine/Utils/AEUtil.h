@@ -11,6 +11,7 @@
 #include "AEAudioFormat.h"
 #include "PlatformDefs.h"
 #include <math.h>
+#include <vector>
 
 extern "C" {
 #include "libavutil/samplefmt.h"
@@ -111,9 +112,9 @@ private:
     static __m128i m_sseSeed;
   #endif
 
+public:
   static float SoftClamp(const float x);
 
-public:
   static CAEChannelInfo          GuessChLayout     (const unsigned int channels);
   static const char*             GetStdChLayoutName(const enum AEStdChLayout layout);
   static unsigned int      DataFormatToBits  (const enum AEDataFormat dataFormat);
@@ -182,10 +183,35 @@ public:
 
   #if defined(HAVE_SSE) && defined(__SSE__)
   static void SSEMulArray     (float *data, const float mul, uint32_t count);
-  static void SSEMulAddArray  (float *data, float *add, const float mul, uint32_t count);
+  static void SSEMulAddArray  (float *data, const float *add, const float mul, uint32_t count);
   #endif
+
+  /*! \brief The sample processing below runs the fastest implementation the CPU supports,
+   picked once via CCPUInfo: AVX or SSE on x86, NEON on ARM, plain C otherwise.
+   */
+  static void MulArray(float *data, const float mul, uint32_t count);
+  static void MulAddArray(float *data, const float *add, const float mul, uint32_t count);
+  /*! \brief largest absolute value of the samples */
+  static float PeakArray(const float *data, uint32_t count);
+  /*! \brief soft clamp the samples to -1..1 */
   static void ClampArray(float *data, uint32_t count);
 
+  /*! \brief One implementation of the sample processing functions above */
+  struct SSampleKernels
+  {
+    const char *name;
+    void (*mulArray)(float *data, const float mul, uint32_t count);
+    void (*mulAddArray)(float *data, const float *add, const float mul, uint32_t count);
+    float (*peakArray)(const float *data, uint32_t count);
+    void (*clampArray)(float *data, uint32_t count);
+  };
+
+  /*! \brief The implementations the build and the CPU support, from the C
+   reference to the fastest one, which is the one used. Lets tests check each
+   of them against the reference.
+   */
+  static std::vector<SSampleKernels> GetSampleKernels();
+
   static bool S16NeedsByteSwap(AEDataFormat in, AEDataFormat out);
 
   static uint64_t GetAVChannelLayout(const CAEChannelInfo &info);
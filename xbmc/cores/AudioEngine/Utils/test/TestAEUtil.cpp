@@ -0,0 +1,156 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Utils/AEUtil.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+namespace
+{
+// odd lengths and offsets exercise the unaligned head and the remainder of the vector loops
+const uint32_t lengths[] = { 0, 1, 3, 4, 7, 8, 9, 31, 64, 1027 };
+const uint32_t offsets[] = { 0, 1, 3 };
+
+std::vector<float> Samples(uint32_t count, float scale)
+{
+  std::vector<float> samples(count);
+  for (uint32_t i = 0; i < count; i++)
+    samples[i] = scale * sinf(i * 0.37f);
+  return samples;
+}
+}
+
+TEST(TestAEUtil, MulArray)
+{
+  for (uint32_t count : lengths)
+  {
+    for (uint32_t offset : offsets)
+    {
+      std::vector<float> data = Samples(count + offset + 1, 2.0f);
+      std::vector<float> expected = data;
+      for (uint32_t i = 0; i < count; i++)
+        expected[offset + i] *= 0.3f;
+
+      CAEUtil::MulArray(data.data() + offset, 0.3f, count);
+      for (size_t i = 0; i < data.size(); i++)
+        EXPECT_FLOAT_EQ(expected[i], data[i]) << "count " << count << " offset " << offset;
+    }
+  }
+}
+
+TEST(TestAEUtil, MulAddArray)
+{
+  for (uint32_t count : lengths)
+  {
+    for (uint32_t offset : offsets)
+    {
+      std::vector<float> data = Samples(count + offset + 1, 0.5f);
+      std::vector<float> add = Samples(count + offset + 1, 0.8f);
+      std::vector<float> expected = data;
+      for (uint32_t i = 0; i < count; i++)
+        expected[offset + i] += add[offset + i] * 0.7f;
+
+      CAEUtil::MulAddArray(data.data() + offset, add.data() + offset, 0.7f, count);
+      for (size_t i = 0; i < data.size(); i++)
+        EXPECT_NEAR(expected[i], data[i], 1e-6f) << "count " << count << " offset " << offset;
+    }
+  }
+}
+
+TEST(TestAEUtil, PeakArray)
+{
+  for (uint32_t count : lengths)
+  {
+    for (uint32_t offset : offsets)
+    {
+      std::vector<float> data = Samples(count + offset + 1, 1.5f);
+      // values outside of the range must not count
+      data.back() = 100.0f;
+      if (offset)
+        data[0] = -100.0f;
+
+      float expected = 0.0f;
+      for (uint32_t i = 0; i < count; i++)
+        expected = std::max(expected, std::fabs(data[offset + i]));
+
+      EXPECT_EQ(expected, CAEUtil::PeakArray(data.data() + offset, count)) << "count " << count << " offset " << offset;
+    }
+  }
+}
+
+TEST(TestAEUtil, ClampArray)
+{
+  std::vector<float> data = { 0.0f, 0.5f, -0.5f, 1.0f, -1.0f, 2.9f, 3.0f, 10.0f, -10.0f };
+  std::vector<float> samples = data;
+  CAEUtil::ClampArray(data.data(), data.size());
+
+  for (size_t i = 0; i < data.size(); i++)
+  {
+    float x = std::min(std::max(samples[i], -3.0f), 3.0f);
+    float expected = x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+    EXPECT_NEAR(expected, data[i], 1e-6f) << "sample " << samples[i];
+    EXPECT_LE(std::fabs(data[i]), 1.0f);
+  }
+
+  // the vector and the C implementation have to agree
+  for (uint32_t count : lengths)
+  {
+    std::vector<float> block = Samples(count, 4.0f);
+    std::vector<float> single = block;
+    CAEUtil::ClampArray(block.data(), count);
+    for (uint32_t i = 0; i < count; i++)
+      CAEUtil::ClampArray(&single[i], 1);
+    for (uint32_t i = 0; i < count; i++)
+      EXPECT_NEAR(single[i], block[i], 1e-6f) << "count " << count;
+  }
+}
+
+TEST(TestAEUtil, KernelsMatchReference)
+{
+  std::vector<CAEUtil::SSampleKernels> kernels = CAEUtil::GetSampleKernels();
+  ASSERT_FALSE(kernels.empty());
+  const CAEUtil::SSampleKernels& reference = kernels.front();
+
+  for (const auto& kernel : kernels)
+  {
+    for (uint32_t count : lengths)
+    {
+      for (uint32_t offset : offsets)
+      {
+        const size_t size = count + offset + 1;
+        std::vector<float> add = Samples(size, 0.8f);
+
+        std::vector<float> expected = Samples(size, 4.0f);
+        std::vector<float> data = expected;
+        reference.mulArray(expected.data() + offset, 0.3f, count);
+        kernel.mulArray(data.data() + offset, 0.3f, count);
+        for (size_t i = 0; i < size; i++)
+          EXPECT_FLOAT_EQ(expected[i], data[i]) << kernel.name << " mul, count " << count << " offset " << offset;
+
+        reference.mulAddArray(expected.data() + offset, add.data() + offset, 0.7f, count);
+        kernel.mulAddArray(data.data() + offset, add.data() + offset, 0.7f, count);
+        for (size_t i = 0; i < size; i++)
+          EXPECT_NEAR(expected[i], data[i], 1e-6f) << kernel.name << " muladd, count " << count << " offset " << offset;
+
+        EXPECT_EQ(reference.peakArray(expected.data() + offset, count), kernel.peakArray(data.data() + offset, count))
+          << kernel.name << " peak, count " << count << " offset " << offset;
+
+        expected = Samples(size, 4.0f);
+        data = expected;
+        reference.clampArray(expected.data() + offset, count);
+        kernel.clampArray(data.data() + offset, count);
+        for (size_t i = 0; i < size; i++)
+          EXPECT_NEAR(expected[i], data[i], 1e-6f) << kernel.name << " clamp, count " << count << " offset " << offset;
+      }
+    }
+  }
+}
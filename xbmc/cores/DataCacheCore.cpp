@@ -392,3 +392,34 @@ float CDataCacheCore::GetPlayPercentage()
 
   return m_timeInfo.m_time * 100 / static_cast<float>(iTotalTime);
 }
+
+// demux packet pool
+void CDataCacheCore::SetPacketPoolStats(uint64_t requests, uint64_t hits, uint64_t cachedBytes)
+{
+  CSingleLock lock(m_packetPoolSection);
+
+  m_packetPoolInfo.m_requests = requests;
+  m_packetPoolInfo.m_hits = hits;
+  m_packetPoolInfo.m_cachedBytes = cachedBytes;
+}
+
+uint64_t CDataCacheCore::GetPacketPoolRequests()
+{
+  CSingleLock lock(m_packetPoolSection);
+
+  return m_packetPoolInfo.m_requests;
+}
+
+uint64_t CDataCacheCore::GetPacketPoolHits()
+{
+  CSingleLock lock(m_packetPoolSection);
+
+  return m_packetPoolInfo.m_hits;
+}
+
+uint64_t CDataCacheCore::GetPacketPoolCachedBytes()
+{
+  CSingleLock lock(m_packetPoolSection);
+
+  return m_packetPoolInfo.m_cachedBytes;
+}
@@ -112,6 +112,12 @@ public:
    */
   int64_t GetMaxTime();
 
+  // demux packet pool
+  void SetPacketPoolStats(uint64_t requests, uint64_t hits, uint64_t cachedBytes);
+  uint64_t GetPacketPoolRequests();
+  uint64_t GetPacketPoolHits();
+  uint64_t GetPacketPoolCachedBytes();
+
 protected:
   std::atomic_bool m_hasAVInfoChanges;
 
@@ -163,4 +169,12 @@ protected:
     int64_t m_timeMax;
     int64_t m_timeMin;
   } m_timeInfo = {};
+
+  CCriticalSection m_packetPoolSection;
+  struct SPacketPoolInfo
+  {
+    uint64_t m_requests;
+    uint64_t m_hits;
+    uint64_t m_cachedBytes;
+  } m_packetPoolInfo = {};
 };
@@ -0,0 +1,177 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DVDDemuxPacketPool.h"
+#include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
+#include "threads/SingleLock.h"
+
+#ifdef TARGET_POSIX
+#include "platform/linux/XMemUtils.h"
+#endif
+
+namespace
+{
+// keeps the payload 16 byte aligned, first byte holds the size class
+const size_t BUFFER_HEADER_SIZE = 16;
+const uint8_t UNPOOLED_CLASS = 0xFF;
+}
+
+CDVDDemuxPacketPool::CDVDDemuxPacketPool() = default;
+
+CDVDDemuxPacketPool::~CDVDDemuxPacketPool()
+{
+  Trim();
+}
+
+CDVDDemuxPacketPool& CDVDDemuxPacketPool::GetInstance()
+{
+  static CDVDDemuxPacketPool pool;
+  return pool;
+}
+
+int CDVDDemuxPacketPool::GetSizeClass(size_t size)
+{
+  int sizeClass = 0;
+  while ((static_cast<size_t>(1) << (sizeClass + MIN_CLASS_SHIFT)) < size)
+  {
+    if (++sizeClass >= NUM_CLASSES)
+      return -1;
+  }
+  return sizeClass;
+}
+
+DemuxPacket* CDVDDemuxPacketPool::AllocatePacket()
+{
+  {
+    CSingleLock lock(m_section);
+    if (!m_packets.empty())
+    {
+      DemuxPacket* packet = m_packets.back();
+      m_packets.pop_back();
+      return packet;
+    }
+  }
+  return new DemuxPacket();
+}
+
+void CDVDDemuxPacketPool::ReleasePacket(DemuxPacket* packet)
+{
+  // drop payload references and restore the defaults outside the lock
+  *packet = DemuxPacket();
+
+  {
+    CSingleLock lock(m_section);
+    if (m_packets.size() < MAX_CACHED_PACKETS)
+    {
+      m_packets.push_back(packet);
+      return;
+    }
+  }
+  delete packet;
+}
+
+uint8_t* CDVDDemuxPacketPool::AllocateBuffer(size_t size, size_t padding)
+{
+  m_requests++;
+
+  const int sizeClass = GetSizeClass(size + padding);
+  if (sizeClass >= 0)
+  {
+    CSingleLock lock(m_section);
+    std::vector<uint8_t*>& buffers = m_buffers[sizeClass];
+    if (!buffers.empty())
+    {
+      uint8_t* buffer = buffers.back();
+      buffers.pop_back();
+      m_cachedBytes -= static_cast<size_t>(1) << (sizeClass + MIN_CLASS_SHIFT);
+      m_hits++;
+      return buffer;
+    }
+  }
+
+  const size_t capacity = sizeClass >= 0 ? static_cast<size_t>(1) << (sizeClass + MIN_CLASS_SHIFT) : size + padding;
+  uint8_t* block = static_cast<uint8_t*>(_aligned_malloc(capacity + BUFFER_HEADER_SIZE, 16));
+  if (!block)
+    return nullptr;
+
+  block[0] = sizeClass >= 0 ? static_cast<uint8_t>(sizeClass) : UNPOOLED_CLASS;
+  return block + BUFFER_HEADER_SIZE;
+}
+
+void CDVDDemuxPacketPool::ReleaseBuffer(uint8_t* buffer)
+{
+  uint8_t* block = buffer - BUFFER_HEADER_SIZE;
+  const uint8_t sizeClass = block[0];
+
+  if (sizeClass != UNPOOLED_CLASS)
+  {
+    const size_t capacity = static_cast<size_t>(1) << (sizeClass + MIN_CLASS_SHIFT);
+
+    CSingleLock lock(m_section);
+    std::vector<uint8_t*>& buffers = m_buffers[sizeClass];
+    if (buffers.size() < MAX_CACHED_PER_CLASS && m_cachedBytes + capacity <= MAX_CACHED_BYTES)
+    {
+      buffers.push_back(buffer);
+      m_cachedBytes += capacity;
+      return;
+    }
+  }
+
+  _aligned_free(block);
+}
+
+void CDVDDemuxPacketPool::Trim()
+{
+  std::vector<uint8_t*> buffers;
+  std::vector<DemuxPacket*> packets;
+
+  {
+    CSingleLock lock(m_section);
+    for (auto& classBuffers : m_buffers)
+    {
+      buffers.insert(buffers.end(), classBuffers.begin(), classBuffers.end());
+      classBuffers.clear();
+    }
+    packets.swap(m_packets);
+    m_cachedBytes = 0;
+  }
+
+  for (uint8_t* buffer : buffers)
+    _aligned_free(buffer - BUFFER_HEADER_SIZE);
+  for (DemuxPacket* packet : packets)
+    delete packet;
+}
+
+void CDVDDemuxPacketPool::AddUser()
+{
+  CSingleLock lock(m_section);
+  m_users++;
+}
+
+void CDVDDemuxPacketPool::RemoveUser()
+{
+  {
+    CSingleLock lock(m_section);
+    if (m_users > 0 && --m_users > 0)
+      return;
+  }
+
+  // packets still in flight are cached again when they come back
+  Trim();
+}
+
+CDVDDemuxPacketPool::Stats CDVDDemuxPacketPool::GetStats() const
+{
+  Stats stats;
+  stats.requests = m_requests;
+  stats.hits = m_hits;
+
+  CSingleLock lock(m_section);
+  stats.cachedBytes = m_cachedBytes;
+  return stats;
+}
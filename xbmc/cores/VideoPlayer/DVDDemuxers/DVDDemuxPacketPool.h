@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+struct DemuxPacket;
+
+/*!
+ * \brief Recycles DemuxPacket structs and their padded payload buffers.
+ *
+ * Payload buffers are grouped in power of two size classes. Each buffer carries
+ * a small header in front of the payload holding its size class, so a buffer
+ * can be returned to the right free list without extending DemuxPacket, which
+ * is part of the add-on interface.
+ *
+ * There is one pool for the whole process, shared by all players. The cache
+ * is freed when the last user is gone, and the statistics are process wide
+ * totals: a player takes the difference to the totals at its start.
+ */
+class CDVDDemuxPacketPool
+{
+public:
+  struct Stats
+  {
+    uint64_t requests = 0; //!< payload buffers handed out
+    uint64_t hits = 0; //!< payload buffers served from the free lists
+    uint64_t cachedBytes = 0; //!< bytes currently held in the free lists
+  };
+
+  CDVDDemuxPacketPool();
+  ~CDVDDemuxPacketPool();
+
+  static CDVDDemuxPacketPool& GetInstance();
+
+  DemuxPacket* AllocatePacket();
+  void ReleasePacket(DemuxPacket* packet);
+
+  /*!
+   * \brief Get a 16 byte aligned buffer of at least size + padding bytes
+   */
+  uint8_t* AllocateBuffer(size_t size, size_t padding);
+  void ReleaseBuffer(uint8_t* buffer);
+
+  /*!
+   * \brief Register a user of the pool, e.g. a player
+   */
+  void AddUser();
+  /*!
+   * \brief Unregister a user of the pool, the last one trims the pool
+   */
+  void RemoveUser();
+
+  /*!
+   * \brief Free all cached packets and buffers, keeps the statistics
+   */
+  void Trim();
+  Stats GetStats() const;
+
+private:
+  CDVDDemuxPacketPool(const CDVDDemuxPacketPool&) = delete;
+  CDVDDemuxPacketPool& operator=(const CDVDDemuxPacketPool&) = delete;
+
+  static int GetSizeClass(size_t size);
+
+  static const int MIN_CLASS_SHIFT = 10; // 1 KiB
+  static const int NUM_CLASSES = 15; // up to 16 MiB
+  static const size_t MAX_CACHED_PER_CLASS = 256;
+  static const size_t MAX_CACHED_BYTES = 64 * 1024 * 1024;
+  static const size_t MAX_CACHED_PACKETS = 1024;
+
+  mutable CCriticalSection m_section;
+  std::vector<uint8_t*> m_buffers[NUM_CLASSES];
+  std::vector<DemuxPacket*> m_packets;
+  size_t m_cachedBytes = 0;
+  unsigned int m_users = 0;
+
+  std::atomic<uint64_t> m_requests{0};
+  std::atomic<uint64_t> m_hits{0};
+};
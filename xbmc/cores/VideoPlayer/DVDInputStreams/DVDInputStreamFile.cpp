@@ -8,15 +8,74 @@
 
 #include "DVDInputStreamFile.h"
 #include "ServiceBroker.h"
+#include "URL.h"
 #include "filesystem/File.h"
 #include "filesystem/IFile.h"
+#include "filesystem/SpecialProtocol.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 
+#include <algorithm>
+#include <cinttypes>
+#include <cstdint>
+#include <cstring>
+
+#if defined(TARGET_POSIX)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
+#include <sys/param.h>
+#include <sys/mount.h>
+#else
+#include <sys/vfs.h>
+#endif
+#endif
+
 using namespace XFILE;
 
+namespace
+{
+// how far ahead of the read position the kernel is asked to page in a mapped file
+const int64_t MAP_READAHEAD = 8 * 1024 * 1024;
+
+#if defined(TARGET_POSIX)
+/*!
+ * Network filesystems look local once mounted, but a mapping of a file on them
+ * raises SIGBUS instead of a read error when the server goes away.
+ */
+bool IsLocalFilesystem(int fd)
+{
+  struct statfs fs;
+  if (fstatfs(fd, &fs) != 0)
+    return false;
+
+#if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
+  return (fs.f_flags & MNT_LOCAL) != 0;
+#else
+  switch (static_cast<uint32_t>(fs.f_type))
+  {
+    case 0x6969:     // nfs
+    case 0x517B:     // smbfs
+    case 0xFF534D42: // cifs
+    case 0xFE534D42: // smb2
+    case 0x65735546: // fuse (sshfs, ...)
+    case 0x01021997: // 9p
+    case 0x00C36400: // ceph
+    case 0x5346414F: // afs
+    case 0x73757245: // coda
+      return false;
+    default:
+      return true;
+  }
+#endif
+}
+#endif
+}
+
 CDVDInputStreamFile::CDVDInputStreamFile(const CFileItem& fileitem, unsigned int flags)
   : CDVDInputStream(DVDSTREAM_TYPE_FILE, fileitem), m_flags(flags)
 {
@@ -92,13 +151,141 @@ bool CDVDInputStreamFile::Open()
   if (m_pFile->GetImplementation() && (content.empty() || content == "application/octet-stream"))
     m_content = m_pFile->GetImplementation()->GetProperty(XFILE::FILE_PROPERTY_CONTENT_TYPE);
 
+  if (!(flags & READ_CACHED) && (flags & READ_AUDIO_VIDEO) &&
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheMemoryMapLocal)
+    OpenMapping();
+
   m_eof = false;
   return true;
 }
 
+/*!
+ * Local files are read straight from a shared read-only mapping. This skips the
+ * CFile layers and a read() syscall per demuxer request, and lets us ask the
+ * kernel to page in the region ahead of the read position.
+ */
+bool CDVDInputStreamFile::OpenMapping()
+{
+#if defined(TARGET_POSIX)
+  CURL url(CSpecialProtocol::TranslatePath(m_item.GetDynPath()));
+  if (!url.IsLocal() || URIUtils::IsStack(url.Get()))
+    return false;
+
+  m_mapFd = open(url.GetFileName().c_str(), O_RDONLY);
+  if (m_mapFd < 0)
+    return false;
+
+  if (!IsLocalFilesystem(m_mapFd))
+  {
+    CloseMapping();
+    return false;
+  }
+
+  m_mapPos = 0;
+  m_mapAdvised = 0;
+  if (!UpdateMapping())
+  {
+    CloseMapping();
+    return false;
+  }
+
+  CLog::Log(LOGDEBUG, "CDVDInputStreamFile::OpenMapping - mapped %" PRId64 " bytes of %s",
+            m_mapSize, CURL::GetRedacted(m_item.GetDynPath()).c_str());
+  return true;
+#else
+  return false;
+#endif
+}
+
+/*!
+ * (Re)map the whole file, files that are still being written to (recordings)
+ * are remapped once the reader catches up with the mapped size.
+ */
+bool CDVDInputStreamFile::UpdateMapping()
+{
+#if defined(TARGET_POSIX)
+  struct stat st;
+  if (fstat(m_mapFd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size <= 0)
+    return false;
+
+  if (m_mapData && st.st_size == m_mapSize)
+    return true;
+
+  // too large for the address space, e.g. a huge file on a 32 bit system
+  if (static_cast<uint64_t>(st.st_size) > SIZE_MAX)
+    return false;
+
+  void* data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, m_mapFd, 0);
+  if (data == MAP_FAILED)
+    return false;
+
+  if (m_mapData)
+    munmap(m_mapData, m_mapSize);
+
+  m_mapData = static_cast<uint8_t*>(data);
+  m_mapSize = st.st_size;
+  m_mapAdvised = std::min(m_mapAdvised, m_mapPos);
+  madvise(m_mapData, m_mapSize, MADV_SEQUENTIAL);
+  return true;
+#else
+  return false;
+#endif
+}
+
+void CDVDInputStreamFile::CloseMapping()
+{
+#if defined(TARGET_POSIX)
+  if (m_mapData)
+    munmap(m_mapData, m_mapSize);
+  if (m_mapFd >= 0)
+    close(m_mapFd);
+#endif
+
+  m_mapData = nullptr;
+  m_mapFd = -1;
+  m_mapSize = 0;
+  m_mapPos = 0;
+  m_mapAdvised = 0;
+}
+
+int CDVDInputStreamFile::ReadMapping(uint8_t* buf, int buf_size)
+{
+  if (m_mapPos >= m_mapSize && !UpdateMapping())
+  {
+    // the file grew beyond what can be mapped, go on with regular reads
+    int64_t pos = m_mapPos;
+    CloseMapping();
+    if (m_pFile->Seek(pos, SEEK_SET) != pos)
+      return -1;
+    return m_pFile->Read(buf, buf_size);
+  }
+
+  int64_t size = std::min(static_cast<int64_t>(buf_size), m_mapSize - m_mapPos);
+  if (size <= 0)
+    return 0;
+
+#if defined(TARGET_POSIX)
+  // keep the kernel paging in ahead of us, in steps of half the readahead window
+  if (m_mapPos + MAP_READAHEAD / 2 > m_mapAdvised || m_mapPos < m_mapAdvised - MAP_READAHEAD)
+  {
+    static const int64_t pageSize = sysconf(_SC_PAGESIZE);
+    int64_t start = m_mapPos - m_mapPos % pageSize;
+    int64_t end = std::min(m_mapPos + MAP_READAHEAD, m_mapSize);
+    madvise(m_mapData + start, end - start, MADV_WILLNEED);
+    m_mapAdvised = end;
+  }
+#endif
+
+  memcpy(buf, m_mapData + m_mapPos, size);
+  m_mapPos += size;
+  return static_cast<int>(size);
+}
+
 // close file and reset everything
 void CDVDInputStreamFile::Close()
 {
+  CloseMapping();
+
   if (m_pFile)
   {
     m_pFile->Close();
@@ -114,7 +301,7 @@ int CDVDInputStreamFile::Read(uint8_t* buf, int buf_size)
 {
   if(!m_pFile) return -1;
 
-  ssize_t ret = m_pFile->Read(buf, buf_size);
+  ssize_t ret = m_mapData ? ReadMapping(buf, buf_size) : m_pFile->Read(buf, buf_size);
 
   if (ret < 0)
     return -1; // player will retry read in case of error until playback is stopped
@@ -133,7 +320,28 @@ int64_t CDVDInputStreamFile::Seek(int64_t offset, int whence)
   if(whence == SEEK_POSSIBLE)
     return m_pFile->IoControl(IOCTRL_SEEK_POSSIBLE, NULL);
 
-  int64_t ret = m_pFile->Seek(offset, whence);
+  int64_t ret;
+  if (m_mapData)
+  {
+    if (whence == SEEK_END || (whence == SEEK_SET && offset > m_mapSize))
+      UpdateMapping();
+
+    if (whence == SEEK_SET)
+      ret = offset;
+    else if (whence == SEEK_CUR)
+      ret = m_mapPos + offset;
+    else if (whence == SEEK_END)
+      ret = m_mapSize + offset;
+    else
+      ret = -1;
+
+    if (ret < 0 || ret > m_mapSize)
+      ret = -1;
+    else
+      m_mapPos = ret;
+  }
+  else
+    ret = m_pFile->Seek(offset, whence);
 
   /* if we succeed, we are not eof anymore */
   if( ret >= 0 ) m_eof = false;
@@ -143,6 +351,8 @@ int64_t CDVDInputStreamFile::Seek(int64_t offset, int whence)
 
 int64_t CDVDInputStreamFile::GetLength()
 {
+  if (m_mapData)
+    return m_mapSize;
   if (m_pFile)
     return m_pFile->GetLength();
   return 0;
@@ -28,7 +28,19 @@ public:
   bool GetCacheStatus(XFILE::SCacheStatus *status) override;
 
 protected:
+  bool OpenMapping();
+  void CloseMapping();
+  bool UpdateMapping();
+  int ReadMapping(uint8_t* buf, int buf_size);
+
   XFILE::CFile* m_pFile = nullptr;
   bool m_eof = false;
   unsigned int m_flags = 0;
+
+  // memory mapped read path for local files, see OpenMapping()
+  int m_mapFd = -1;
+  uint8_t* m_mapData = nullptr;
+  int64_t m_mapSize = 0;
+  int64_t m_mapPos = 0;
+  int64_t m_mapAdvised = 0;
 };
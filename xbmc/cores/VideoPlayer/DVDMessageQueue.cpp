@@ -13,6 +13,36 @@
 #include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
 #include "math.h"
 
+#include <thread>
+
+namespace
+{
+
+DemuxPacket* GetDemuxPacket(CDVDMsg* msg)
+{
+  if (!msg->IsType(CDVDMsg::DEMUXER_PACKET))
+    return nullptr;
+  return static_cast<CDVDMsgDemuxerPacket*>(msg)->GetPacket();
+}
+
+bool GetPacketTime(CDVDMsg* msg, double& time)
+{
+  DemuxPacket* packet = GetDemuxPacket(msg);
+  if (!packet)
+    return false;
+
+  if (packet->dts != DVD_NOPTS_VALUE)
+    time = packet->dts;
+  else if (packet->pts != DVD_NOPTS_VALUE)
+    time = packet->pts;
+  else
+    return false;
+
+  return true;
+}
+
+}
+
 CDVDMessageQueue::CDVDMessageQueue(const std::string &owner) : m_hEvent(true), m_owner(owner)
 {
   m_iDataSize     = 0;
@@ -31,6 +61,20 @@ CDVDMessageQueue::~CDVDMessageQueue()
   Flush(CDVDMsg::NONE);
 }
 
+void CDVDMessageQueue::SetRingBufferSize(size_t size)
+{
+  CSingleLock lock(m_section);
+
+  if (m_bInitialized)
+  {
+    CLog::Log(LOGWARNING, "CDVDMessageQueue(%s)::SetRingBufferSize - queue already initialized", m_owner.c_str());
+    return;
+  }
+
+  Flush(CDVDMsg::NONE);
+  m_ring.Reserve(size);
+}
+
 void CDVDMessageQueue::Init()
 {
   m_iDataSize = 0;
@@ -53,6 +97,31 @@ void CDVDMessageQueue::Flush(CDVDMsg::Message type)
     return type == CDVDMsg::NONE || item.message->IsType(type);
   });
 
+  if (IsRingBuffered())
+  {
+    LockRing();
+
+    // messages we keep are older than anything the producer may put meanwhile,
+    // move them to the consumer end where they are picked up first
+    CDVDMsg* msg;
+    while ((msg = PopRing()))
+    {
+      if (type != CDVDMsg::NONE && !msg->IsType(type))
+        m_messages.emplace_front(msg, 0);
+      msg->Release();
+    }
+    while (!m_overflow.empty())
+    {
+      DVDMessageListItem& item(m_overflow.back());
+      if (type != CDVDMsg::NONE && !item.message->IsType(type))
+        m_messages.emplace_front(item.message, 0);
+      m_overflow.pop_back();
+    }
+
+    UpdateLockedCount();
+    UnlockRing();
+  }
+
   if (type == CDVDMsg::DEMUXER_PACKET ||  type == CDVDMsg::NONE)
   {
     m_iDataSize = 0;
@@ -94,6 +163,9 @@ MsgQueueReturnCode CDVDMessageQueue::PutBack(CDVDMsg* pMsg, int priority)
 
 MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front)
 {
+  if (IsRingBuffered() && priority == 0 && front && pMsg && m_bInitialized)
+    return PutRing(pMsg);
+
   CSingleLock lock(m_section);
 
   if (!m_bInitialized)
@@ -122,7 +194,7 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front
   }
   else
   {
-    if (m_messages.empty())
+    if (m_messages.empty() && !IsRingBuffered())
     {
       m_iDataSize = 0;
       m_TimeBack = DVD_NOPTS_VALUE;
@@ -150,18 +222,56 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front
 
   pMsg->Release();
 
+  UpdateLockedCount();
+
   // inform waiter for new packet
   m_hEvent.Set();
 
   return MSGQ_OK;
 }
 
-MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutInMilliSeconds, int &priority)
+MsgQueueReturnCode CDVDMessageQueue::PutRing(CDVDMsg* pMsg)
 {
-  CSingleLock lock(m_section);
+  DemuxPacket* packet = GetDemuxPacket(pMsg);
+  if (packet)
+    m_iDataSize += packet->iSize;
+
+  double time;
+  if (GetPacketTime(pMsg, time))
+  {
+    m_TimeFront = time;
+    if (m_TimeBack == DVD_NOPTS_VALUE)
+      m_TimeBack = time;
+  }
+
+  // once the ring ran full, keep using the overflow list until the consumer
+  // drained it, otherwise newer messages would overtake older ones
+  if (m_overflowCount > 0 || !m_ring.Push(pMsg))
+  {
+    CSingleLock lock(m_section);
+    m_overflow.emplace_front(pMsg, 0);
+    pMsg->Release();
+    UpdateLockedCount();
+  }
 
+  // only pay for signalling the event if the consumer is actually waiting
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (m_consumerWaiting)
+    m_hEvent.Set();
+
+  return MSGQ_OK;
+}
+
+MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutInMilliSeconds, int &priority)
+{
   *pMsg = NULL;
 
+  if (IsRingBuffered() && priority == 0 && m_bInitialized && !m_bAbortRequest &&
+      GetRing(pMsg))
+    return MSGQ_OK;
+
+  CSingleLock lock(m_section);
+
   int ret = 0;
 
   if (!m_bInitialized)
@@ -191,6 +301,18 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
       *pMsg = item.message->Acquire();
       msgs.pop_back();
       UpdateTimeBack();
+      UpdateLockedCount();
+      ret = MSGQ_OK;
+      break;
+    }
+    else if (priority == 0 && IsRingBuffered() && (*pMsg = PopRing()))
+    {
+      DemuxPacket* packet = GetDemuxPacket(*pMsg);
+      if (packet)
+        m_iDataSize -= packet->iSize;
+
+      UpdateTimeBack();
+      UpdateLockedCount();
       ret = MSGQ_OK;
       break;
     }
@@ -201,11 +323,24 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
     }
     else
     {
+      m_consumerWaiting = true;
       m_hEvent.Reset();
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+
+      // the producer does not take the lock in ring buffer mode, check again
+      // after announcing that we wait
+      if (HasMessages(priority))
+      {
+        m_consumerWaiting = false;
+        continue;
+      }
+
       lock.Leave();
 
       // wait for a new message
-      if (!m_hEvent.WaitMSec(iTimeoutInMilliSeconds))
+      bool signaled = m_hEvent.WaitMSec(iTimeoutInMilliSeconds);
+      m_consumerWaiting = false;
+      if (!signaled)
         return MSGQ_TIMEOUT;
 
       lock.Enter();
@@ -218,50 +353,119 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
   return (MsgQueueReturnCode)ret;
 }
 
-void CDVDMessageQueue::UpdateTimeFront()
+bool CDVDMessageQueue::GetRing(CDVDMsg** pMsg)
 {
-  if (!m_messages.empty())
+  // announce that we access the consumer end of the ring, LockRing waits for this
+  m_ringConsumerActive = true;
+
+  if (!m_ringLocked && m_lockedCount == 0)
   {
-    auto &item = m_messages.front();
-    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+    CDVDMsg* msg;
+    if (m_ring.Pop(msg))
     {
-      DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(item.message)->GetPacket();
+      DemuxPacket* packet = GetDemuxPacket(msg);
       if (packet)
-      {
-        if (packet->dts != DVD_NOPTS_VALUE)
-          m_TimeFront = packet->dts;
-        else if (packet->pts != DVD_NOPTS_VALUE)
-          m_TimeFront = packet->pts;
+        m_iDataSize -= packet->iSize;
 
-        if (m_TimeBack == DVD_NOPTS_VALUE)
-          m_TimeBack = m_TimeFront;
-      }
+      CDVDMsg* const* next = m_ring.Front();
+      double time;
+      if (next && GetPacketTime(*next, time))
+        m_TimeBack = time;
+
+      *pMsg = msg;
     }
   }
+
+  m_ringConsumerActive = false;
+
+  return *pMsg != NULL;
 }
 
-void CDVDMessageQueue::UpdateTimeBack()
+CDVDMsg* CDVDMessageQueue::PopRing()
+{
+  // must hold m_section, the consumer end of the ring is either locked by
+  // us or we are on the consumer thread which is not in GetRing
+  CDVDMsg* msg = NULL;
+  if (m_ring.Pop(msg))
+    return msg;
+
+  if (!m_overflow.empty())
+  {
+    msg = m_overflow.back().message->Acquire();
+    m_overflow.pop_back();
+    return msg;
+  }
+
+  return NULL;
+}
+
+bool CDVDMessageQueue::HasMessages(int priority) const
+{
+  if (!m_prioMessages.empty() && (m_prioMessages.back().priority >= priority || m_drain))
+    return true;
+
+  if (priority > 0)
+    return false;
+
+  return !m_messages.empty() || !m_ring.Empty() || !m_overflow.empty();
+}
+
+void CDVDMessageQueue::LockRing()
+{
+  // must hold m_section, wait until a lock-free Get has left the ring
+  m_ringLocked = true;
+  while (m_ringConsumerActive)
+    std::this_thread::yield();
+}
+
+void CDVDMessageQueue::UnlockRing()
+{
+  m_ringLocked = false;
+}
+
+void CDVDMessageQueue::UpdateLockedCount()
+{
+  if (!IsRingBuffered())
+    return;
+
+  m_overflowCount = m_overflow.size();
+  m_lockedCount = m_overflow.size() + m_messages.size() + m_prioMessages.size();
+}
+
+void CDVDMessageQueue::UpdateTimeFront()
 {
   if (!m_messages.empty())
   {
-    auto &item = m_messages.back();
-    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+    auto &item = m_messages.front();
+    double time;
+    if (GetPacketTime(item.message, time))
     {
-      DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(item.message)->GetPacket();
-      if (packet)
-      {
-        if (packet->dts != DVD_NOPTS_VALUE)
-          m_TimeBack = packet->dts;
-        else if (packet->pts != DVD_NOPTS_VALUE)
-          m_TimeBack = packet->pts;
-
-        if (m_TimeFront == DVD_NOPTS_VALUE)
-          m_TimeFront = m_TimeBack;
-      }
+      m_TimeFront = time;
+      if (m_TimeBack == DVD_NOPTS_VALUE)
+        m_TimeBack = time;
     }
   }
 }
 
+void CDVDMessageQueue::UpdateTimeBack()
+{
+  CDVDMsg* msg = NULL;
+  if (!m_messages.empty())
+    msg = m_messages.back().message;
+  else if (IsRingBuffered() && m_ring.Front())
+    msg = *m_ring.Front();
+  else if (IsRingBuffered() && !m_overflow.empty())
+    msg = m_overflow.back().message;
+
+  double time;
+  if (msg && GetPacketTime(msg, time))
+  {
+    m_TimeBack = time;
+    if (m_TimeFront == DVD_NOPTS_VALUE)
+      m_TimeFront = time;
+  }
+}
+
 unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
 {
   CSingleLock lock(m_section);
@@ -281,6 +485,21 @@ unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
       count++;
   }
 
+  if (IsRingBuffered())
+  {
+    LockRing();
+    m_ring.ForEach([type, &count](CDVDMsg* msg){
+      if (msg->IsType(type))
+        count++;
+    });
+    for (const auto &item : m_overflow)
+    {
+      if (item.message->IsType(type))
+        count++;
+    }
+    UnlockRing();
+  }
+
   return count;
 }
 
@@ -307,20 +526,21 @@ int CDVDMessageQueue::GetLevel() const
 {
   CSingleLock lock(m_section);
 
-  if (m_iDataSize > m_iMaxDataSize)
+  const int dataSize = m_iDataSize;
+  if (dataSize > m_iMaxDataSize)
     return 100;
-  if (m_iDataSize == 0)
+  if (dataSize <= 0)
     return 0;
 
   if (IsDataBased())
   {
-    return std::min(100, 100 * m_iDataSize / m_iMaxDataSize);
+    return std::min(100, 100 * dataSize / m_iMaxDataSize);
   }
 
   int level = std::min(100.0, ceil(100.0 * m_TimeSize * (m_TimeFront - m_TimeBack) / DVD_TIME_BASE ));
 
   // if we added lots of packets with NOPTS, make sure that the queue is not signalled empty
-  if (level == 0 && m_iDataSize != 0)
+  if (level == 0 && dataSize != 0)
   {
     CLog::Log(LOGDEBUG, "CDVDMessageQueue::GetLevel() - can't determine level");
     return 1;
@@ -341,7 +561,9 @@ int CDVDMessageQueue::GetTimeSize() const
 
 bool CDVDMessageQueue::IsDataBased() const
 {
-  return (m_TimeBack == DVD_NOPTS_VALUE  ||
-          m_TimeFront == DVD_NOPTS_VALUE ||
-          m_TimeFront <= m_TimeBack);
+  const double timeBack = m_TimeBack;
+  const double timeFront = m_TimeFront;
+  return (timeBack == DVD_NOPTS_VALUE  ||
+          timeFront == DVD_NOPTS_VALUE ||
+          timeFront <= timeBack);
 }
@@ -15,6 +15,7 @@
 #include <algorithm>
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
+#include "threads/SPSCRingBuffer.h"
 
 struct DVDMessageListItem
 {
@@ -96,9 +97,25 @@ public:
   bool IsInited() const { return m_bInitialized; }
   bool IsDataBased() const;
 
+  /**
+   * Route priority 0 messages put by the producer through a lock-free single
+   * producer / single consumer ring of the given size instead of the locked list.
+   * Priority and put back messages stay on the locked lists. Must be called
+   * before Init(), 0 switches back to the locked list.
+   */
+  void SetRingBufferSize(size_t size);
+  bool IsRingBuffered() const { return m_ring.Capacity() > 0; }
+
 private:
 
   MsgQueueReturnCode Put(CDVDMsg* pMsg, int priority, bool front);
+  MsgQueueReturnCode PutRing(CDVDMsg* pMsg);
+  bool GetRing(CDVDMsg** pMsg);
+  CDVDMsg* PopRing();
+  bool HasMessages(int priority) const;
+  void LockRing();
+  void UnlockRing();
+  void UpdateLockedCount();
   void UpdateTimeFront();
   void UpdateTimeBack();
 
@@ -106,12 +123,12 @@ private:
   mutable CCriticalSection m_section;
 
   std::atomic<bool> m_bAbortRequest;
-  bool m_bInitialized;
+  std::atomic<bool> m_bInitialized{false};
   bool m_drain = false;
 
-  int m_iDataSize;
-  double m_TimeFront;
-  double m_TimeBack;
+  std::atomic<int> m_iDataSize;
+  std::atomic<double> m_TimeFront;
+  std::atomic<double> m_TimeBack;
   double m_TimeSize;
 
   int m_iMaxDataSize;
@@ -119,5 +136,14 @@ private:
 
   std::list<DVDMessageListItem> m_messages;
   std::list<DVDMessageListItem> m_prioMessages;
+
+  // ring buffer mode, m_messages only holds messages at the consumer end then
+  CSPSCRingBuffer<CDVDMsg*> m_ring;
+  std::list<DVDMessageListItem> m_overflow;
+  std::atomic<size_t> m_lockedCount{0};
+  std::atomic<size_t> m_overflowCount{0};
+  std::atomic<bool> m_ringConsumerActive{false};
+  std::atomic<bool> m_ringLocked{false};
+  std::atomic<bool> m_consumerWaiting{false};
 };
 
@@ -655,6 +655,14 @@ int64_t CProcessInfo::GetMaxTime()
   return m_timeMax;
 }
 
+void CProcessInfo::SetPacketPoolStats(uint64_t requests, uint64_t hits, uint64_t cachedBytes)
+{
+  if (m_dataCache)
+  {
+    m_dataCache->SetPacketPoolStats(requests, hits, cachedBytes);
+  }
+}
+
 //******************************************************************************
 // settings
 //******************************************************************************
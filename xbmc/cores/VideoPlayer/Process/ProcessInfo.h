@@ -104,6 +104,7 @@ public:
 
   void SetPlayTimes(time_t start, int64_t current, int64_t min, int64_t max);
   int64_t GetMaxTime();
+  void SetPacketPoolStats(uint64_t requests, uint64_t hits, uint64_t cachedBytes);
 
   // settings
   CVideoSettings GetVideoSettings();
@@ -19,6 +19,7 @@
 #include "DVDInputStreams/InputStreamPVRBase.h"
 
 #include "DVDDemuxers/DVDDemux.h"
+#include "DVDDemuxers/DVDDemuxPacketPool.h"
 #include "DVDDemuxers/DVDDemuxUtils.h"
 #include "DVDDemuxers/DVDDemuxVobsub.h"
 #include "DVDDemuxers/DVDFactoryDemuxer.h"
@@ -74,6 +75,7 @@
 #include "windowing/WinSystem.h"
 #include "DVDCodecs/DVDCodecUtils.h"
 
+#include <cinttypes>
 #include <iterator>
 
 using namespace KODI::MESSAGING;
@@ -713,6 +715,11 @@ bool CVideoPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options
   m_item.SetMimeTypeForInternetFile();
 
   m_processInfo->SetPlayTimes(0,0,0,0);
+  CDVDDemuxPacketPool& packetPool = CDVDDemuxPacketPool::GetInstance();
+  CDVDDemuxPacketPool::Stats poolStats = packetPool.GetStats();
+  m_packetPoolRequests = poolStats.requests;
+  m_packetPoolHits = poolStats.hits;
+  packetPool.AddUser();
   m_bAbortRequest = false;
   m_error = false;
   m_renderManager.PreInit();
@@ -2535,6 +2542,12 @@ void CVideoPlayer::OnExit()
 
   m_messenger.End();
 
+  CDVDDemuxPacketPool& packetPool = CDVDDemuxPacketPool::GetInstance();
+  CDVDDemuxPacketPool::Stats poolStats = packetPool.GetStats();
+  CLog::Log(LOGDEBUG, "VideoPlayer: demux packet pool served %" PRIu64 " of %" PRIu64 " buffers from cache",
+            poolStats.hits - m_packetPoolHits, poolStats.requests - m_packetPoolRequests);
+  packetPool.RemoveUser();
+
   if (m_omxplayer_mode)
   {
     m_OmxPlayerState.av_clock.OMXStop();
@@ -4845,6 +4858,10 @@ void CVideoPlayer::UpdatePlayState(double timeout)
 
   m_processInfo->SetPlayTimes(state.startTime, state.time, state.timeMin, state.timeMax);
 
+  CDVDDemuxPacketPool::Stats poolStats = CDVDDemuxPacketPool::GetInstance().GetStats();
+  m_processInfo->SetPacketPoolStats(poolStats.requests - m_packetPoolRequests, poolStats.hits - m_packetPoolHits,
+                                    poolStats.cachedBytes);
+
   CSingleLock lock(m_StateSection);
   m_State = state;
 }
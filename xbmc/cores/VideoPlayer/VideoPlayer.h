@@ -492,6 +492,8 @@ protected:
   XbmcThreads::EndTime m_cachingTimer;
 
   std::unique_ptr<CProcessInfo> m_processInfo;
+  uint64_t m_packetPoolRequests = 0; // demux packet pool totals when playback started
+  uint64_t m_packetPoolHits = 0;
 
   CCurrentStream m_CurrentAudio;
   CCurrentStream m_CurrentVideo;
@@ -0,0 +1,96 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxPacketPool.h"
+#include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
+
+#include "gtest/gtest.h"
+
+TEST(TestDVDDemuxPacketPool, ReleasedBufferIsReused)
+{
+  CDVDDemuxPacketPool pool;
+
+  uint8_t* buffer = pool.AllocateBuffer(1000, 16);
+  ASSERT_NE(nullptr, buffer);
+  EXPECT_EQ(0u, reinterpret_cast<uintptr_t>(buffer) % 16);
+  pool.ReleaseBuffer(buffer);
+  EXPECT_EQ(1024u, pool.GetStats().cachedBytes);
+
+  uint8_t* again = pool.AllocateBuffer(900, 16);
+  EXPECT_EQ(buffer, again);
+  pool.ReleaseBuffer(again);
+
+  CDVDDemuxPacketPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(2u, stats.requests);
+  EXPECT_EQ(1u, stats.hits);
+}
+
+TEST(TestDVDDemuxPacketPool, ReleasedPacketIsReused)
+{
+  CDVDDemuxPacketPool pool;
+
+  DemuxPacket* packet = pool.AllocatePacket();
+  ASSERT_NE(nullptr, packet);
+  pool.ReleasePacket(packet);
+  EXPECT_EQ(packet, pool.AllocatePacket());
+  pool.ReleasePacket(packet);
+}
+
+TEST(TestDVDDemuxPacketPool, SizeClasses)
+{
+  CDVDDemuxPacketPool pool;
+
+  // 1000 + 24 fills the 1 KiB class, one more byte needs 2 KiB
+  pool.ReleaseBuffer(pool.AllocateBuffer(1000, 24));
+  EXPECT_EQ(1024u, pool.GetStats().cachedBytes);
+  uint8_t* larger = pool.AllocateBuffer(1001, 24);
+  EXPECT_EQ(0u, pool.GetStats().hits);
+  pool.ReleaseBuffer(larger);
+  EXPECT_EQ(1024u + 2048u, pool.GetStats().cachedBytes);
+
+  // a smaller request does not take a buffer of a larger class
+  uint8_t* small = pool.AllocateBuffer(10, 0);
+  EXPECT_NE(larger, small);
+  EXPECT_EQ(2048u, pool.GetStats().cachedBytes);
+  pool.ReleaseBuffer(small);
+
+  // buffers beyond the largest class are not cached
+  pool.ReleaseBuffer(pool.AllocateBuffer(16 * 1024 * 1024 + 1, 0));
+  EXPECT_EQ(1024u + 2048u, pool.GetStats().cachedBytes);
+}
+
+TEST(TestDVDDemuxPacketPool, Trim)
+{
+  CDVDDemuxPacketPool pool;
+
+  pool.ReleaseBuffer(pool.AllocateBuffer(4096, 0));
+  pool.ReleasePacket(pool.AllocatePacket());
+  EXPECT_EQ(4096u, pool.GetStats().cachedBytes);
+
+  pool.Trim();
+  EXPECT_EQ(0u, pool.GetStats().cachedBytes);
+
+  pool.ReleaseBuffer(pool.AllocateBuffer(4096, 0));
+  CDVDDemuxPacketPool::Stats stats = pool.GetStats();
+  EXPECT_EQ(2u, stats.requests);
+  EXPECT_EQ(0u, stats.hits);
+}
+
+TEST(TestDVDDemuxPacketPool, LastUserTrims)
+{
+  CDVDDemuxPacketPool pool;
+
+  pool.AddUser();
+  pool.AddUser();
+  pool.ReleaseBuffer(pool.AllocateBuffer(4096, 0));
+
+  pool.RemoveUser();
+  EXPECT_EQ(4096u, pool.GetStats().cachedBytes);
+  pool.RemoveUser();
+  EXPECT_EQ(0u, pool.GetStats().cachedBytes);
+}
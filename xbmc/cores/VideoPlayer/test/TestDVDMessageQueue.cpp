@@ -0,0 +1,144 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+#include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
+#include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+const int PACKET_SIZE = 100;
+const int OTHER = -1; // a message other than a packet
+const int NONE = -2;  // no message
+
+CDVDMsg* NewPacket(int index)
+{
+  DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(PACKET_SIZE);
+  packet->iSize = PACKET_SIZE;
+  packet->dts = index * DVD_TIME_BASE;
+  return new CDVDMsgDemuxerPacket(packet);
+}
+
+// index of the packet put with NewPacket(), OTHER or NONE
+int GetIndex(CDVDMessageQueue& queue, int priority = 0)
+{
+  CDVDMsg* msg = nullptr;
+  if (queue.Get(&msg, 0, priority) != MSGQ_OK)
+    return NONE;
+
+  int index = OTHER;
+  if (msg->IsType(CDVDMsg::DEMUXER_PACKET))
+    index = static_cast<int>(static_cast<CDVDMsgDemuxerPacket*>(msg)->GetPacket()->dts / DVD_TIME_BASE);
+  msg->Release();
+  return index;
+}
+
+class TestDVDMessageQueue : public ::testing::Test
+{
+protected:
+  TestDVDMessageQueue() : m_queue("test")
+  {
+    m_queue.SetRingBufferSize(4);
+    m_queue.Init();
+  }
+
+  ~TestDVDMessageQueue() override
+  {
+    m_queue.End();
+  }
+
+  CDVDMessageQueue m_queue;
+};
+}
+
+TEST_F(TestDVDMessageQueue, OverflowKeepsOrder)
+{
+  ASSERT_TRUE(m_queue.IsRingBuffered());
+
+  // more than the ring holds, the rest goes through the overflow list
+  for (int i = 0; i < 10; i++)
+    EXPECT_EQ(MSGQ_OK, m_queue.Put(NewPacket(i)));
+  EXPECT_EQ(10 * PACKET_SIZE, m_queue.GetDataSize());
+
+  for (int i = 0; i < 3; i++)
+    EXPECT_EQ(i, GetIndex(m_queue));
+
+  // the ring has room again, but newer packets must not overtake the overflow
+  for (int i = 10; i < 13; i++)
+    EXPECT_EQ(MSGQ_OK, m_queue.Put(NewPacket(i)));
+
+  for (int i = 3; i < 13; i++)
+    EXPECT_EQ(i, GetIndex(m_queue));
+
+  EXPECT_EQ(NONE, GetIndex(m_queue));
+  EXPECT_EQ(0, m_queue.GetDataSize());
+}
+
+TEST_F(TestDVDMessageQueue, PriorityAndPutBack)
+{
+  for (int i = 0; i < 6; i++)
+    m_queue.Put(NewPacket(i));
+  m_queue.Put(new CDVDMsgInt(CDVDMsg::GENERAL_RESYNC, 0), 1);
+
+  // priority messages go first, a priority get doesn't take packets
+  EXPECT_EQ(OTHER, GetIndex(m_queue, 1));
+  EXPECT_EQ(NONE, GetIndex(m_queue, 1));
+
+  EXPECT_EQ(0, GetIndex(m_queue));
+  EXPECT_EQ(1, GetIndex(m_queue));
+
+  // put back messages are the next ones to get, ahead of ring and overflow
+  m_queue.PutBack(NewPacket(100));
+  m_queue.PutBack(NewPacket(101));
+  EXPECT_EQ(101, GetIndex(m_queue));
+
+  m_queue.Put(NewPacket(6));
+  m_queue.Put(new CDVDMsgInt(CDVDMsg::GENERAL_RESYNC, 0), 1);
+  EXPECT_EQ(OTHER, GetIndex(m_queue));
+  EXPECT_EQ(100, GetIndex(m_queue));
+
+  for (int i = 2; i < 7; i++)
+    EXPECT_EQ(i, GetIndex(m_queue));
+  EXPECT_EQ(NONE, GetIndex(m_queue));
+  EXPECT_EQ(0, m_queue.GetDataSize());
+}
+
+TEST_F(TestDVDMessageQueue, FlushAndPacketCount)
+{
+  m_queue.Put(NewPacket(0));
+  m_queue.Put(new CDVDMsgInt(CDVDMsg::GENERAL_RESYNC, 0));
+  for (int i = 1; i < 8; i++)
+    m_queue.Put(NewPacket(i));
+  m_queue.PutBack(NewPacket(100));
+  m_queue.Put(new CDVDMsgInt(CDVDMsg::GENERAL_RESYNC, 1), 1);
+
+  // ring, overflow, put back and priority messages are all counted
+  EXPECT_EQ(9u, m_queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET));
+  EXPECT_EQ(2u, m_queue.GetPacketCount(CDVDMsg::GENERAL_RESYNC));
+
+  // flushing the packets keeps the other messages in their order
+  m_queue.Flush();
+  EXPECT_EQ(0u, m_queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET));
+  EXPECT_EQ(2u, m_queue.GetPacketCount(CDVDMsg::GENERAL_RESYNC));
+  EXPECT_EQ(0, m_queue.GetDataSize());
+
+  // the queue keeps working in ring mode afterwards
+  m_queue.Put(NewPacket(8));
+  EXPECT_EQ(OTHER, GetIndex(m_queue));
+  EXPECT_EQ(OTHER, GetIndex(m_queue));
+  EXPECT_EQ(8, GetIndex(m_queue));
+  EXPECT_EQ(NONE, GetIndex(m_queue));
+
+  m_queue.Put(NewPacket(9));
+  m_queue.Flush(CDVDMsg::NONE);
+  EXPECT_EQ(0u, m_queue.GetPacketCount(CDVDMsg::DEMUXER_PACKET));
+  EXPECT_EQ(NONE, GetIndex(m_queue));
+}
@@ -14,10 +14,12 @@
 #include "utils/log.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
 #include "sqlitedataset.h"
 #include "DatabaseManager.h"
 #include "DbUrl.h"
 #include "ServiceBroker.h"
+#include "threads/SystemClock.h"
 
 #if defined(HAS_MYSQL) || defined(HAS_MARIADB)
 #include "mysqldataset.h"
@@ -30,6 +32,7 @@
 using namespace dbiplus;
 
 #define MAX_COMPRESS_COUNT 20
+#define MAX_BATCH_DURATION 2000 // ms a batch transaction is kept open at most
 
 void CDatabase::Filter::AppendField(const std::string &strField)
 {
@@ -221,6 +224,12 @@ CDatabase::CDatabase() :
   m_sqlite = true;
   m_bMultiWrite = false;
   m_multipleExecute = false;
+  m_readOnly = false;
+  m_batchSize = 0;
+  m_batchCount = 0;
+  m_batchDepth = 0;
+  m_batchStart = 0;
+  m_batchOpen = false;
 }
 
 CDatabase::~CDatabase(void)
@@ -278,6 +287,26 @@ std::string CDatabase::GetSingleValue(const std::string &query, std::unique_ptr<
   return ret;
 }
 
+std::string CDatabase::GetSingleValue(const std::string &query, const std::vector<field_value> &params)
+{
+  std::string ret;
+  try
+  {
+    if (!m_pDB.get() || !m_pDS.get())
+      return ret;
+
+    if (m_pDS->query(query, params) && m_pDS->num_rows() > 0)
+      ret = m_pDS->fv(0).get_asString();
+
+    m_pDS->close();
+  }
+  catch(...)
+  {
+    CLog::Log(LOGERROR, "%s - failed on query '%s'", __FUNCTION__, query.c_str());
+  }
+  return ret;
+}
+
 std::string CDatabase::GetSingleValue(const std::string &strTable, const std::string &strColumn, const std::string &strWhereClause /* = std::string() */, const std::string &strOrderBy /* = std::string() */)
 {
   std::string query = PrepareSQL("SELECT %s FROM %s", strColumn.c_str(), strTable.c_str());
@@ -350,6 +379,33 @@ bool CDatabase::ExecuteQuery(const std::string &strQuery)
   return bReturn;
 }
 
+bool CDatabase::ExecuteQuery(const std::string &strQuery, const std::vector<field_value> &params)
+{
+  bool bReturn = false;
+
+  try
+  {
+    if (NULL == m_pDB.get()) return bReturn;
+    if (NULL == m_pDS.get()) return bReturn;
+
+    if (m_multipleExecute)
+    {
+      m_multipleQueries.push_back(m_pDB->bind_params(strQuery, params));
+      return true;
+    }
+
+    m_pDS->exec(strQuery, params);
+    bReturn = true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to execute query '%s'",
+        __FUNCTION__, strQuery.c_str());
+  }
+
+  return bReturn;
+}
+
 bool CDatabase::ResultQuery(const std::string &strQuery)
 {
   bool bReturn = false;
@@ -372,6 +428,26 @@ bool CDatabase::ResultQuery(const std::string &strQuery)
   return bReturn;
 }
 
+bool CDatabase::ResultQuery(const std::string &strQuery, const std::vector<field_value> &params)
+{
+  bool bReturn = false;
+
+  try
+  {
+    if (NULL == m_pDB.get()) return bReturn;
+    if (NULL == m_pDS.get()) return bReturn;
+
+    bReturn = m_pDS->query(strQuery, params);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to execute query '%s'",
+        __FUNCTION__, strQuery.c_str());
+  }
+
+  return bReturn;
+}
+
 bool CDatabase::QueueInsertQuery(const std::string &strQuery)
 {
   if (strQuery.empty())
@@ -437,7 +513,35 @@ bool CDatabase::Open(const DatabaseSettings &settings)
 
   std::string dbName = dbSettings.name;
   dbName += StringUtils::Format("%d", GetSchemaVersion());
-  return Connect(dbName, dbSettings, false);
+
+  unsigned int time = XbmcThreads::SystemClockMillis();
+  CDatabaseManager &databaseManager = CServiceBroker::GetDatabaseManager();
+  if (m_sqlite && CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databasePoolSize > 0)
+  {
+    std::string key = URIUtils::AddFileToFolder(dbSettings.host, dbName);
+    if (m_readOnly)
+      key += "|readonly";
+
+    m_pDB = databaseManager.AcquireConnection(key);
+    if (m_pDB)
+    {
+      m_pDS.reset(m_pDB->CreateDataset());
+      m_pDS2.reset(m_pDB->CreateDataset());
+      m_openCount = 1;
+      m_poolKey = key;
+      databaseManager.AddConnectionWait(true, XbmcThreads::SystemClockMillis() - time);
+      return true;
+    }
+
+    if (!Connect(dbName, dbSettings, false))
+      return false;
+    m_poolKey = key;
+  }
+  else if (!Connect(dbName, dbSettings, false))
+    return false;
+
+  databaseManager.AddConnectionWait(false, XbmcThreads::SystemClockMillis() - time);
+  return true;
 }
 
 void CDatabase::InitSettings(DatabaseSettings &dbSettings)
@@ -522,6 +626,9 @@ bool CDatabase::Connect(const std::string &dbName, const DatabaseSettings &dbSet
                    dbSettings.ciphers.c_str(),
                    dbSettings.compression);
 
+  if (m_readOnly && dbSettings.type == "sqlite3")
+    static_cast<SqliteDatabase*>(m_pDB.get())->setReadOnly(true);
+
   // create the datasets
   m_pDS.reset(m_pDB->CreateDataset());
   m_pDS2.reset(m_pDB->CreateDataset());
@@ -555,6 +662,22 @@ bool CDatabase::Connect(const std::string &dbName, const DatabaseSettings &dbSet
       m_pDS->exec("PRAGMA cache_size=4096\n");
       m_pDS->exec("PRAGMA synchronous='NORMAL'\n");
       m_pDS->exec("PRAGMA count_changes='OFF'\n");
+
+      // write-ahead logging lets readers on other connections proceed while
+      // a scanner is writing. The journal mode is stored in the database
+      // file, a failure to switch it is not fatal.
+      if (!m_readOnly)
+      {
+        const bool wal = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseWalMode;
+        try
+        {
+          m_pDS->exec(wal ? "PRAGMA journal_mode=WAL\n" : "PRAGMA journal_mode=DELETE\n");
+        }
+        catch (DbErrors &error)
+        {
+          CLog::Log(LOGWARNING, "%s - unable to set journal mode: %s", __FUNCTION__, error.getMsg());
+        }
+      }
     }
   }
   catch (DbErrors &error)
@@ -598,10 +721,50 @@ void CDatabase::Close()
 
   if (NULL == m_pDB.get() ) return ;
   if (NULL != m_pDS.get()) m_pDS->close();
-  m_pDB->disconnect();
-  m_pDB.reset();
+  EndBatch();
+
+  // hand the connection back to the pool if it's still around
+  const bool reuse = !m_poolKey.empty() && NULL != m_pDS.get() &&
+                     CServiceBroker::IsServiceManagerUp() && ResetConnection();
   m_pDS.reset();
   m_pDS2.reset();
+  if (reuse)
+    CServiceBroker::GetDatabaseManager().ReleaseConnection(m_poolKey, std::move(m_pDB));
+  else
+  {
+    m_pDB->disconnect();
+    m_pDB.reset();
+  }
+  m_poolKey.clear();
+}
+
+bool CDatabase::ResetConnection()
+{
+  if (m_pDB->in_transaction())
+    return false;
+
+  try
+  {
+    // temporary tables left behind by an aborted query would clash with the
+    // next user of the connection
+    std::vector<std::string> tables;
+    m_pDS->query("SELECT name FROM sqlite_temp_master WHERE type='table'");
+    while (!m_pDS->eof())
+    {
+      tables.push_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    for (const auto &table : tables)
+      m_pDS->exec(PrepareSQL("DROP TABLE temp.%s", table.c_str()));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - unable to reset connection", __FUNCTION__);
+    return false;
+  }
+  return true;
 }
 
 bool CDatabase::Compress(bool bForce /* =true */)
@@ -649,7 +812,26 @@ void CDatabase::BeginTransaction()
 {
   try
   {
-    if (NULL != m_pDB.get())
+    if (NULL == m_pDB.get())
+      return;
+
+    if (m_batchSize > 0)
+    {
+      // the time between items counts too, e.g. for slow directory listings
+      if (m_batchOpen && m_batchDepth == 0 &&
+          XbmcThreads::SystemClockMillis() - m_batchStart >= MAX_BATCH_DURATION)
+        FlushBatch();
+
+      if (!m_batchOpen)
+      {
+        m_pDB->start_transaction();
+        m_batchOpen = true;
+        m_batchStart = XbmcThreads::SystemClockMillis();
+      }
+      m_pDS->exec("SAVEPOINT batchitem\n");
+      m_batchDepth++;
+    }
+    else
       m_pDB->start_transaction();
   }
   catch (...)
@@ -662,7 +844,22 @@ bool CDatabase::CommitTransaction()
 {
   try
   {
-    if (NULL != m_pDB.get())
+    if (NULL == m_pDB.get())
+      return true;
+
+    if (m_batchSize > 0)
+    {
+      if (m_batchDepth > 0)
+      {
+        m_pDS->exec("RELEASE batchitem\n");
+        m_batchDepth--;
+        m_batchCount++;
+      }
+      if (m_batchCount >= m_batchSize ||
+          XbmcThreads::SystemClockMillis() - m_batchStart >= MAX_BATCH_DURATION)
+        return FlushBatch();
+    }
+    else
       m_pDB->commit_transaction();
   }
   catch (...)
@@ -677,7 +874,22 @@ void CDatabase::RollbackTransaction()
 {
   try
   {
-    if (NULL != m_pDB.get())
+    if (NULL == m_pDB.get())
+      return;
+
+    if (m_batchSize > 0)
+    {
+      // only discard the changes of the current item, earlier items of the
+      // batch are kept
+      if (m_batchDepth > 0)
+      {
+        m_pDS->exec("ROLLBACK TO batchitem\n");
+        m_pDS->exec("RELEASE batchitem\n");
+        m_batchDepth--;
+      }
+      EmptyBatchCache();
+    }
+    else
       m_pDB->rollback_transaction();
   }
   catch (...)
@@ -686,6 +898,73 @@ void CDatabase::RollbackTransaction()
   }
 }
 
+bool CDatabase::BeginBatch()
+{
+  const unsigned int batchSize = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_databaseBatchSize;
+  if (!m_sqlite || batchSize == 0 || NULL == m_pDB.get() || m_batchSize > 0 || m_pDB->in_transaction())
+    return false;
+
+  m_batchSize = batchSize;
+  m_batchCount = 0;
+  m_batchDepth = 0;
+  m_batchOpen = false;
+  return true;
+}
+
+bool CDatabase::EndBatch()
+{
+  if (m_batchSize == 0)
+    return true;
+
+  if (m_batchDepth > 0)
+  {
+    CLog::Log(LOGWARNING, "%s - %u transactions still open, committing them", __FUNCTION__, m_batchDepth);
+    m_batchDepth = 0;
+  }
+
+  bool ret = FlushBatch();
+  m_batchSize = 0;
+  EmptyBatchCache();
+  return ret;
+}
+
+bool CDatabase::FlushBatch()
+{
+  // savepoints can't be released by committing the outer transaction
+  if (m_batchSize == 0 || !m_batchOpen || m_batchDepth > 0)
+    return true;
+
+  try
+  {
+    m_pDB->commit_transaction();
+    if (!m_pDB->in_transaction())
+    {
+      m_batchOpen = false;
+      m_batchCount = 0;
+      return true;
+    }
+  }
+  catch (...)
+  {
+  }
+
+  // don't let later items pile up on a transaction which can't be committed,
+  // the ids cached for the batch may refer to rows which are gone now
+  CLog::Log(LOGERROR, "%s - committing batch failed, discarding %u items", __FUNCTION__, m_batchCount);
+  try
+  {
+    m_pDB->rollback_transaction();
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - rolling back batch failed", __FUNCTION__);
+  }
+  m_batchOpen = false;
+  m_batchCount = 0;
+  EmptyBatchCache();
+  return false;
+}
+
 bool CDatabase::InTransaction()
 {
   if (NULL != m_pDB.get()) return false;
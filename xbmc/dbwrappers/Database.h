@@ -11,6 +11,7 @@
 namespace dbiplus {
   class Database;
   class Dataset;
+  class field_value;
 }
 
 #include <memory>
@@ -101,10 +102,42 @@ public:
 
   bool Open(const DatabaseSettings &db);
 
+  /*! \brief Use a read-only connection for this database.
+   Must be called before Open(). Queries modifying the database fail, in
+   return reads are never blocked by writers on other connections.
+   \param readOnly whether to open the database read-only.
+   */
+  void SetReadOnly(bool readOnly) { m_readOnly = readOnly; }
+
   void BeginTransaction();
   virtual bool CommitTransaction();
   void RollbackTransaction();
   bool InTransaction();
+
+  /*! \brief Start grouping transactions into larger ones for bulk writes.
+   Until EndBatch() each BeginTransaction()/CommitTransaction() pair becomes a
+   savepoint inside one outer transaction, so a RollbackTransaction() still
+   only discards its own changes. The outer transaction is committed after a
+   number of items, or when it has been open for a while.
+   Only supported for sqlite.
+   \return true if batching was started, false otherwise.
+   \sa EndBatch, FlushBatch
+   */
+  bool BeginBatch();
+
+  /*! \brief Commit any batched changes and return to one transaction per item.
+   \return true if the changes were committed, false otherwise.
+   */
+  bool EndBatch();
+
+  /*! \brief Commit the batched changes so far.
+   Call before slow operations, e.g. network access, so that other writers
+   are not kept waiting on the batch.
+   \return true if the changes were committed, false otherwise.
+   */
+  bool FlushBatch();
+
+  bool IsBatching() const { return m_batchSize > 0; }
   void CopyDB(const std::string& latestDb);
   void DropAnalytics();
 
@@ -129,6 +162,14 @@ public:
    */
   std::string GetSingleValue(const std::string &query, std::unique_ptr<dbiplus::Dataset> &ds);
 
+  /*! \brief Get a single value from a parameterized query.
+   \param query the query in question, with '?' placeholders for params.
+   \param params the values to bind to the placeholders.
+   \return the value from the query, empty on failure.
+   \sa ResultQuery
+   */
+  std::string GetSingleValue(const std::string &query, const std::vector<dbiplus::field_value> &params);
+
   /*!
    * @brief Delete values from a table.
    * @param strTable The table to delete the values from.
@@ -147,6 +188,18 @@ public:
    */
   bool ExecuteQuery(const std::string &strQuery);
 
+  /*!
+   * @brief Execute a parameterized query that does not return any result.
+   *        The statement is prepared once and kept in the connection's
+   *        statement cache, params are bound rather than formatted into it.
+   *        If BeginMultipleExecute() has been called, the params are
+   *        formatted into the query and it is queued as usual.
+   * @param strQuery The query to execute, with '?' placeholders for params.
+   * @param params The values to bind to the placeholders.
+   * @return True if the query was executed successfully, false otherwise.
+   */
+  bool ExecuteQuery(const std::string &strQuery, const std::vector<dbiplus::field_value> &params);
+
   /*!
    * @brief Execute a query that returns a result.
    * @remarks Call m_pDS->close(); to clean up the dataset when done.
@@ -155,6 +208,16 @@ public:
    */
   bool ResultQuery(const std::string &strQuery);
 
+  /*!
+   * @brief Execute a parameterized query that returns a result, using a
+   *        cached prepared statement.
+   * @remarks Call m_pDS->close(); to clean up the dataset when done.
+   * @param strQuery The query to execute, with '?' placeholders for params.
+   * @param params The values to bind to the placeholders.
+   * @return True if the query was executed successfully, false otherwise.
+   */
+  bool ResultQuery(const std::string &strQuery, const std::vector<dbiplus::field_value> &params);
+
   /*!
    * @brief Start a multiple execution queue. Any ExecuteQuery() function
    *        following this call will be queued rather than executed until
@@ -231,6 +294,11 @@ protected:
   virtual int GetSchemaVersion() const=0;
   virtual const char *GetBaseDBName() const=0;
 
+  /* \brief Drop ids of lookup entities cached while batching.
+   Called when a batch ends or part of it is rolled back.
+   */
+  virtual void EmptyBatchCache() {};
+
   int GetDBVersion();
 
   bool BuildSQL(const std::string &strQuery, const Filter &filter, std::string &strSQL);
@@ -249,9 +317,23 @@ private:
   void InitSettings(DatabaseSettings &dbSettings);
   void UpdateVersionNumber();
 
+  /*! \brief Reset session state of the connection so it can be reused.
+   \return true if the connection can be handed back to the pool.
+   */
+  bool ResetConnection();
+
   bool m_bMultiWrite; /*!< True if there are any queries in the queue, false otherwise */
   unsigned int m_openCount;
 
   bool m_multipleExecute;
   std::vector<std::string> m_multipleQueries;
+
+  bool m_readOnly;
+  std::string m_poolKey; ///< key of the connection pool m_pDB is returned to on Close()
+
+  unsigned int m_batchSize; ///< items per batch transaction, 0 when not batching
+  unsigned int m_batchCount; ///< items in the current batch transaction
+  unsigned int m_batchDepth; ///< open savepoints
+  unsigned int m_batchStart; ///< time the current batch transaction was started
+  bool m_batchOpen; ///< whether the outer batch transaction has been started
 };
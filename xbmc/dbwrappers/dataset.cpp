@@ -12,8 +12,10 @@
 
 #include "dataset.h"
 #include "utils/log.h"
-#include <cstring>
+#include "utils/StringUtils.h"
 #include <algorithm>
+#include <cinttypes>
+#include <cstring>
 
 #ifndef __GNUC__
 #pragma warning (disable:4800)
@@ -66,6 +68,59 @@ std::string Database::prepare(const char *format, ...)
   return result;
 }
 
+std::string Database::bind_params(const std::string &sql, const std::vector<field_value> &params)
+{
+  std::string result;
+  result.reserve(sql.size());
+  size_t param = 0;
+  char quote = 0;
+  for (char c : sql)
+  {
+    if (quote)
+    {
+      if (c == quote)
+        quote = 0;
+    }
+    else if (c == '\'' || c == '"')
+      quote = c;
+    else if (c == '?')
+    {
+      if (param >= params.size())
+        throw DbErrors("Not enough parameters for query: %s", sql.c_str());
+
+      const field_value &value = params[param++];
+      if (value.get_isNull())
+        result += "NULL";
+      else
+      {
+        switch (value.get_fType())
+        {
+          case ft_String:
+          case ft_Char:
+          case ft_WChar:
+          case ft_WideString:
+            result += prepare("'%s'", value.get_asString().c_str());
+            break;
+          case ft_Float:
+          case ft_Double:
+          case ft_LongDouble:
+            result += StringUtils::Format("%.17g", value.get_asDouble());
+            break;
+          default:
+            result += StringUtils::Format("%" PRId64, value.get_asInt64());
+            break;
+        }
+      }
+      continue;
+    }
+    result += c;
+  }
+  if (param != params.size())
+    throw DbErrors("Too many parameters for query: %s", sql.c_str());
+
+  return result;
+}
+
 //************* Dataset implementation ***************
 
 Dataset::Dataset():
@@ -186,6 +241,32 @@ void Dataset::parse_sql(std::string &sql) {
 }
 
 
+bool Dataset::query(const std::string &sql, const std::vector<field_value> &params) {
+  return query(db->bind_params(sql, params));
+}
+
+int Dataset::exec(const std::string &sql, const std::vector<field_value> &params) {
+  return exec(db->bind_params(sql, params));
+}
+
+bool Dataset::stream_query(const std::string &sql) {
+  stream_pos = -1;
+  return query(sql);
+}
+
+bool Dataset::stream_next() {
+  if (stream_pos + 1 >= static_cast<int>(result.records.size()))
+    return false;
+  stream_pos++;
+  return true;
+}
+
+const sql_record* Dataset::stream_record() {
+  if (stream_pos < 0 || stream_pos >= static_cast<int>(result.records.size()))
+    return NULL;
+  return result.records[stream_pos];
+}
+
 void Dataset::close(void) {
   haveError  = false;
   frecno = 0;
@@ -195,6 +276,7 @@ void Dataset::close(void) {
   fieldIndexMap_Entries.clear();
   fieldIndexMap_Sorter.clear();
   fieldIndexMapID = ~0;
+  stream_pos = -1;
 }
 
 
@@ -147,6 +147,14 @@ public:
    */
   virtual std::string vprepare(const char *format, va_list args) = 0;
 
+  /*! \brief Substitute '?' placeholders in a SQL statement with escaped values.
+   Used by backends without native parameter binding.
+   \param sql - SQL statement with '?' placeholders outside of quoted literals.
+   \param params - values for the placeholders in order, null values become NULL.
+   \return formatted string.
+   */
+  std::string bind_params(const std::string &sql, const std::vector<field_value> &params);
+
   virtual bool in_transaction() {return false;};
 
 };
@@ -190,6 +198,7 @@ protected:
   bool active;			// Is Query Opened?
   bool haveError;
   int frecno; 			// number of current row bei bewegung
+  int stream_pos = -1;		// current row of a streamed query
   std::string sql;
 
   ParamList plist;              // Paramlist for locate
@@ -292,6 +301,17 @@ public:
   virtual const void* getExecRes()=0;
 /* as open, but with our query exec Sql */
   virtual bool query(const std::string &sql) = 0;
+/* as query and exec, with '?' placeholders in sql bound to params */
+  virtual bool query(const std::string &sql, const std::vector<field_value> &params);
+  virtual int  exec (const std::string &sql, const std::vector<field_value> &params);
+/* Streaming access to a select: rows are read one at a time with
+   stream_next() and are not kept in the result set, so navigation and
+   num_rows() are not available. The record returned by stream_record()
+   is only valid until the next call to stream_next() or close().
+   The default implementation runs a normal query. */
+  virtual bool stream_query(const std::string &sql);
+  virtual bool stream_next();
+  virtual const sql_record* stream_record();
 /* Close SQL Query*/
   virtual void close();
 /* This function looks for field Field_name with value equal Field_value
@@ -199,12 +199,49 @@ static int busy_callback(void*, int busyCount)
   return 1;
 }
 
+// number of prepared statements kept per connection
+static const size_t STATEMENT_CACHE_SIZE = 64;
+
+// collapse whitespace outside of quoted literals, so formatting differences
+// between otherwise identical statements share a cache entry
+static std::string normalize_sql(const std::string &sql)
+{
+  std::string result;
+  result.reserve(sql.size());
+  char quote = 0;
+  bool space = false;
+  for (char c : sql)
+  {
+    if (!quote && isspace(static_cast<unsigned char>(c)))
+    {
+      space = true;
+      continue;
+    }
+    if (space && !result.empty())
+      result += ' ';
+    space = false;
+
+    if (quote)
+    {
+      if (c == quote)
+        quote = 0;
+    }
+    else if (c == '\'' || c == '"')
+      quote = c;
+    result += c;
+  }
+  return result;
+}
+
 //************* SqliteDatabase implementation ***************
 
 SqliteDatabase::SqliteDatabase() {
 
   active = false;
   _in_transaction = false;    // for transaction
+  read_only = false;
+  stmt_cache_hits = 0;
+  stmt_cache_misses = 0;
 
   error = "Unknown database error";//S_NO_CONNECTION;
   host = "localhost";
@@ -293,8 +330,8 @@ int SqliteDatabase::connect(bool create) {
   try
   {
     disconnect();
-    int flags = SQLITE_OPEN_READWRITE;
-    if (create)
+    int flags = read_only ? SQLITE_OPEN_READONLY : SQLITE_OPEN_READWRITE;
+    if (create && !read_only)
       flags |= SQLITE_OPEN_CREATE;
     int errorCode = sqlite3_open_v2(db_fullpath.c_str(), &conn, flags, NULL);
     if (create && errorCode == SQLITE_CANTOPEN)
@@ -311,7 +348,7 @@ int SqliteDatabase::connect(bool create) {
       {
         throw DbErrors("%s", getErrorMsg());
       }
-      else if (sqlite3_db_readonly(conn, nullptr) == 1)
+      else if (!read_only && sqlite3_db_readonly(conn, nullptr) == 1)
       {
         CLog::Log(LOGFATAL, "SqliteDatabase: %s is read only", db_fullpath.c_str());
         throw std::runtime_error("SqliteDatabase: " + db_fullpath + " is read only");
@@ -348,10 +385,60 @@ bool SqliteDatabase::exists(void)
 
 void SqliteDatabase::disconnect(void) {
   if (active == false) return;
+  clear_statement_cache();
   sqlite3_close(conn);
   active = false;
 }
 
+sqlite3_stmt *SqliteDatabase::get_cached_statement(const std::string &sql) {
+  if (!active) throw DbErrors("No Database Connection");
+
+  std::string key = normalize_sql(sql);
+  auto it = stmt_cache.find(key);
+  if (it != stmt_cache.end())
+  {
+    stmt_cache_hits++;
+    stmt_lru.splice(stmt_lru.end(), stmt_lru, it->second.lru);
+    sqlite3_reset(it->second.stmt);
+    sqlite3_clear_bindings(it->second.stmt);
+    return it->second.stmt;
+  }
+
+  stmt_cache_misses++;
+  sqlite3_stmt *stmt = NULL;
+  const char *tail = NULL;
+  if (setErr(sqlite3_prepare_v2(conn, key.c_str(), -1, &stmt, &tail), key.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", getErrorMsg());
+  if (!stmt || (tail && *tail))
+  {
+    sqlite3_finalize(stmt);
+    throw DbErrors("Exactly one statement is allowed in a prepared query: %s", key.c_str());
+  }
+
+  if (stmt_cache.size() >= STATEMENT_CACHE_SIZE)
+  {
+    auto oldest = stmt_cache.find(stmt_lru.front());
+    sqlite3_finalize(oldest->second.stmt);
+    stmt_cache.erase(oldest);
+    stmt_lru.pop_front();
+  }
+  stmt_cache[key] = { stmt, stmt_lru.insert(stmt_lru.end(), key) };
+  return stmt;
+}
+
+void SqliteDatabase::clear_statement_cache() {
+  if (!stmt_cache.empty())
+    CLog::Log(LOGDEBUG, "SqliteDatabase: %s statement cache %u hits, %u misses", db.c_str(),
+              stmt_cache_hits, stmt_cache_misses);
+
+  for (auto &entry : stmt_cache)
+    sqlite3_finalize(entry.second.stmt);
+  stmt_cache.clear();
+  stmt_lru.clear();
+  stmt_cache_hits = 0;
+  stmt_cache_misses = 0;
+}
+
 int SqliteDatabase::create() {
   return connect(true);
 }
@@ -490,8 +577,9 @@ void SqliteDatabase::start_transaction() {
 
 void SqliteDatabase::commit_transaction() {
   if (active) {
-    sqlite3_exec(conn,"commit",NULL,NULL,NULL);
-    _in_transaction = false;
+    // a failed commit (e.g. SQLITE_BUSY) leaves the transaction open
+    if (setErr(sqlite3_exec(conn,"commit",NULL,NULL,NULL),"commit") == SQLITE_OK)
+      _in_transaction = false;
   }
 }
 
@@ -576,6 +664,7 @@ SqliteDataset::SqliteDataset():Dataset() {
   db = NULL;
   errmsg = NULL;
   autorefresh = false;
+  stream_stmt = NULL;
 }
 
 
@@ -584,9 +673,11 @@ SqliteDataset::SqliteDataset(SqliteDatabase *newDb):Dataset(newDb) {
   db = newDb;
   errmsg = NULL;
   autorefresh = false;
+  stream_stmt = NULL;
 }
 
  SqliteDataset::~SqliteDataset(){
+   if (stream_stmt) sqlite3_finalize(stream_stmt);
    if (errmsg) sqlite3_free(errmsg);
  }
 
@@ -606,6 +697,93 @@ sqlite3* SqliteDataset::handle(){
   else return NULL;
 }
 
+void SqliteDataset::bind_params(sqlite3_stmt *stmt, const std::vector<field_value> &params, const std::string &sql) {
+  if (sqlite3_bind_parameter_count(stmt) != static_cast<int>(params.size()))
+    throw DbErrors("Expected %d parameters, got %d for query: %s",
+                   sqlite3_bind_parameter_count(stmt), static_cast<int>(params.size()), sql.c_str());
+
+  for (size_t i = 0; i < params.size(); i++)
+  {
+    const field_value &v = params[i];
+    const int index = static_cast<int>(i) + 1;
+    int rc;
+    if (v.get_isNull())
+      rc = sqlite3_bind_null(stmt, index);
+    else
+    {
+      switch (v.get_fType())
+      {
+      case ft_String:
+      case ft_Char:
+      case ft_WChar:
+      case ft_WideString:
+      {
+        const std::string str = v.get_asString();
+        rc = sqlite3_bind_text(stmt, index, str.c_str(), static_cast<int>(str.size()), SQLITE_TRANSIENT);
+        break;
+      }
+      case ft_Float:
+      case ft_Double:
+      case ft_LongDouble:
+        rc = sqlite3_bind_double(stmt, index, v.get_asDouble());
+        break;
+      default:
+        rc = sqlite3_bind_int64(stmt, index, v.get_asInt64());
+        break;
+      }
+    }
+    if (db->setErr(rc, sql.c_str()) != SQLITE_OK)
+      throw DbErrors("%s", db->getErrorMsg());
+  }
+}
+
+int SqliteDataset::fetch_rows(sqlite3_stmt *stmt) {
+  // column headers
+  const unsigned int numColumns = sqlite3_column_count(stmt);
+  result.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    result.record_header[i].name = sqlite3_column_name(stmt, i);
+
+  // returned rows
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+  { // have a row of data
+    sql_record *res = new sql_record(numColumns);
+    fetch_row(stmt, *res);
+    result.records.push_back(res);
+  }
+  return rc;
+}
+
+void SqliteDataset::fetch_row(sqlite3_stmt *stmt, sql_record &rec) {
+  const unsigned int numColumns = rec.size();
+  for (unsigned int i = 0; i < numColumns; i++)
+  {
+    field_value &v = rec[i];
+    v.set_notNull();
+    switch (sqlite3_column_type(stmt, i))
+    {
+    case SQLITE_INTEGER:
+      v.set_asInt64(sqlite3_column_int64(stmt, i));
+      break;
+    case SQLITE_FLOAT:
+      v.set_asDouble(sqlite3_column_double(stmt, i));
+      break;
+    case SQLITE_TEXT:
+      v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      break;
+    case SQLITE_BLOB:
+      v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      break;
+    case SQLITE_NULL:
+    default:
+      v.set_asString("");
+      v.set_isNull();
+      break;
+    }
+  }
+}
+
 void SqliteDataset::make_query(StringList &_sql) {
   std::string query;
   if (db == NULL) throw DbErrors("No Database Connection");
@@ -785,43 +963,7 @@ bool SqliteDataset::query(const std::string &query) {
   if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&stmt, NULL),query.c_str()) != SQLITE_OK)
     throw DbErrors("%s", db->getErrorMsg());
 
-  // column headers
-  const unsigned int numColumns = sqlite3_column_count(stmt);
-  result.record_header.resize(numColumns);
-  for (unsigned int i = 0; i < numColumns; i++)
-    result.record_header[i].name = sqlite3_column_name(stmt, i);
-
-  // returned rows
-  while (sqlite3_step(stmt) == SQLITE_ROW)
-  { // have a row of data
-    sql_record *res = new sql_record;
-    res->resize(numColumns);
-    for (unsigned int i = 0; i < numColumns; i++)
-    {
-      field_value &v = res->at(i);
-      switch (sqlite3_column_type(stmt, i))
-      {
-      case SQLITE_INTEGER:
-        v.set_asInt64(sqlite3_column_int64(stmt, i));
-        break;
-      case SQLITE_FLOAT:
-        v.set_asDouble(sqlite3_column_double(stmt, i));
-        break;
-      case SQLITE_TEXT:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_BLOB:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_NULL:
-      default:
-        v.set_asString("");
-        v.set_isNull();
-        break;
-      }
-    }
-    result.records.push_back(res);
-  }
+  fetch_rows(stmt);
   if (db->setErr(sqlite3_finalize(stmt),query.c_str()) == SQLITE_OK)
   {
     active = true;
@@ -835,6 +977,90 @@ bool SqliteDataset::query(const std::string &query) {
   }
 }
 
+bool SqliteDataset::query(const std::string &sql, const std::vector<field_value> &params) {
+  if (!handle()) throw DbErrors("No Database Connection");
+
+  close();
+
+  sqlite3_stmt *stmt = static_cast<SqliteDatabase*>(db)->get_cached_statement(sql);
+  bind_params(stmt, params, sql);
+  const int rc = fetch_rows(stmt);
+  // reset returns the same error as the failed step, if any
+  sqlite3_reset(stmt);
+  if (db->setErr(rc == SQLITE_DONE ? SQLITE_OK : rc, sql.c_str()) != SQLITE_OK)
+  {
+    result.clear();
+    throw DbErrors("%s", db->getErrorMsg());
+  }
+
+  active = true;
+  ds_state = dsSelect;
+  this->first();
+  return true;
+}
+
+int SqliteDataset::exec(const std::string &sql, const std::vector<field_value> &params) {
+  if (!handle()) throw DbErrors("No Database Connection");
+  exec_res.clear();
+
+  sqlite3_stmt *stmt = static_cast<SqliteDatabase*>(db)->get_cached_statement(sql);
+  bind_params(stmt, params, sql);
+  int rc;
+  while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+    ;
+  sqlite3_reset(stmt);
+  if (db->setErr(rc == SQLITE_DONE ? SQLITE_OK : rc, sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+  return SQLITE_OK;
+}
+
+bool SqliteDataset::stream_query(const std::string &sql) {
+  if (!handle()) throw DbErrors("No Database Connection");
+
+  close();
+
+  if (db->setErr(sqlite3_prepare_v2(handle(), sql.c_str(), -1, &stream_stmt, NULL), sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+
+  // column headers, so fieldIndex() works as for a regular query
+  const unsigned int numColumns = sqlite3_column_count(stream_stmt);
+  result.record_header.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+    result.record_header[i].name = sqlite3_column_name(stream_stmt, i);
+  stream_row.resize(numColumns);
+
+  active = true;
+  ds_state = dsSelect;
+  return true;
+}
+
+bool SqliteDataset::stream_next() {
+  if (!stream_stmt)
+    return false;
+
+  const int rc = sqlite3_step(stream_stmt);
+  if (rc == SQLITE_ROW)
+  {
+    fetch_row(stream_stmt, stream_row);
+    stream_pos++;
+    return true;
+  }
+
+  // done or failed, either way the statement is no longer needed
+  const std::string qry = sqlite3_sql(stream_stmt);
+  const int err = sqlite3_finalize(stream_stmt);
+  stream_stmt = NULL;
+  if (rc != SQLITE_DONE && db->setErr(err, qry.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+  return false;
+}
+
+const sql_record* SqliteDataset::stream_record() {
+  if (!stream_stmt || stream_pos < 0)
+    return NULL;
+  return &stream_row;
+}
+
 void SqliteDataset::open(const std::string &sql) {
   set_select_sql(sql);
   open();
@@ -852,6 +1078,11 @@ void SqliteDataset::open() {
 
 void SqliteDataset::close() {
   Dataset::close();
+  if (stream_stmt)
+  {
+    sqlite3_finalize(stream_stmt);
+    stream_stmt = NULL;
+  }
   result.clear();
   edit_object->clear();
   fields_object->clear();
@@ -12,7 +12,9 @@
 
 #pragma once
 
+#include <list>
 #include <stdio.h>
+#include <unordered_map>
 #include "dataset.h"
 #include <sqlite3.h>
 
@@ -27,8 +29,19 @@ protected:
 /* connect descriptor */
   sqlite3 *conn;
   bool _in_transaction;
+  bool read_only;
   int last_err;
 
+/* prepared statements keyed by normalized sql, least recently used first */
+  struct cached_statement {
+    sqlite3_stmt *stmt;
+    std::list<std::string>::iterator lru;
+  };
+  std::unordered_map<std::string, cached_statement> stmt_cache;
+  std::list<std::string> stmt_lru;
+  unsigned int stmt_cache_hits;
+  unsigned int stmt_cache_misses;
+
 public:
 /* default constructor */
   SqliteDatabase();
@@ -48,6 +61,9 @@ public:
   void setHostName(const char *newHost) override;
 /* sets a database name */
   void setDatabase(const char *newDb) override;
+/* open the connection read only, must be set before connect() */
+  void setReadOnly(bool readOnly) { read_only = readOnly; }
+  bool isReadOnly() const { return read_only; }
 
 /* func. connects to database-server */
 
@@ -80,6 +96,11 @@ public:
 
   bool in_transaction() override {return _in_transaction;};
 
+/* returns a reset prepared statement for sql from the statement cache,
+   preparing and caching it if needed. Owned by the cache. */
+  sqlite3_stmt *get_cached_statement(const std::string &sql);
+/* finalizes all cached statements */
+  void clear_statement_cache();
 };
 
 
@@ -110,6 +131,16 @@ protected:
   void fill_fields() override;
 /* Changing field values during dataset navigation */
   virtual void free_row();  // free the memory allocated for the current row
+/* binds params to the parameters of stmt */
+  void bind_params(sqlite3_stmt *stmt, const std::vector<field_value> &params, const std::string &sql);
+/* reads column headers and all rows of stmt into the result set */
+  int fetch_rows(sqlite3_stmt *stmt);
+/* reads the current row of stmt into rec, reusing its storage */
+  static void fetch_row(sqlite3_stmt *stmt, sql_record &rec);
+
+/* statement and row buffer of a streamed query */
+  sqlite3_stmt *stream_stmt;
+  sql_record stream_row;
 
 public:
 /* constructor */
@@ -132,6 +163,13 @@ or insert() operations default = false) */
   const void* getExecRes() override;
 /* as open, but with our query exec Sql */
   bool query(const std::string &query) override;
+/* as query and exec, using a cached prepared statement with params bound */
+  bool query(const std::string &sql, const std::vector<field_value> &params) override;
+  int  exec (const std::string &sql, const std::vector<field_value> &params) override;
+/* streamed select, see Dataset::stream_query */
+  bool stream_query(const std::string &sql) override;
+  bool stream_next() override;
+  const sql_record* stream_record() override;
 /* func. closes a query */
   void close(void) override;
 /* Cancel changes, made in insert or edit states of dataset */
@@ -385,6 +385,18 @@ bool CDoubleCache::IsCachedPosition(int64_t iFilePosition)
   return m_pCache->IsCachedPosition(iFilePosition) || (m_pCacheOld && m_pCacheOld->IsCachedPosition(iFilePosition));
 }
 
+void CDoubleCache::GetHitStats(uint64_t& hits, uint64_t& misses)
+{
+  m_pCache->GetHitStats(hits, misses);
+}
+
+void CDoubleCache::SetBackBufferRatio(float ratio)
+{
+  m_pCache->SetBackBufferRatio(ratio);
+  if (m_pCacheOld)
+    m_pCacheOld->SetBackBufferRatio(ratio);
+}
+
 CCacheStrategy *CDoubleCache::CreateNew()
 {
   return new CDoubleCache(m_pCache->CreateNew());
@@ -52,6 +52,18 @@ public:
   virtual int64_t CachedDataEndPos() = 0;
   virtual bool IsCachedPosition(int64_t iFilePosition) = 0;
 
+  /*!
+   \brief Number of bytes served from data cached by an earlier session (hits)
+          and fetched from the source (misses), for persistent strategies only
+   */
+  virtual void GetHitStats(uint64_t& hits, uint64_t& misses) { hits = misses = 0; }
+
+  /*!
+   \brief Share of the cache to keep behind the read position, for strategies
+          with a fixed size only
+   */
+  virtual void SetBackBufferRatio(float ratio) {}
+
   virtual CCacheStrategy *CreateNew() = 0;
 
   CEvent m_space;
@@ -119,6 +131,9 @@ public:
   int64_t CachedDataEndPos() override;
   bool IsCachedPosition(int64_t iFilePosition) override;
 
+  void GetHitStats(uint64_t& hits, uint64_t& misses) override;
+  void SetBackBufferRatio(float ratio) override;
+
   CCacheStrategy *CreateNew() override;
 
 protected:
@@ -252,6 +252,13 @@ bool CCircularCache::IsCachedPosition(int64_t iFilePosition)
   return iFilePosition >= m_beg && iFilePosition <= m_end;
 }
 
+void CCircularCache::SetBackBufferRatio(float ratio)
+{
+  CSingleLock lock(m_sync);
+  ratio = std::max(0.0f, std::min(ratio, 1.0f));
+  m_size_back = static_cast<size_t>(m_size * ratio);
+}
+
 CCacheStrategy *CCircularCache::CreateNew()
 {
   return new CCircularCache(m_size - m_size_back, m_size_back);
@@ -35,6 +35,8 @@ public:
     int64_t CachedDataEndPos() override;
     bool IsCachedPosition(int64_t iFilePosition) override;
 
+    void SetBackBufferRatio(float ratio) override;
+
     CCacheStrategy *CreateNew() override;
 protected:
     int64_t           m_beg;       /**< index in file (not buffer) of beginning of valid data */
@@ -18,6 +18,7 @@
 #include "utils/Base64.h"
 
 #include <algorithm>
+#include <deque>
 #include <vector>
 #include <climits>
 #include <cassert>
@@ -53,6 +54,8 @@ curl_proxytype proxyType2CUrlProxyType[] = {
 #define FILLBUFFER_NO_DATA    1
 #define FILLBUFFER_FAIL       2
 
+#define PARALLEL_CHUNK_SIZE   (1024 * 1024)
+
 // curl calls this routine to debug
 extern "C" int debug_callback(CURL_HANDLE *handle, curl_infotype info, char *output, size_t size, void *data)
 {
@@ -390,6 +393,337 @@ void CCurlFile::CReadState::Disconnect()
   m_curlAliasList = NULL;
 }
 
+/*!
+ \brief Reads a file through several concurrent range requests
+
+ The file is split into chunks which are fetched in parallel on a private multi
+ handle, each on its own connection, and handed out strictly in file order. At
+ most one chunk per connection is held in memory.
+ */
+class CCurlFile::CParallelReader
+{
+public:
+  struct Chunk
+  {
+    size_t Write(const char *buffer, size_t amount);
+
+    std::unique_ptr<CReadState> state;
+    int64_t start = 0;
+    int64_t end = 0; // exclusive
+    std::vector<char> data;
+    bool active = false;
+    bool rangeError = false;
+    int retries = 0;
+  };
+
+  CParallelReader(CCurlFile& file, unsigned int connections, unsigned int chunkSize, int64_t fileSize);
+  ~CParallelReader();
+
+  void Seek(int64_t pos);
+  ssize_t Read(void* lpBuf, size_t uiBufSize);
+  int64_t GetPosition() const { return m_pos; }
+
+private:
+  bool Schedule();
+  bool StartChunk(Chunk& chunk);
+  void StopChunk(Chunk& chunk);
+  void Clear();
+  bool Perform();
+  bool Wait();
+
+  CCurlFile& m_file;
+  CURLM* m_multiHandle;
+  std::deque<std::unique_ptr<Chunk>> m_chunks; // consecutive, ordered by start
+  std::vector<std::unique_ptr<CReadState>> m_idle; // handles of consumed chunks
+  unsigned int m_connections;
+  unsigned int m_chunkSize;
+  int64_t m_fileSize;
+  int64_t m_pos = 0;
+  int64_t m_nextStart = 0;
+};
+
+/* curl calls this routine to store data of a range request */
+extern "C" size_t range_write_callback(char *buffer,
+               size_t size,
+               size_t nitems,
+               void *userp)
+{
+  if(userp == NULL) return 0;
+
+  CCurlFile::CParallelReader::Chunk *chunk = (CCurlFile::CParallelReader::Chunk *)userp;
+  return chunk->Write(buffer, size * nitems);
+}
+
+size_t CCurlFile::CParallelReader::Chunk::Write(const char *buffer, size_t amount)
+{
+  if (data.empty())
+  {
+    // a server ignoring the range would send the whole file
+    long response = 0;
+    g_curlInterface.easy_getinfo(state->m_easyHandle, CURLINFO_RESPONSE_CODE, &response);
+    if (response != 206)
+    {
+      rangeError = true;
+      return 0;
+    }
+  }
+
+  if (static_cast<int64_t>(data.size() + amount) > end - start)
+  {
+    rangeError = true;
+    return 0;
+  }
+
+  data.insert(data.end(), buffer, buffer + amount);
+  return amount;
+}
+
+CCurlFile::CParallelReader::CParallelReader(CCurlFile& file, unsigned int connections, unsigned int chunkSize, int64_t fileSize)
+  : m_file(file)
+  , m_connections(connections)
+  , m_chunkSize(chunkSize)
+  , m_fileSize(fileSize)
+{
+  m_multiHandle = g_curlInterface.multi_init();
+}
+
+CCurlFile::CParallelReader::~CParallelReader()
+{
+  Clear();
+  m_idle.clear();
+
+  if (m_multiHandle)
+    g_curlInterface.multi_cleanup(m_multiHandle);
+}
+
+void CCurlFile::CParallelReader::Seek(int64_t pos)
+{
+  // keep chunks at and behind the new position, they are still needed
+  if (!m_chunks.empty() && pos >= m_chunks.front()->start && pos < m_nextStart)
+  {
+    while (m_chunks.front()->end <= pos)
+    {
+      StopChunk(*m_chunks.front());
+      m_chunks.pop_front();
+    }
+  }
+  else
+  {
+    Clear();
+    m_nextStart = pos;
+  }
+
+  m_pos = pos;
+}
+
+ssize_t CCurlFile::CParallelReader::Read(void* lpBuf, size_t uiBufSize)
+{
+  if (m_pos >= m_fileSize)
+    return 0;
+
+  while (!m_file.m_state->m_cancelled)
+  {
+    if (!m_multiHandle || !Schedule())
+      return -1;
+
+    Chunk& chunk = *m_chunks.front();
+    const int64_t offset = m_pos - chunk.start;
+    if (static_cast<int64_t>(chunk.data.size()) > offset)
+    {
+      const size_t want = std::min<size_t>(uiBufSize, chunk.data.size() - offset);
+      memcpy(lpBuf, chunk.data.data() + offset, want);
+      m_pos += want;
+
+      if (m_pos == chunk.end)
+      {
+        StopChunk(chunk);
+        m_chunks.pop_front();
+      }
+      return want;
+    }
+
+    if (!Perform())
+      return -1;
+  }
+  return 0;
+}
+
+bool CCurlFile::CParallelReader::Schedule()
+{
+  while (m_chunks.size() < m_connections && m_nextStart < m_fileSize)
+  {
+    std::unique_ptr<Chunk> chunk(new Chunk());
+    if (!m_idle.empty())
+    {
+      chunk->state = std::move(m_idle.back());
+      m_idle.pop_back();
+    }
+    else
+    {
+      CURL url(m_file.m_url);
+      chunk->state.reset(new CReadState());
+      g_curlInterface.easy_acquire(url.GetProtocol().c_str(),
+                                   url.GetHostName().c_str(),
+                                   &chunk->state->m_easyHandle,
+                                   &chunk->state->m_multiHandle);
+    }
+
+    chunk->start = m_nextStart;
+    chunk->end = std::min(m_nextStart + m_chunkSize, m_fileSize);
+    chunk->data.reserve(chunk->end - chunk->start);
+    if (!StartChunk(*chunk))
+      return false;
+
+    m_nextStart = chunk->end;
+    m_chunks.push_back(std::move(chunk));
+  }
+  return !m_chunks.empty();
+}
+
+bool CCurlFile::CParallelReader::StartChunk(Chunk& chunk)
+{
+  CURL_HANDLE* h = chunk.state->m_easyHandle;
+
+  m_file.SetCommonOptions(chunk.state.get());
+  m_file.SetRequestHeaders(chunk.state.get());
+
+  g_curlInterface.easy_setopt(h, CURLOPT_WRITEDATA, &chunk);
+  g_curlInterface.easy_setopt(h, CURLOPT_WRITEFUNCTION, range_write_callback);
+
+  // the point is to have one tcp window per request, don't let http2 multiplex them
+  g_curlInterface.easy_setopt(h, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_1_1);
+
+  // resume behind the data we already have in case of a retry
+  const std::string range = StringUtils::Format("%" PRId64 "-%" PRId64, chunk.start + static_cast<int64_t>(chunk.data.size()), chunk.end - 1);
+  g_curlInterface.easy_setopt(h, CURLOPT_RANGE, range.c_str());
+
+  if (g_curlInterface.multi_add_handle(m_multiHandle, h) != CURLM_OK)
+  {
+    CLog::Log(LOGERROR, "CCurlFile::CParallelReader::StartChunk - Failed to request range %s", range.c_str());
+    return false;
+  }
+
+  chunk.active = true;
+  return true;
+}
+
+void CCurlFile::CParallelReader::StopChunk(Chunk& chunk)
+{
+  if (chunk.active)
+    g_curlInterface.multi_remove_handle(m_multiHandle, chunk.state->m_easyHandle);
+  chunk.active = false;
+
+  // keep the handle and its connection around for the next chunk
+  m_idle.push_back(std::move(chunk.state));
+}
+
+void CCurlFile::CParallelReader::Clear()
+{
+  for (auto& chunk : m_chunks)
+    StopChunk(*chunk);
+  m_chunks.clear();
+}
+
+bool CCurlFile::CParallelReader::Perform()
+{
+  int running = 0;
+  CURLMcode result = g_curlInterface.multi_perform(m_multiHandle, &running);
+  if (result != CURLM_OK && result != CURLM_CALL_MULTI_PERFORM)
+  {
+    CLog::Log(LOGERROR, "CCurlFile::CParallelReader::Perform - Multi perform failed with code %d, aborting", result);
+    return false;
+  }
+
+  int msgs;
+  CURLMsg* msg;
+  while ((msg = g_curlInterface.multi_info_read(m_multiHandle, &msgs)))
+  {
+    if (msg->msg != CURLMSG_DONE)
+      continue;
+
+    // msg is invalidated by removing the handle
+    CURL_HANDLE* easy = msg->easy_handle;
+    const CURLcode code = msg->data.result;
+
+    auto it = std::find_if(m_chunks.begin(), m_chunks.end(), [easy](const std::unique_ptr<Chunk>& chunk) {
+      return chunk->active && chunk->state->m_easyHandle == easy;
+    });
+    if (it == m_chunks.end())
+      continue;
+
+    Chunk& chunk = **it;
+    g_curlInterface.multi_remove_handle(m_multiHandle, easy);
+    chunk.active = false;
+
+    if (code == CURLE_OK && chunk.start + static_cast<int64_t>(chunk.data.size()) == chunk.end)
+      continue;
+
+    if (chunk.rangeError)
+    {
+      CLog::Log(LOGWARNING, "CCurlFile::CParallelReader::Perform - Server does not honour range requests");
+      return false;
+    }
+
+    if (chunk.retries >= CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_curlretries)
+    {
+      CLog::Log(LOGERROR, "CCurlFile::CParallelReader::Perform - Failed: %s(%d)", g_curlInterface.easy_strerror(code), code);
+      return false;
+    }
+
+    chunk.retries++;
+    CLog::Log(LOGWARNING, "CCurlFile::CParallelReader::Perform - Reconnect, (re)try %i", chunk.retries);
+    if (!StartChunk(chunk))
+      return false;
+  }
+
+  if (result == CURLM_CALL_MULTI_PERFORM)
+    return true;
+
+  return Wait();
+}
+
+bool CCurlFile::CParallelReader::Wait()
+{
+  fd_set fdread;
+  fd_set fdwrite;
+  fd_set fdexcep;
+  int maxfd = -1;
+  FD_ZERO(&fdread);
+  FD_ZERO(&fdwrite);
+  FD_ZERO(&fdexcep);
+
+  g_curlInterface.multi_fdset(m_multiHandle, &fdread, &fdwrite, &fdexcep, &maxfd);
+
+  long timeout = 0;
+  if (CURLM_OK != g_curlInterface.multi_timeout(m_multiHandle, &timeout) || timeout == -1 || timeout > 200)
+    timeout = 200;
+
+  if (maxfd == -1)
+  {
+    // no sockets yet (e.g. still resolving), see curl_multi_fdset()
+    Sleep(std::min<long>(timeout, 100));
+    return true;
+  }
+
+  int rc;
+  do
+  {
+    struct timeval wait = { (int)timeout / 1000, ((int)timeout % 1000) * 1000 };
+    rc = select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &wait);
+#ifdef TARGET_WINDOWS
+  } while(rc == SOCKET_ERROR && WSAGetLastError() == WSAEINTR);
+#else
+  } while(rc == SOCKET_ERROR && errno == EINTR);
+#endif
+
+  if (rc == SOCKET_ERROR)
+  {
+    CLog::Log(LOGERROR, "CCurlFile::CParallelReader::Wait - Failed with socket error");
+    return false;
+  }
+  return true;
+}
+
 
 CCurlFile::~CCurlFile()
 {
@@ -433,11 +767,19 @@ void CCurlFile::SetBufferSize(unsigned int size)
   m_bufferSize = size;
 }
 
+//Has to be called before Open()
+void CCurlFile::SetParallelRead(unsigned int connections, unsigned int chunkSize)
+{
+  m_parallelConnections = connections;
+  m_parallelChunkSize = chunkSize;
+}
+
 void CCurlFile::Close()
 {
   if (m_opened && m_forWrite && !m_inError)
       Write(NULL, 0);
 
+  m_parallel.reset();
   m_state->Disconnect();
   delete m_oldState;
   m_oldState = NULL;
@@ -520,8 +862,8 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
   if (!m_verifyPeer)
     g_curlInterface.easy_setopt(h, CURLOPT_SSL_VERIFYPEER, 0);
 
-  g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_URL, m_url.c_str());
-  g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_TRANSFERTEXT, CURL_OFF);
+  g_curlInterface.easy_setopt(h, CURLOPT_URL, m_url.c_str());
+  g_curlInterface.easy_setopt(h, CURLOPT_TRANSFERTEXT, CURL_OFF);
 
   // setup POST data if it is set (and it may be empty)
   if (m_postdataset)
@@ -1075,9 +1417,79 @@ bool CCurlFile::Open(const CURL& url)
     m_url = efurl;
   }
 
+  if (m_parallelConnections > 1)
+    StartParallelRead();
+
   return true;
 }
 
+void CCurlFile::StartParallelRead()
+{
+  if (m_parallel || !m_seekable || !m_multisession || m_postdataset || m_state->m_fileSize <= 0)
+    return;
+
+  const int64_t pos = m_state->m_filePos;
+  const int64_t size = m_state->m_fileSize;
+  const unsigned int chunkSize = m_parallelChunkSize > 0 ? m_parallelChunkSize : PARALLEL_CHUNK_SIZE;
+
+  CLog::Log(LOGDEBUG, "CCurlFile::StartParallelRead - Using %u connections of %u bytes", m_parallelConnections, chunkSize);
+
+  m_parallel.reset(new CParallelReader(*this, m_parallelConnections, chunkSize, size));
+  m_parallel->Seek(pos);
+
+  // the single connection is not needed anymore, keep position and size for the callers
+  m_state->Disconnect();
+  m_state->m_filePos = pos;
+  m_state->m_fileSize = size;
+}
+
+bool CCurlFile::StopParallelRead()
+{
+  m_parallel.reset();
+
+  CLog::Log(LOGWARNING, "CCurlFile::StopParallelRead - Falling back to a single connection at %" PRId64, m_state->m_filePos);
+
+  SetCommonOptions(m_state);
+  SetRequestHeaders(m_state);
+  m_state->m_sendRange = true;
+
+  long response = m_state->Connect(m_bufferSize);
+  if (response < 0 || response >= 400)
+  {
+    m_seekable = false;
+    return false;
+  }
+
+  SetCorrectHeaders(m_state);
+  return true;
+}
+
+bool CCurlFile::ReadString(char *szLine, int iLineLength)
+{
+  if (m_parallel && !StopParallelRead())
+    return false;
+
+  return m_state->ReadString(szLine, iLineLength);
+}
+
+ssize_t CCurlFile::Read(void* lpBuf, size_t uiBufSize)
+{
+  if (m_parallel)
+  {
+    ssize_t read = m_parallel->Read(lpBuf, uiBufSize);
+    if (read >= 0)
+    {
+      m_state->m_filePos = m_parallel->GetPosition();
+      return read;
+    }
+
+    if (!StopParallelRead())
+      return -1;
+  }
+
+  return m_state->Read(lpBuf, uiBufSize);
+}
+
 bool CCurlFile::OpenForWrite(const CURL& url, bool bOverWrite)
 {
   if(m_opened)
@@ -1311,6 +1723,13 @@ int64_t CCurlFile::Seek(int64_t iFilePosition, int iWhence)
   // We can't seek beyond EOF
   if (m_state->m_fileSize && nextPos > m_state->m_fileSize) return -1;
 
+  if (m_parallel)
+  {
+    m_parallel->Seek(nextPos);
+    m_state->m_filePos = nextPos;
+    return nextPos;
+  }
+
   if(m_state->Seek(nextPos))
     return nextPos;
 
@@ -1963,6 +2382,18 @@ int CCurlFile::IoControl(EIoControl request, void* param)
     return 0;
   }
 
+  if (request == IOCTRL_SET_CACHE)
+  {
+    // the cache thread reads sequentially ahead, spread that over several connections if configured
+    int connections = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_curlParallelConnections;
+    if (m_opened && !m_forWrite && m_parallelConnections == 0 && connections > 1)
+    {
+      m_parallelConnections = connections;
+      StartParallelRead();
+    }
+    return 0;
+  }
+
   return -1;
 }
 
@@ -11,6 +11,7 @@
 #include "IFile.h"
 #include "utils/RingBuffer.h"
 #include <map>
+#include <memory>
 #include <string>
 #include "utils/HttpHeader.h"
 
@@ -47,8 +48,8 @@ namespace XFILE
       int64_t GetLength() override;
       int Stat(const CURL& url, struct __stat64* buffer) override;
       void Close() override;
-      bool ReadString(char *szLine, int iLineLength) override { return m_state->ReadString(szLine, iLineLength); }
-      ssize_t Read(void* lpBuf, size_t uiBufSize) override { return m_state->Read(lpBuf, uiBufSize); }
+      bool ReadString(char *szLine, int iLineLength) override;
+      ssize_t Read(void* lpBuf, size_t uiBufSize) override;
       ssize_t Write(const void* lpBuf, size_t uiBufSize) override;
       const std::string GetProperty(XFILE::FileProperty type, const std::string &name = "") const override;
       const std::vector<std::string> GetPropertyValues(XFILE::FileProperty type, const std::string &name = "") const override;
@@ -80,6 +81,15 @@ namespace XFILE
       void ClearRequestHeaders();
       void SetBufferSize(unsigned int size);
 
+      /*!
+       \brief Fetch sequential reads through several concurrent range requests
+       \param connections number of concurrent requests, 0 or 1 disables it
+       \param chunkSize size of each range request, 0 for the default
+       \note Has to be called before Open(). Only used for seekable http(s)
+             sources of known size, falls back to a single connection otherwise.
+       */
+      void SetParallelRead(unsigned int connections, unsigned int chunkSize = 0);
+
       const CHttpHeader& GetHttpHeader() const { return m_state->m_httpheader; }
       std::string GetURL(void);
       std::string GetRedirectURL();
@@ -139,6 +149,8 @@ namespace XFILE
           void Disconnect();
       };
 
+      class CParallelReader;
+
     protected:
       void ParseAndCorrectUrl(CURL &url);
       void SetCommonOptions(CReadState* state, bool failOnError = true);
@@ -146,10 +158,15 @@ namespace XFILE
       void SetCorrectHeaders(CReadState* state);
       bool Service(const std::string& strURL, std::string& strHTML);
       std::string GetInfoString(int infoType);
+      void StartParallelRead();
+      bool StopParallelRead();
 
     protected:
       CReadState* m_state;
       CReadState* m_oldState;
+      std::unique_ptr<CParallelReader> m_parallel;
+      unsigned int m_parallelConnections = 0;
+      unsigned int m_parallelChunkSize = 0;
       unsigned int m_bufferSize;
       int64_t m_writeOffset = 0;
 
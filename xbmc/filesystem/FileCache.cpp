@@ -14,8 +14,10 @@
 #include "ServiceBroker.h"
 
 #include "CircularCache.h"
+#include "SegmentCache.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
+#include "utils/StringUtils.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 
@@ -24,6 +26,7 @@
 #endif
 
 #include <cassert>
+#include <cinttypes>
 #include <algorithm>
 #include <memory>
 
@@ -34,6 +37,8 @@
 using namespace XFILE;
 
 #define READ_CACHE_CHUNK_SIZE (128*1024)
+#define READ_CACHE_MIN_CHUNK_SIZE (16*1024)
+#define READ_CACHE_MAX_CHUNK_SIZE (1024*1024)
 
 class CWriteRate
 {
@@ -91,8 +96,20 @@ CFileCache::CFileCache(const unsigned int flags)
   , m_readPos(0)
   , m_writePos(0)
   , m_chunkSize(0)
+  , m_minChunkSize(0)
+  , m_maxChunkSize(0)
+  , m_readChunkSize(0)
   , m_writeRate(0)
   , m_writeRateActual(0)
+  , m_writeRateSet(false)
+  , m_linkRate(0)
+  , m_readRate(0)
+  , m_readStats(64 * 1024 * 8)
+  , m_readAhead(0)
+  , m_cacheSize(0)
+  , m_backRatio(0.25f)
+  , m_appliedBackRatio(0.25f)
+  , m_linearRead(0)
   , m_forwardCacheSize(0)
   , m_forward(0)
   , m_bFilling(false)
@@ -106,8 +123,20 @@ CFileCache::CFileCache(CCacheStrategy *pCache, bool bDeleteCache /* = true */)
   : CThread("FileCacheStrategy")
   , m_seekPossible(0)
   , m_chunkSize(0)
+  , m_minChunkSize(0)
+  , m_maxChunkSize(0)
+  , m_readChunkSize(0)
   , m_writeRate(0)
   , m_writeRateActual(0)
+  , m_writeRateSet(false)
+  , m_linkRate(0)
+  , m_readRate(0)
+  , m_readStats(64 * 1024 * 8)
+  , m_readAhead(0)
+  , m_cacheSize(0)
+  , m_backRatio(0.25f)
+  , m_appliedBackRatio(0.25f)
+  , m_linearRead(0)
   , m_forwardCacheSize(0)
   , m_forward(0)
   , m_bFilling(false)
@@ -171,11 +200,26 @@ bool CFileCache::Open(const CURL& url)
   // check if source can seek
   m_seekPossible = m_source.IoControl(IOCTRL_SEEK_POSSIBLE, NULL);
   m_chunkSize = CFile::GetChunkSize(m_source.GetChunkSize(), READ_CACHE_CHUNK_SIZE);
+  m_minChunkSize = CFile::GetChunkSize(m_source.GetChunkSize(), READ_CACHE_MIN_CHUNK_SIZE);
+  m_maxChunkSize = CFile::GetChunkSize(m_source.GetChunkSize(), READ_CACHE_MAX_CHUNK_SIZE);
   m_fileSize = m_source.GetLength();
+  m_cacheSize = 0;
 
   if (!m_pCache)
   {
-    if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheMemSize == 0)
+    const uint64_t segmentCacheSize = static_cast<uint64_t>(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheSegmentCacheSize) * 1024 * 1024;
+    struct __stat64 st;
+    bool sparse = false;
+    if (segmentCacheSize > 0 && m_seekPossible > 0 && m_fileSize > 0 && m_source.Stat(&st) == 0)
+    {
+      // Use persistent cache on disk, keyed on the source so a changed file is not reused
+      const std::string key = StringUtils::Format("%s|%" PRId64 "|%" PRId64, url.GetWithoutUserDetails().c_str(),
+                                                  m_fileSize, static_cast<int64_t>(st.st_mtime));
+      m_pCache = new CSegmentCache(key, m_fileSize, segmentCacheSize);
+      m_forwardCacheSize = 0;
+      sparse = true;
+    }
+    else if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheMemSize == 0)
     {
       // Use cache on disk
       m_pCache = new CSimpleFileCache();
@@ -205,9 +249,10 @@ bool CFileCache::Open(const CURL& url)
       }
       m_pCache = new CCircularCache(front, back);
       m_forwardCacheSize = front;
+      m_cacheSize = front + back;
     }
 
-    if (m_flags & READ_MULTI_STREAM)
+    if ((m_flags & READ_MULTI_STREAM) && !sparse)
     {
       // If READ_MULTI_STREAM flag is set: Double buffering is required
       m_pCache = new CDoubleCache(m_pCache);
@@ -226,12 +271,28 @@ bool CFileCache::Open(const CURL& url)
   m_writePos = 0;
   m_writeRate = 1024 * 1024;
   m_writeRateActual = 0;
+  m_writeRateSet = false;
+  m_linkRate = 0;
+  m_readRate = 0;
+  m_readStats.Start();
+  m_readChunkSize = m_chunkSize;
+  m_readAhead = 0;
+  m_backRatio = 0.25f;
+  m_appliedBackRatio = 0.25f;
+  m_linearRead = 0;
   m_forward = 0;
   m_bFilling = true;
   m_bLowSpeedDetected = false;
   m_seekEvent.Reset();
   m_seekEnded.Reset();
 
+  // data from an earlier session is available, let the cache thread continue behind it
+  if (m_pCache->CachedDataEndPosIfSeekTo(0) > 0)
+  {
+    m_seekPos = 0;
+    m_seekEvent.Set();
+  }
+
   CThread::Create(false);
 
   return true;
@@ -245,8 +306,8 @@ void CFileCache::Process()
     return;
   }
 
-  // create our read buffer
-  std::unique_ptr<char[]> buffer(new char[m_chunkSize]);
+  // create our read buffer, large enough for the biggest adaptive chunk
+  std::unique_ptr<char[]> buffer(new char[m_maxChunkSize]);
   if (buffer.get() == NULL)
   {
     CLog::Log(LOGERROR, "%s - failed to allocate read buffer", __FUNCTION__);
@@ -257,11 +318,17 @@ void CFileCache::Process()
   CWriteRate average;
   bool cacheReachEOF = false;
 
+  // source throughput, only counting the time spent in reads
+  int64_t linkBytes = 0;
+  unsigned linkTime = 0;
+
   while (!m_bStop)
   {
     // Update filesize
     m_fileSize = m_source.GetLength();
 
+    ApplyBackBufferRatio();
+
     // check for seek events
     if (m_seekEvent.WaitMSec(0))
     {
@@ -299,9 +366,11 @@ void CFileCache::Process()
       m_seekEnded.Set();
     }
 
+    UpdateReadAhead(m_linkRate);
+
     while (m_writeRate)
     {
-      if (m_writePos - m_readPos < m_writeRate * CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheReadFactor)
+      if (m_writePos - m_readPos < m_readAhead)
       {
         limiter.Reset(m_writePos);
         break;
@@ -318,7 +387,7 @@ void CFileCache::Process()
       }
     }
 
-    size_t maxWrite = m_pCache->GetMaxWriteSize(m_chunkSize);
+    size_t maxWrite = m_pCache->GetMaxWriteSize(m_readChunkSize);
 
     /* Only read from source if there's enough write space in the cache
      * else we may keep disposing data and seeking back on (slow) source
@@ -331,7 +400,23 @@ void CFileCache::Process()
 
     ssize_t iRead = 0;
     if (!cacheReachEOF)
+    {
+      const unsigned start = XbmcThreads::SystemClockMillis();
       iRead = m_source.Read(buffer.get(), maxWrite);
+      if (iRead > 0)
+      {
+        linkBytes += iRead;
+        linkTime += XbmcThreads::SystemClockMillis() - start;
+        if (linkTime >= 500)
+        {
+          // smooth over a few windows, a single slow read shouldn't swing the chunk size
+          const unsigned rate = static_cast<unsigned>(1000 * linkBytes / linkTime);
+          m_linkRate = m_linkRate ? (3 * static_cast<uint64_t>(m_linkRate) + rate) / 4 : rate;
+          linkBytes = 0;
+          linkTime = 0;
+        }
+      }
+    }
     if (iRead == 0)
     {
       // Check for actual EOF and retry as long as we still have data in our cache
@@ -441,6 +526,51 @@ void CFileCache::Process()
   }
 }
 
+void CFileCache::UpdateReadAhead(unsigned linkRate)
+{
+  // what the consumer needs: the rate announced by the player is a lower
+  // bound, without it only the measured consumption counts
+  unsigned consumerRate = m_readRate;
+  if (m_writeRateSet || consumerRate == 0)
+    consumerRate = std::max(consumerRate, m_writeRate);
+
+  // chunks of roughly 100ms worth of source throughput, but no more than
+  // a second of consumption to not over-fetch low bitrate streams
+  unsigned chunkSize = m_chunkSize;
+  if (linkRate > 0)
+  {
+    chunkSize = std::min(linkRate / 10, std::max(consumerRate, m_minChunkSize));
+    chunkSize = CFile::GetChunkSize(m_source.GetChunkSize(), std::max(chunkSize, m_minChunkSize));
+  }
+  m_readChunkSize = std::min(chunkSize, m_maxChunkSize);
+
+  // buffer longer when the link has little headroom over the consumer
+  float seconds = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheReadFactor;
+  if (linkRate > 0 && linkRate < 2 * static_cast<uint64_t>(consumerRate))
+    seconds *= 2;
+
+  m_readAhead = std::max(static_cast<int64_t>(consumerRate * seconds), static_cast<int64_t>(2 * m_readChunkSize));
+  if (m_forwardCacheSize > 0)
+    m_readAhead = std::min(m_readAhead, m_forwardCacheSize);
+}
+
+void CFileCache::SetBackBufferRatio(float ratio)
+{
+  // called by the reader, the cache thread picks the new ratio up
+  m_backRatio = std::max(0.1f, std::min(ratio, 0.5f));
+}
+
+void CFileCache::ApplyBackBufferRatio()
+{
+  const float ratio = m_backRatio;
+  if (ratio == m_appliedBackRatio)
+    return;
+
+  m_appliedBackRatio = ratio;
+  m_pCache->SetBackBufferRatio(ratio);
+  m_forwardCacheSize = m_cacheSize - static_cast<int64_t>(m_cacheSize * ratio);
+}
+
 void CFileCache::OnExit()
 {
   m_bStop = true;
@@ -482,6 +612,17 @@ retry:
   if (iRc > 0)
   {
     m_readPos += iRc;
+
+    m_readStats.AddSampleBytes(static_cast<unsigned int>(iRc));
+    m_readRate = static_cast<unsigned>(m_readStats.GetBitrate() / 8);
+
+    // linear playback only needs a small back buffer, give the space to read ahead
+    m_linearRead += iRc;
+    if (m_cacheSize > 0 && m_linearRead > m_cacheSize)
+    {
+      m_linearRead = 0;
+      SetBackBufferRatio(m_backRatio - 0.05f);
+    }
     return (int)iRc;
   }
 
@@ -529,6 +670,14 @@ int64_t CFileCache::Seek(int64_t iFilePosition, int iWhence)
   if (iTarget == m_readPos)
     return m_readPos;
 
+  // the consumer jumps back, keep more data behind the read position
+  if (iTarget < m_readPos && m_cacheSize > 0)
+  {
+    m_linearRead = 0;
+    SetBackBufferRatio(m_backRatio + 0.05f);
+  }
+  m_readStats.Start();
+
   if ((m_nSeekResult = m_pCache->Seek(iTarget)) != iTarget)
   {
     if (m_seekPossible == 0)
@@ -610,6 +759,12 @@ int CFileCache::IoControl(EIoControl request, void* param)
     status->maxrate = m_writeRate;
     status->currate = m_writeRateActual;
     status->lowspeed = m_bLowSpeedDetected;
+    m_pCache->GetHitStats(status->hits, status->misses);
+    status->readrate = m_readRate;
+    status->linkrate = m_linkRate;
+    status->chunksize = m_readChunkSize;
+    status->readahead = m_readAhead;
+    status->backratio = m_backRatio;
     m_bLowSpeedDetected = false; // Reset flag
     return 0;
   }
@@ -617,6 +772,7 @@ int CFileCache::IoControl(EIoControl request, void* param)
   if (request == IOCTRL_CACHE_SETRATE)
   {
     m_writeRate = *(unsigned*)param;
+    m_writeRateSet = true;
     return 0;
   }
 
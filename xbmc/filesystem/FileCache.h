@@ -13,6 +13,7 @@
 #include "threads/CriticalSection.h"
 #include "File.h"
 #include "threads/Thread.h"
+#include "utils/BitstreamStats.h"
 #include <atomic>
 
 namespace XFILE
@@ -56,6 +57,10 @@ namespace XFILE
     }
 
   private:
+    void UpdateReadAhead(unsigned linkRate);
+    void SetBackBufferRatio(float ratio);
+    void ApplyBackBufferRatio();
+
     CCacheStrategy *m_pCache;
     bool m_bDeleteCache;
     int m_seekPossible;
@@ -68,8 +73,20 @@ namespace XFILE
     int64_t m_readPos;
     int64_t m_writePos;
     unsigned m_chunkSize;
+    unsigned m_minChunkSize;
+    unsigned m_maxChunkSize;
+    unsigned m_readChunkSize;           // adaptive size of source reads
     unsigned m_writeRate;
     unsigned m_writeRateActual;
+    bool m_writeRateSet;                // rate was announced by the player
+    unsigned m_linkRate;                // source throughput while actually reading
+    std::atomic<unsigned> m_readRate;   // consumer throughput
+    BitstreamStats m_readStats;
+    int64_t m_readAhead;                // adaptive read ahead horizon
+    int64_t m_cacheSize;                // front + back of a ring buffer cache, 0 otherwise
+    std::atomic<float> m_backRatio;     // wanted back buffer share, applied by the cache thread
+    float m_appliedBackRatio;
+    int64_t m_linearRead;               // bytes consumed since the last backward seek
     int64_t m_forwardCacheSize;
     int64_t m_forward;
     bool m_bFilling;
@@ -52,6 +52,13 @@ struct SCacheStatus
   unsigned maxrate;  /**< maximum number of bytes per second cache is allowed to fill */
   unsigned currate;  /**< average read rate from source file since last position change */
   bool     lowspeed; /**< cache low speed condition detected? */
+  uint64_t hits;     /**< number of bytes served from a persistent cache instead of the source */
+  uint64_t misses;   /**< number of bytes fetched from the source into a persistent cache */
+  unsigned readrate; /**< number of bytes per second consumed by the reader */
+  unsigned linkrate; /**< number of bytes per second delivered by the source while reading */
+  unsigned chunksize; /**< current size of reads from the source */
+  uint64_t readahead; /**< number of bytes the cache tries to keep ahead of the reader */
+  float    backratio; /**< share of a ring buffer cache kept behind the reader */
 };
 
 typedef enum {
@@ -0,0 +1,623 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SegmentCache.h"
+#include "Directory.h"
+#include "File.h"
+#include "FileItem.h"
+#include "SpecialProtocol.h"
+#include "URL.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/Digest.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#if defined(TARGET_POSIX)
+#include "platform/posix/filesystem/PosixFile.h"
+#define CacheLocalFile CPosixFile
+#elif defined(TARGET_WINDOWS)
+#include "platform/win32/filesystem/Win32File.h"
+#define CacheLocalFile CWin32File
+#endif // TARGET_WINDOWS
+
+#include <algorithm>
+#include <cinttypes>
+#include <ctime>
+#include <vector>
+
+using namespace XFILE;
+using KODI::UTILITY::CDigest;
+
+namespace
+{
+const char* CACHE_ROOT = "special://temp/segmentcache/";
+const char* INDEX_FILE = "index";
+const int64_t SEGMENT_SIZE = 4 * 1024 * 1024;
+
+/* Number of open caches per entry in this process. Entries in use aren't
+ * pruned, and shared ones aren't evicted from, as the other cache may still
+ * read the segments.
+ */
+CCriticalSection s_entriesLock;
+std::map<std::string, int> s_entryUsers;
+
+std::string GetEntryName(std::string path)
+{
+  URIUtils::RemoveSlashAtEnd(path);
+  return URIUtils::GetFileName(path);
+}
+
+struct IndexInfo
+{
+  std::string path;
+  uint64_t size = 0;
+  time_t lastUsed = 0;
+};
+
+bool ReadIndexFile(const std::string& path, std::string& key, int64_t& fileSize,
+                   time_t& lastUsed, std::map<int64_t, int64_t>& ranges)
+{
+  XFILE::auto_buffer buffer;
+  if (CFile().LoadFile(path, buffer) <= 0)
+    return false;
+
+  std::vector<std::string> lines = StringUtils::Split(std::string(buffer.get(), buffer.size()), "\n");
+  if (lines.size() < 3)
+    return false;
+
+  key = lines[0];
+  fileSize = strtoll(lines[1].c_str(), nullptr, 10);
+  lastUsed = static_cast<time_t>(strtoll(lines[2].c_str(), nullptr, 10));
+
+  for (size_t i = 3; i < lines.size(); ++i)
+  {
+    int64_t start, end;
+    if (sscanf(lines[i].c_str(), "%" SCNd64 " %" SCNd64, &start, &end) == 2 &&
+        start >= 0 && end > start && end <= fileSize)
+      ranges[start] = end;
+  }
+  return true;
+}
+}
+
+CSegmentCache::CSegmentCache(const std::string& key, int64_t fileSize, uint64_t maxCacheSize)
+  : m_key(key)
+  , m_fileSize(fileSize)
+  , m_maxCacheSize(maxCacheSize)
+{
+  m_path = URIUtils::AddFileToFolder(CACHE_ROOT, CDigest::Calculate(CDigest::Type::MD5, key));
+  URIUtils::AddSlashAtEnd(m_path);
+}
+
+CSegmentCache::~CSegmentCache()
+{
+  Close();
+}
+
+int CSegmentCache::Open()
+{
+  Close();
+
+  if (!CDirectory::Exists(CACHE_ROOT) && !CDirectory::Create(CACHE_ROOT))
+  {
+    CLog::LogF(LOGERROR, "failed to create cache directory \"%s\"", CACHE_ROOT);
+    return CACHE_RC_ERROR;
+  }
+
+  {
+    CSingleLock lock(s_entriesLock);
+    s_entryUsers[GetEntryName(m_path)]++;
+    m_inUse = true;
+  }
+
+  CSingleLock lock(m_sync);
+
+  m_ranges.clear();
+  if (CDirectory::Exists(m_path))
+  {
+    if (LoadIndex())
+      CLog::LogF(LOGDEBUG, "reusing %" PRIu64 " cached bytes in %zu ranges", GetCachedSize(), m_ranges.size());
+
+    // the index is written again on Close(), until then the segments may change
+    const std::string index = URIUtils::AddFileToFolder(m_path, INDEX_FILE);
+    if (CFile::Exists(index))
+      CFile::Delete(index);
+  }
+  else if (!CDirectory::Create(m_path))
+  {
+    CLog::LogF(LOGERROR, "failed to create cache directory \"%s\"", m_path.c_str());
+    return CACHE_RC_ERROR;
+  }
+
+  m_readPos = 0;
+  m_writePos = CachedDataEndPosIfSeekTo(0);
+  m_hits = 0;
+  m_misses = 0;
+  return CACHE_RC_OK;
+}
+
+void CSegmentCache::Close()
+{
+  bool saved = false;
+  {
+    CSingleLock lock(m_sync);
+
+    m_readFile.reset();
+    m_readSegment = -1;
+    m_readEvicted = false;
+    m_writeFile.reset();
+    m_writeSegment = -1;
+
+    if (!m_ranges.empty())
+    {
+      CLog::LogF(LOGDEBUG, "%" PRIu64 " bytes served from the cache, %" PRIu64 " bytes fetched from the source",
+                 m_hits, m_misses);
+
+      if (!SaveIndex())
+        CLog::LogF(LOGWARNING, "failed to write cache index for \"%s\"", m_path.c_str());
+      m_ranges.clear();
+      saved = true;
+    }
+  }
+
+  if (m_inUse)
+  {
+    CSingleLock lock(s_entriesLock);
+    auto users = s_entryUsers.find(GetEntryName(m_path));
+    if (users != s_entryUsers.end() && --users->second <= 0)
+      s_entryUsers.erase(users);
+    m_inUse = false;
+  }
+
+  if (saved)
+    Prune(m_maxCacheSize);
+}
+
+size_t CSegmentCache::GetMaxWriteSize(const size_t& iRequestSize)
+{
+  return iRequestSize; // Can always write since it's on disk
+}
+
+int CSegmentCache::WriteToCache(const char *pBuffer, size_t iSize)
+{
+  int64_t writePos;
+  {
+    CSingleLock lock(m_sync);
+    writePos = m_writePos;
+  }
+
+  if (m_fileSize > 0)
+    iSize = static_cast<size_t>(std::min(static_cast<int64_t>(iSize), m_fileSize - writePos));
+
+  size_t written = 0;
+  while (written < iSize)
+  {
+    const int64_t pos = writePos + written;
+    const int64_t segment = pos / SEGMENT_SIZE;
+    const int64_t offset = pos % SEGMENT_SIZE;
+    const size_t chunk = static_cast<size_t>(std::min(static_cast<int64_t>(iSize - written), SEGMENT_SIZE - offset));
+
+    IFile* file = OpenSegment(m_writeFile, m_writeSegment, segment, true);
+    if (!file || file->Seek(offset, SEEK_SET) != offset)
+    {
+      CLog::LogF(LOGERROR, "failed to open segment %" PRId64 " for writing", segment);
+      return CACHE_RC_ERROR;
+    }
+
+    const ssize_t lastWritten = file->Write(pBuffer + written, chunk);
+    if (lastWritten <= 0)
+    {
+      CLog::LogF(LOGERROR, "failed to write to segment %" PRId64, segment);
+      return CACHE_RC_ERROR;
+    }
+    written += lastWritten;
+  }
+
+  {
+    CSingleLock lock(m_sync);
+    AddRange(writePos, writePos + written);
+    m_writePos = writePos + written;
+    m_misses += written;
+    EvictSegments();
+  }
+
+  // when reader waits for data it will wait on the event.
+  m_written.Set();
+
+  return static_cast<int>(written);
+}
+
+int CSegmentCache::ReadFromCache(char *pBuffer, size_t iMaxSize)
+{
+  int64_t readPos;
+  int64_t available;
+  {
+    CSingleLock lock(m_sync);
+    readPos = m_readPos;
+    auto range = FindRange(m_readPos);
+
+    // the open segment may have been deleted and written anew by the writer
+    if (m_readEvicted)
+    {
+      m_readFile.reset();
+      m_readSegment = -1;
+      m_readEvicted = false;
+    }
+    available = range != m_ranges.end() ? range->second - m_readPos : 0;
+  }
+
+  if (available <= 0)
+    return m_bEndOfInput ? 0 : CACHE_RC_WOULD_BLOCK;
+
+  const int64_t segment = readPos / SEGMENT_SIZE;
+  const int64_t offset = readPos % SEGMENT_SIZE;
+  const size_t toRead = static_cast<size_t>(std::min(std::min(static_cast<int64_t>(iMaxSize), available), SEGMENT_SIZE - offset));
+
+  IFile* file = OpenSegment(m_readFile, m_readSegment, segment, false);
+  if (!file || file->Seek(offset, SEEK_SET) != offset)
+  {
+    CLog::LogF(LOGERROR, "failed to open segment %" PRId64 " for reading", segment);
+    return CACHE_RC_ERROR;
+  }
+
+  const ssize_t lastRead = file->Read(pBuffer, toRead);
+  if (lastRead <= 0)
+  {
+    CLog::LogF(LOGERROR, "failed to read from segment %" PRId64, segment);
+    return CACHE_RC_ERROR;
+  }
+
+  {
+    CSingleLock lock(m_sync);
+    m_readPos += lastRead;
+  }
+
+  m_space.Set();
+
+  return static_cast<int>(lastRead);
+}
+
+int64_t CSegmentCache::WaitForData(unsigned int iMinAvail, unsigned int iMillis)
+{
+  XbmcThreads::EndTime endTime(iMillis);
+  while (true)
+  {
+    int64_t available = 0;
+    {
+      CSingleLock lock(m_sync);
+      auto range = FindRange(m_readPos);
+      if (range != m_ranges.end())
+        available = range->second - m_readPos;
+    }
+
+    if (iMillis == 0 || IsEndOfInput() || available >= iMinAvail)
+      return available;
+
+    if (!m_written.WaitMSec(endTime.MillisLeft()))
+      return CACHE_RC_TIMEOUT;
+  }
+}
+
+int64_t CSegmentCache::Seek(int64_t iFilePosition)
+{
+  CSingleLock lock(m_sync);
+
+  auto range = FindRange(iFilePosition);
+  if (range == m_ranges.end() && iFilePosition != m_writePos)
+    return CACHE_RC_ERROR;
+
+  // only seek within the range the writer extends, otherwise the reader would
+  // run dry at the end of the range. Request a seek event so the source gets
+  // repositioned behind the cached data instead.
+  if (range != m_ranges.end() && range->second != m_writePos)
+    return CACHE_RC_ERROR;
+
+  m_readPos = iFilePosition;
+  m_space.Set();
+
+  return iFilePosition;
+}
+
+bool CSegmentCache::Reset(int64_t iSourcePosition, bool clearAnyway)
+{
+  CSingleLock lock(m_sync);
+
+  m_readPos = iSourcePosition;
+
+  // cached data is never thrown away, just continue behind it
+  auto range = FindRange(iSourcePosition);
+  if (range != m_ranges.end())
+  {
+    m_writePos = range->second;
+    m_hits += range->second - iSourcePosition;
+    return false;
+  }
+
+  m_writePos = iSourcePosition;
+  return true;
+}
+
+void CSegmentCache::EndOfInput()
+{
+  CCacheStrategy::EndOfInput();
+  m_written.Set();
+}
+
+int64_t CSegmentCache::CachedDataEndPosIfSeekTo(int64_t iFilePosition)
+{
+  CSingleLock lock(m_sync);
+
+  auto range = FindRange(iFilePosition);
+  if (range != m_ranges.end())
+    return range->second;
+  return iFilePosition;
+}
+
+int64_t CSegmentCache::CachedDataEndPos()
+{
+  CSingleLock lock(m_sync);
+  return m_writePos;
+}
+
+bool CSegmentCache::IsCachedPosition(int64_t iFilePosition)
+{
+  CSingleLock lock(m_sync);
+  return FindRange(iFilePosition) != m_ranges.end();
+}
+
+void CSegmentCache::GetHitStats(uint64_t& hits, uint64_t& misses)
+{
+  CSingleLock lock(m_sync);
+  hits = m_hits;
+  misses = m_misses;
+}
+
+CCacheStrategy *CSegmentCache::CreateNew()
+{
+  return new CSegmentCache(m_key, m_fileSize, m_maxCacheSize);
+}
+
+CSegmentCache::RangeMap::const_iterator CSegmentCache::FindRange(int64_t iFilePosition) const
+{
+  // ranges are inclusive of their end, like the other strategies' IsCachedPosition
+  auto it = m_ranges.upper_bound(iFilePosition);
+  if (it == m_ranges.begin())
+    return m_ranges.end();
+
+  --it;
+  if (iFilePosition <= it->second)
+    return it;
+  return m_ranges.end();
+}
+
+void CSegmentCache::AddRange(int64_t start, int64_t end)
+{
+  if (end <= start)
+    return;
+
+  // merge with all ranges overlapping or touching [start, end]
+  auto it = m_ranges.upper_bound(start);
+  if (it != m_ranges.begin())
+  {
+    auto prev = std::prev(it);
+    if (prev->second >= start)
+      it = prev;
+  }
+
+  while (it != m_ranges.end() && it->first <= end)
+  {
+    start = std::min(start, it->first);
+    end = std::max(end, it->second);
+    it = m_ranges.erase(it);
+  }
+
+  m_ranges[start] = end;
+}
+
+void CSegmentCache::RemoveRange(int64_t start, int64_t end)
+{
+  RangeMap remaining;
+  for (const auto& range : m_ranges)
+  {
+    if (range.second <= start || range.first >= end)
+    {
+      remaining.insert(range);
+      continue;
+    }
+    if (range.first < start)
+      remaining[range.first] = start;
+    if (range.second > end)
+      remaining[end] = range.second;
+  }
+  m_ranges.swap(remaining);
+}
+
+uint64_t CSegmentCache::GetCachedSize() const
+{
+  uint64_t size = 0;
+  for (const auto& range : m_ranges)
+    size += range.second - range.first;
+  return size;
+}
+
+void CSegmentCache::EvictSegments()
+{
+  if (m_maxCacheSize == 0)
+    return;
+
+  {
+    CSingleLock lock(s_entriesLock);
+    auto users = s_entryUsers.find(GetEntryName(m_path));
+    if (users != s_entryUsers.end() && users->second > 1)
+      return;
+  }
+
+  // keep everything the reader may still consume, up to the write position
+  int64_t keepBegin = m_readPos / SEGMENT_SIZE;
+  int64_t keepEnd = m_writePos / SEGMENT_SIZE;
+  auto readRange = FindRange(m_readPos);
+  if (readRange != m_ranges.end())
+    keepEnd = std::max(keepEnd, readRange->second / SEGMENT_SIZE);
+  if (keepEnd < keepBegin)
+    std::swap(keepBegin, keepEnd);
+
+  while (GetCachedSize() > m_maxCacheSize)
+  {
+    // evict the segment furthest away from the reader
+    int64_t victim = -1;
+    int64_t distance = -1;
+    for (const auto& range : m_ranges)
+    {
+      for (int64_t segment : { range.first / SEGMENT_SIZE, (range.second - 1) / SEGMENT_SIZE })
+      {
+        if (segment >= keepBegin && segment <= keepEnd)
+          continue;
+        const int64_t d = segment < keepBegin ? keepBegin - segment : segment - keepEnd;
+        if (d > distance)
+        {
+          distance = d;
+          victim = segment;
+        }
+      }
+    }
+
+    if (victim < 0)
+      break;
+
+    RemoveRange(victim * SEGMENT_SIZE, (victim + 1) * SEGMENT_SIZE);
+    if (victim == m_writeSegment)
+    {
+      m_writeFile.reset();
+      m_writeSegment = -1;
+    }
+    // the reader runs without the lock held, it drops its segment itself
+    m_readEvicted = true;
+    CFile::Delete(GetSegmentPath(victim));
+  }
+}
+
+IFile* CSegmentCache::OpenSegment(std::unique_ptr<IFile>& file, int64_t& fileSegment, int64_t segment, bool write)
+{
+  if (file && fileSegment == segment)
+    return file.get();
+
+  file.reset(new CacheLocalFile());
+  fileSegment = -1;
+
+  CURL url(CSpecialProtocol::TranslatePath(GetSegmentPath(segment)));
+  if (write ? !file->OpenForWrite(url, false) : !file->Open(url))
+  {
+    file.reset();
+    return nullptr;
+  }
+
+  fileSegment = segment;
+  return file.get();
+}
+
+std::string CSegmentCache::GetSegmentPath(int64_t segment) const
+{
+  return URIUtils::AddFileToFolder(m_path, StringUtils::Format("%08" PRId64 ".seg", segment));
+}
+
+bool CSegmentCache::LoadIndex()
+{
+  std::string key;
+  int64_t fileSize;
+  time_t lastUsed;
+  RangeMap ranges;
+  if (!ReadIndexFile(URIUtils::AddFileToFolder(m_path, INDEX_FILE), key, fileSize, lastUsed, ranges))
+    return false;
+
+  // the directory name is a hash, make sure it really is our source
+  if (key != m_key || fileSize != m_fileSize)
+    return false;
+
+  m_ranges.swap(ranges);
+  return true;
+}
+
+bool CSegmentCache::SaveIndex() const
+{
+  std::string index = StringUtils::Format("%s\n%" PRId64 "\n%" PRId64 "\n", m_key.c_str(), m_fileSize,
+                                          static_cast<int64_t>(time(nullptr)));
+  for (const auto& range : m_ranges)
+    index += StringUtils::Format("%" PRId64 " %" PRId64 "\n", range.first, range.second);
+
+  CFile file;
+  if (!file.OpenForWrite(URIUtils::AddFileToFolder(m_path, INDEX_FILE), true))
+    return false;
+
+  return file.Write(index.c_str(), index.size()) == static_cast<ssize_t>(index.size());
+}
+
+void CSegmentCache::Prune(uint64_t maxCacheSize)
+{
+  if (maxCacheSize == 0)
+    return;
+
+  CFileItemList items;
+  if (!CDirectory::GetDirectory(CACHE_ROOT, items, "", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE))
+    return;
+
+  std::vector<IndexInfo> entries;
+  uint64_t total = 0;
+  for (const auto& item : items)
+  {
+    if (!item->m_bIsFolder)
+      continue;
+
+    IndexInfo info;
+    info.path = item->GetPath();
+
+    std::string key;
+    int64_t fileSize;
+    RangeMap ranges;
+    if (ReadIndexFile(URIUtils::AddFileToFolder(info.path, INDEX_FILE), key, fileSize, info.lastUsed, ranges))
+    {
+      for (const auto& range : ranges)
+        info.size += range.second - range.first;
+    }
+    else
+    {
+      // no index, the entry is open or its cache wasn't closed. Count the
+      // segments on disk, left overs are the first to go.
+      CFileItemList segments;
+      if (CDirectory::GetDirectory(info.path, segments, ".seg", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE))
+      {
+        for (const auto& segment : segments)
+          info.size += segment->m_dwSize;
+      }
+    }
+
+    total += info.size;
+    entries.push_back(info);
+  }
+
+  if (total <= maxCacheSize)
+    return;
+
+  std::sort(entries.begin(), entries.end(), [](const IndexInfo& a, const IndexInfo& b) {
+    return a.lastUsed < b.lastUsed;
+  });
+
+  for (const auto& entry : entries)
+  {
+    if (total <= maxCacheSize)
+      break;
+
+    CSingleLock lock(s_entriesLock);
+    if (s_entryUsers.find(GetEntryName(entry.path)) != s_entryUsers.end())
+      continue;
+
+    CLog::Log(LOGDEBUG, "CSegmentCache::Prune - removing %s (%" PRIu64 " bytes)", entry.path.c_str(), entry.size);
+    if (CDirectory::RemoveRecursive(entry.path))
+      total -= entry.size;
+  }
+}
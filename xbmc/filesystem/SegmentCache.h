@@ -0,0 +1,100 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "CacheStrategy.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+namespace XFILE {
+
+/*!
+ \brief Persistent, sparse on-disk cache strategy
+
+ Data is stored in fixed size segment files below a directory derived from the
+ cache key (source url, size and modification time), together with an index of
+ the byte ranges which are available. The index survives closing the file, so
+ re-opening the same source or seeking back into an already fetched region is
+ served locally. Entries are evicted least recently used first once the total
+ size of all entries exceeds the configured limit. Entries opened by another
+ cache in this process are neither evicted from nor pruned.
+ */
+class CSegmentCache : public CCacheStrategy
+{
+public:
+  CSegmentCache(const std::string& key, int64_t fileSize, uint64_t maxCacheSize);
+  ~CSegmentCache() override;
+
+  int Open() override;
+  void Close() override;
+
+  size_t GetMaxWriteSize(const size_t& iRequestSize) override;
+  int WriteToCache(const char *pBuffer, size_t iSize) override;
+  int ReadFromCache(char *pBuffer, size_t iMaxSize) override;
+  int64_t WaitForData(unsigned int iMinAvail, unsigned int iMillis) override;
+
+  int64_t Seek(int64_t iFilePosition) override;
+  bool Reset(int64_t iSourcePosition, bool clearAnyway=true) override;
+  void EndOfInput() override;
+
+  int64_t CachedDataEndPosIfSeekTo(int64_t iFilePosition) override;
+  int64_t CachedDataEndPos() override;
+  bool IsCachedPosition(int64_t iFilePosition) override;
+
+  void GetHitStats(uint64_t& hits, uint64_t& misses) override;
+
+  CCacheStrategy *CreateNew() override;
+
+  /*!
+   \brief Delete least recently used cache entries until all entries together
+          are smaller than maxCacheSize
+   */
+  static void Prune(uint64_t maxCacheSize);
+
+protected:
+  typedef std::map<int64_t, int64_t> RangeMap; // start -> end (exclusive)
+
+  RangeMap::const_iterator FindRange(int64_t iFilePosition) const;
+  void AddRange(int64_t start, int64_t end);
+  void RemoveRange(int64_t start, int64_t end);
+  uint64_t GetCachedSize() const;
+  void EvictSegments();
+
+  IFile* OpenSegment(std::unique_ptr<IFile>& file, int64_t& fileSegment, int64_t segment, bool write);
+  std::string GetSegmentPath(int64_t segment) const;
+  bool LoadIndex();
+  bool SaveIndex() const;
+
+  std::string m_key;
+  std::string m_path;
+  int64_t m_fileSize;
+  uint64_t m_maxCacheSize;
+
+  RangeMap m_ranges;
+  int64_t m_readPos = 0;
+  int64_t m_writePos = 0;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  bool m_inUse = false;       ///< whether the entry is registered as in use, see Open()
+
+  std::unique_ptr<IFile> m_readFile;
+  int64_t m_readSegment = -1;
+  bool m_readEvicted = false; ///< a segment was evicted, the reader must reopen its segment
+  std::unique_ptr<IFile> m_writeFile;
+  int64_t m_writeSegment = -1;
+
+  CCriticalSection m_sync;
+  CEvent m_written;
+};
+
+} // namespace XFILE
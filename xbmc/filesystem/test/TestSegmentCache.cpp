@@ -0,0 +1,181 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/SegmentCache.h"
+#include "utils/URIUtils.h"
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+using namespace XFILE;
+
+namespace
+{
+const int64_t FILE_SIZE = 256 * 1024;
+
+std::vector<char> MakeData(int64_t offset, size_t size)
+{
+  std::vector<char> data(size);
+  for (size_t i = 0; i < size; ++i)
+    data[i] = static_cast<char>((offset + i) * 7);
+  return data;
+}
+
+class TestSegmentCache : public ::testing::Test
+{
+protected:
+  TestSegmentCache()
+  {
+    CDirectory::RemoveRecursive("special://temp/segmentcache/");
+  }
+};
+}
+
+TEST_F(TestSegmentCache, SparseRanges)
+{
+  CSegmentCache cache("TestSegmentCache.SparseRanges", FILE_SIZE, 0);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+
+  std::vector<char> data = MakeData(0, 4096);
+  EXPECT_EQ(4096, cache.WriteToCache(data.data(), data.size()));
+  EXPECT_TRUE(cache.IsCachedPosition(0));
+  EXPECT_TRUE(cache.IsCachedPosition(4096));
+  EXPECT_FALSE(cache.IsCachedPosition(8192));
+
+  // jump ahead, the first range stays available
+  EXPECT_TRUE(cache.Reset(65536, false));
+  data = MakeData(65536, 4096);
+  EXPECT_EQ(4096, cache.WriteToCache(data.data(), data.size()));
+  EXPECT_TRUE(cache.IsCachedPosition(1000));
+  EXPECT_EQ(4096, cache.CachedDataEndPosIfSeekTo(1000));
+  EXPECT_EQ(65536 + 4096, cache.CachedDataEndPos());
+
+  // going back into the first range is not a full reset
+  EXPECT_FALSE(cache.Reset(1000, false));
+  EXPECT_EQ(4096, cache.CachedDataEndPos());
+
+  char buf[1024];
+  EXPECT_EQ(1024, cache.ReadFromCache(buf, sizeof(buf)));
+  data = MakeData(1000, sizeof(buf));
+  EXPECT_EQ(0, memcmp(data.data(), buf, sizeof(buf)));
+
+  cache.Close();
+}
+
+TEST_F(TestSegmentCache, Persistent)
+{
+  const std::string key = "TestSegmentCache.Persistent";
+  std::vector<char> data = MakeData(0, 8192);
+  {
+    CSegmentCache cache(key, FILE_SIZE, 0);
+    ASSERT_EQ(CACHE_RC_OK, cache.Open());
+    cache.Reset(0, true);
+    EXPECT_EQ(8192, cache.WriteToCache(data.data(), data.size()));
+    cache.Close();
+  }
+
+  CSegmentCache cache(key, FILE_SIZE, 0);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+  EXPECT_EQ(8192, cache.CachedDataEndPosIfSeekTo(0));
+  EXPECT_FALSE(cache.Reset(0, false));
+
+  char buf[8192];
+  EXPECT_EQ(8192, cache.ReadFromCache(buf, sizeof(buf)));
+  EXPECT_EQ(0, memcmp(data.data(), buf, sizeof(buf)));
+
+  uint64_t hits, misses;
+  cache.GetHitStats(hits, misses);
+  EXPECT_EQ(8192u, hits);
+  EXPECT_EQ(0u, misses);
+  cache.Close();
+
+  // a different size invalidates the entry
+  CSegmentCache changed(key, FILE_SIZE + 1, 0);
+  ASSERT_EQ(CACHE_RC_OK, changed.Open());
+  EXPECT_FALSE(changed.IsCachedPosition(0));
+  changed.Close();
+}
+
+TEST_F(TestSegmentCache, IndexWrittenOnClose)
+{
+  const std::string key = "TestSegmentCache.IndexWrittenOnClose";
+  std::vector<char> data = MakeData(0, 8192);
+
+  CSegmentCache cache(key, FILE_SIZE, 0);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+  EXPECT_EQ(8192, cache.WriteToCache(data.data(), data.size()));
+
+  // nothing is known about an entry which is still being written
+  CSegmentCache other(key, FILE_SIZE, 0);
+  ASSERT_EQ(CACHE_RC_OK, other.Open());
+  EXPECT_FALSE(other.IsCachedPosition(0));
+  other.Close();
+
+  cache.Close();
+
+  CSegmentCache reopened(key, FILE_SIZE, 0);
+  ASSERT_EQ(CACHE_RC_OK, reopened.Open());
+  EXPECT_EQ(8192, reopened.CachedDataEndPosIfSeekTo(0));
+  reopened.Close();
+}
+
+TEST_F(TestSegmentCache, InUseNotPruned)
+{
+  std::vector<char> data = MakeData(0, 8192);
+
+  CSegmentCache open("TestSegmentCache.InUseNotPruned.open", FILE_SIZE, 4096);
+  ASSERT_EQ(CACHE_RC_OK, open.Open());
+  EXPECT_EQ(8192, open.WriteToCache(data.data(), data.size()));
+
+  // closing another entry prunes everything above the limit, but the open one
+  CSegmentCache closed("TestSegmentCache.InUseNotPruned.closed", FILE_SIZE, 4096);
+  ASSERT_EQ(CACHE_RC_OK, closed.Open());
+  EXPECT_EQ(8192, closed.WriteToCache(data.data(), data.size()));
+  closed.Close();
+
+  char buf[8192];
+  EXPECT_EQ(8192, open.ReadFromCache(buf, sizeof(buf)));
+  EXPECT_EQ(0, memcmp(data.data(), buf, sizeof(buf)));
+  open.Close();
+}
+
+TEST_F(TestSegmentCache, EntryWithoutIndexPruned)
+{
+  std::vector<char> data = MakeData(0, 4096);
+
+  CSegmentCache orphan("TestSegmentCache.EntryWithoutIndexPruned.orphan", FILE_SIZE, 0);
+  ASSERT_EQ(CACHE_RC_OK, orphan.Open());
+  EXPECT_EQ(4096, orphan.WriteToCache(data.data(), data.size()));
+  orphan.Close();
+
+  // a cache which wasn't closed leaves its segments without an index
+  CFileItemList entries;
+  ASSERT_TRUE(CDirectory::GetDirectory("special://temp/segmentcache/", entries, "", DIR_FLAG_DEFAULTS));
+  ASSERT_EQ(1, entries.Size());
+  ASSERT_TRUE(CFile::Delete(URIUtils::AddFileToFolder(entries[0]->GetPath(), "index")));
+
+  CSegmentCache cache("TestSegmentCache.EntryWithoutIndexPruned", FILE_SIZE, 6144);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+  EXPECT_EQ(4096, cache.WriteToCache(data.data(), data.size()));
+  cache.Close();
+
+  entries.Clear();
+  ASSERT_TRUE(CDirectory::GetDirectory("special://temp/segmentcache/", entries, "", DIR_FLAG_DEFAULTS));
+  EXPECT_EQ(1, entries.Size());
+
+  CSegmentCache reopened("TestSegmentCache.EntryWithoutIndexPruned", FILE_SIZE, 0);
+  ASSERT_EQ(CACHE_RC_OK, reopened.Open());
+  EXPECT_EQ(4096, reopened.CachedDataEndPosIfSeekTo(0));
+  reopened.Close();
+}
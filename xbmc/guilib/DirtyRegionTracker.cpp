@@ -10,6 +10,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "utils/log.h"
+#include <algorithm>
 #include <stdio.h>
 #include "DirtyRegionSolvers.h"
 #include "ServiceBroker.h"
@@ -63,17 +64,44 @@ const CDirtyRegionList &CDirtyRegionTracker::GetMarkedRegions() const
 }
 
 CDirtyRegionList CDirtyRegionTracker::GetDirtyRegions()
+{
+  return Solve(std::max(m_bufferAge, 0));
+}
+
+CDirtyRegionList CDirtyRegionTracker::GetFrameDamage()
+{
+  return Solve(1);
+}
+
+CDirtyRegionList CDirtyRegionTracker::Solve(int maxAge)
 {
   CDirtyRegionList output;
+  if (!m_solver)
+    return output;
 
-  if (m_solver)
+  if (maxAge <= 0)
+  {
     m_solver->Solve(m_markedRegions, output);
+    return output;
+  }
 
+  CDirtyRegionList regions;
+  for (const auto& region : m_markedRegions)
+  {
+    if (region.GetAge() < maxAge)
+      regions.push_back(region);
+  }
+  m_solver->Solve(regions, output);
   return output;
 }
 
-void CDirtyRegionTracker::CleanMarkedRegions()
+void CDirtyRegionTracker::CleanMarkedRegions(bool presented)
 {
+  // with buffer age tracking regions age by presented frames, which is what
+  // the age of the back buffer counts
+  if (m_bufferAge >= 0 && !presented)
+    return;
+
   int buffering = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiVisualizeDirtyRegions ? 20 : m_buffering;
   int i = m_markedRegions.size() - 1;
   while (i >= 0)
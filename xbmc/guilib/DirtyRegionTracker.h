@@ -26,10 +26,28 @@ public:
 
   const CDirtyRegionList &GetMarkedRegions() const;
   CDirtyRegionList GetDirtyRegions();
-  void CleanMarkedRegions();
+  void CleanMarkedRegions(bool presented = true);
+
+  /*! \brief Set the age of the back buffer the next frame renders into
+   Once set, GetDirtyRegions() only returns the regions that changed since
+   the back buffer was last presented, rather than those of the last
+   buffering frames.
+   \param age number of frames since the back buffer was presented, 0 if
+   its contents are undefined and -1 to go back to buffering frames
+   */
+  void SetBufferAge(int age) { m_bufferAge = age; }
+
+  /*! \brief Whether the back buffer is too old for its changes to be tracked */
+  bool NeedsFullRedraw() const { return m_bufferAge == 0 || m_bufferAge > m_buffering; }
+
+  /*! \brief Regions marked since the last presented frame, i.e. what changed on screen */
+  CDirtyRegionList GetFrameDamage();
 
 private:
+  CDirtyRegionList Solve(int maxAge);
+
   CDirtyRegionList m_markedRegions;
   int m_buffering;
+  int m_bufferAge = -1;
   IDirtyRegionSolver *m_solver;
 };
@@ -154,6 +154,7 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
 
   if (m_bInvalidated)
     item->SetInvalid();
+  item->FormatDeferredLabels();
   if (focused)
   {
     if (!item->GetFocusedLayout())
@@ -575,6 +576,7 @@ void CGUIBaseContainer::OnJumpLetter(char letter, bool skip /*=false*/)
   do
   {
     CGUIListItemPtr item = m_items[i];
+    item->FormatDeferredLabels();
     std::string label = item->GetLabel();
     if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_FILELISTS_IGNORETHEWHENSORTING))
       label = SortUtils::RemoveArticles(label);
@@ -667,14 +669,13 @@ CGUIListItemPtr CGUIBaseContainer::GetListItem(int offset, unsigned int flag) co
   {
     item %= ((int)m_items.size());
     if (item < 0) item += m_items.size();
-    return m_items[item];
   }
-  else
-  {
-    if (item >= 0 && item < (int)m_items.size())
-      return m_items[item];
-  }
-  return CGUIListItemPtr();
+  else if (item < 0 || item >= (int)m_items.size())
+    return CGUIListItemPtr();
+
+  // info labels may look at items that haven't been shown yet
+  m_items[item]->FormatDeferredLabels();
+  return m_items[item];
 }
 
 CGUIListItemLayout *CGUIBaseContainer::GetFocusedLayout() const
@@ -237,6 +237,13 @@ bool CGUIControlProfiler::IsRunning(void)
 void CGUIControlProfiler::Start(void)
 {
   m_iFrameCount = 0;
+  m_boolEvaluations = 0;
+  m_drawCalls = 0;
+  m_textureBinds = 0;
+  m_textLayoutHits = 0;
+  m_textLayoutMisses = 0;
+  m_textureUploadTime = 0;
+  m_textureUploadMaxTime = 0;
   m_bIsRunning = true;
   m_pLastItem = NULL;
   m_ItemHead.Reset(this);
@@ -326,6 +333,30 @@ bool CGUIControlProfiler::SaveResults(void)
   std::string str = StringUtils::Format("%d", m_iFrameCount);
   root->SetAttribute("framecount", str.c_str());
   root->SetAttribute("timeunit", "ms");
+  if (m_iFrameCount > 0)
+  {
+    str = StringUtils::Format("%u", static_cast<unsigned int>(m_boolEvaluations / m_iFrameCount));
+    root->SetAttribute("boolevaluationsperframe", str.c_str());
+    if (m_drawCalls > 0)
+    {
+      str = StringUtils::Format("%u", static_cast<unsigned int>(m_drawCalls / m_iFrameCount));
+      root->SetAttribute("drawcallsperframe", str.c_str());
+      str = StringUtils::Format("%u", static_cast<unsigned int>(m_textureBinds / m_iFrameCount));
+      root->SetAttribute("texturebindsperframe", str.c_str());
+    }
+    if (m_textLayoutHits + m_textLayoutMisses > 0)
+    {
+      str = StringUtils::Format("%.1f", 100.0 * m_textLayoutHits / (m_textLayoutHits + m_textLayoutMisses));
+      root->SetAttribute("textlayoutcachehitrate", str.c_str());
+    }
+    if (m_textureUploadTime > 0)
+    {
+      str = StringUtils::Format("%.3f", m_textureUploadTime / 1000.0 / m_iFrameCount);
+      root->SetAttribute("textureuploadtimeperframe", str.c_str());
+      str = StringUtils::Format("%.3f", m_textureUploadMaxTime / 1000.0);
+      root->SetAttribute("textureuploadmaxtime", str.c_str());
+    }
+  }
   doc.LinkEndChild(root);
 
   m_ItemHead.SaveToXML(root);
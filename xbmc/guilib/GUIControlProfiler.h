@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <algorithm>
 #include <vector>
 
 #include "GUIControl.h"
@@ -63,6 +64,11 @@ public:
   const std::string &GetOutputFile(void) const { return m_strOutputFile; };
   bool SaveResults(void);
   unsigned int GetTotalTime(void) const { return m_ItemHead.GetTotalTime(); };
+  void AddBoolEvaluations(unsigned int count) { m_boolEvaluations += count; };
+  void AddDrawCalls(unsigned int count) { m_drawCalls += count; };
+  void AddTextureBinds(unsigned int count) { m_textureBinds += count; };
+  void AddTextLayoutLookup(bool hit) { if (hit) m_textLayoutHits++; else m_textLayoutMisses++; };
+  void AddTextureUploadTime(uint64_t us) { m_textureUploadTime += us; m_textureUploadMaxTime = std::max(m_textureUploadMaxTime, us); };
 
   float m_fPerfScale;
 private:
@@ -79,6 +85,13 @@ private:
   std::string m_strOutputFile;
   int m_iMaxFrameCount = 200;
   int m_iFrameCount = 0;
+  uint64_t m_boolEvaluations = 0;
+  uint64_t m_drawCalls = 0;
+  uint64_t m_textureBinds = 0;
+  uint64_t m_textLayoutHits = 0;
+  uint64_t m_textLayoutMisses = 0;
+  uint64_t m_textureUploadTime = 0;    ///< microseconds spent uploading background loaded textures
+  uint64_t m_textureUploadMaxTime = 0; ///< longest upload in a single frame, in microseconds
 };
 
 #define GUIPROFILER_VISIBILITY_BEGIN(x) { if (CGUIControlProfiler::IsRunning()) CGUIControlProfiler::Instance().BeginVisibility(x); }
@@ -0,0 +1,257 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIFontGlyphAtlas.h"
+#include "GUIComponent.h"
+#include "ServiceBroker.h"
+#include "TextureManager.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+// stuff for freetype
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include FT_STROKER_H
+
+#define GLYPH_ATLAS_WIDTH 1024
+#define GLYPH_ATLAS_MIN_HEIGHT 128
+#define GLYPH_ATLAS_MAX_HEIGHT 8192
+
+const unsigned int CGUIFontGlyphAtlas::REFERENCE_SIZE = 32;
+const unsigned int CGUIFontGlyphAtlas::SPREAD = 4;
+
+namespace
+{
+// offset to the nearest seed pixel, see "8SSEDT" (Leymarie and Levine)
+struct SOffset
+{
+  int dx, dy;
+  int DistSq() const { return dx * dx + dy * dy; }
+};
+
+const SOffset FAR_AWAY = { 9999, 9999 };
+
+inline void Compare(std::vector<SOffset>& grid, int width, int height, SOffset& p, int x, int y, int ox, int oy)
+{
+  int nx = x + ox;
+  int ny = y + oy;
+  if (nx < 0 || ny < 0 || nx >= width || ny >= height)
+    return;
+
+  SOffset other = grid[ny * width + nx];
+  other.dx += ox;
+  other.dy += oy;
+  if (other.DistSq() < p.DistSq())
+    p = other;
+}
+
+void Propagate(std::vector<SOffset>& grid, int width, int height)
+{
+  for (int y = 0; y < height; y++)
+  {
+    for (int x = 0; x < width; x++)
+    {
+      SOffset p = grid[y * width + x];
+      Compare(grid, width, height, p, x, y, -1,  0);
+      Compare(grid, width, height, p, x, y,  0, -1);
+      Compare(grid, width, height, p, x, y, -1, -1);
+      Compare(grid, width, height, p, x, y,  1, -1);
+      grid[y * width + x] = p;
+    }
+    for (int x = width - 1; x >= 0; x--)
+    {
+      SOffset p = grid[y * width + x];
+      Compare(grid, width, height, p, x, y, 1, 0);
+      grid[y * width + x] = p;
+    }
+  }
+
+  for (int y = height - 1; y >= 0; y--)
+  {
+    for (int x = width - 1; x >= 0; x--)
+    {
+      SOffset p = grid[y * width + x];
+      Compare(grid, width, height, p, x, y,  1,  0);
+      Compare(grid, width, height, p, x, y,  0,  1);
+      Compare(grid, width, height, p, x, y, -1,  1);
+      Compare(grid, width, height, p, x, y,  1,  1);
+      grid[y * width + x] = p;
+    }
+    for (int x = 0; x < width; x++)
+    {
+      SOffset p = grid[y * width + x];
+      Compare(grid, width, height, p, x, y, -1, 0);
+      grid[y * width + x] = p;
+    }
+  }
+}
+}
+
+CGUIFontGlyphAtlas::CGUIFontGlyphAtlas()
+  : m_width(GLYPH_ATLAS_WIDTH)
+  , m_maxHeight(GLYPH_ATLAS_MAX_HEIGHT)
+{
+}
+
+CGUIFontGlyphAtlas::~CGUIFontGlyphAtlas()
+{
+  if (m_hwTexture && CServiceBroker::GetGUI())
+    CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_hwTexture);
+
+  if (m_stroker)
+    FT_Stroker_Done(m_stroker);
+  if (m_face)
+    FT_Done_Face(m_face);
+}
+
+void CGUIFontGlyphAtlas::SetFace(FT_Face face, FT_Stroker stroker, XUTILS::auto_buffer& fontFileInMemory)
+{
+  m_face = face;
+  m_stroker = stroker;
+  size_t size = fontFileInMemory.size();
+  m_fontFileInMemory.attach(fontFileInMemory.detach(), size);
+}
+
+const CGUIFontGlyphAtlas::Glyph* CGUIFontGlyphAtlas::Find(uint32_t key) const
+{
+  auto it = m_glyphs.find(key);
+  if (it == m_glyphs.end())
+    return nullptr;
+  return &it->second;
+}
+
+const CGUIFontGlyphAtlas::Glyph* CGUIFontGlyphAtlas::Add(uint32_t key, const unsigned char* coverage,
+                                                         unsigned int width, unsigned int height,
+                                                         unsigned int pitch, int left, int top, float advance)
+{
+  Glyph glyph = {};
+  glyph.advance = advance;
+
+  if (width > 0 && height > 0)
+  {
+    glyph.width = width + 2 * SPREAD;
+    glyph.height = height + 2 * SPREAD;
+    glyph.left = static_cast<float>(left) - SPREAD;
+    glyph.top = static_cast<float>(top) + SPREAD;
+
+    if (!Reserve(glyph.width, glyph.height, glyph.x, glyph.y))
+      return nullptr;
+
+    WriteDistanceField(coverage, width, height, pitch, glyph.x, glyph.y);
+  }
+
+  return &(m_glyphs[key] = glyph);
+}
+
+bool CGUIFontGlyphAtlas::Reserve(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y)
+{
+  if (width > m_width)
+    return false;
+
+  // one pixel between glyphs, the field fades out to 0 at the border of each glyph anyway
+  if (m_posX + width > m_width)
+  {
+    m_posX = 0;
+    m_posY += m_rowHeight + 1;
+    m_rowHeight = 0;
+  }
+
+  if (m_posY + height > m_height)
+  {
+    unsigned int newHeight = std::max<unsigned int>(m_height, GLYPH_ATLAS_MIN_HEIGHT);
+    while (newHeight < m_posY + height)
+      newHeight *= 2;
+    if (newHeight > m_maxHeight)
+      return false;
+
+    // grow in place, the glyphs keep their position
+    m_pixels.resize(m_width * newHeight, 0);
+    m_dirtyY1 = 0;
+    m_dirtyY2 = newHeight;
+    m_height = newHeight;
+    m_generation++;
+  }
+
+  x = m_posX;
+  y = m_posY;
+  m_posX += width + 1;
+  m_rowHeight = std::max(m_rowHeight, height);
+  return true;
+}
+
+void CGUIFontGlyphAtlas::WriteDistanceField(const unsigned char* coverage, unsigned int width, unsigned int height,
+                                            unsigned int pitch, unsigned int x, unsigned int y)
+{
+  const int w = width + 2 * SPREAD;
+  const int h = height + 2 * SPREAD;
+
+  // distance to the nearest pixel inside and to the nearest pixel outside of the glyph
+  std::vector<SOffset> toInside(w * h, FAR_AWAY);
+  std::vector<SOffset> toOutside(w * h, SOffset{ 0, 0 });
+  for (unsigned int row = 0; row < height; row++)
+  {
+    for (unsigned int col = 0; col < width; col++)
+    {
+      if (coverage[row * pitch + col] >= 128)
+      {
+        int i = (row + SPREAD) * w + col + SPREAD;
+        toInside[i] = SOffset{ 0, 0 };
+        toOutside[i] = FAR_AWAY;
+      }
+    }
+  }
+
+  Propagate(toInside, w, h);
+  Propagate(toOutside, w, h);
+
+  const float scale = 127.0f / SPREAD;
+  for (int row = 0; row < h; row++)
+  {
+    unsigned char* dst = &m_pixels[(y + row) * m_width + x];
+    for (int col = 0; col < w; col++)
+    {
+      int i = row * w + col;
+      // the outline lies halfway between the last pixel inside and the first pixel outside
+      float distance = toOutside[i].DistSq() ? std::sqrt(static_cast<float>(toOutside[i].DistSq())) - 0.5f
+                                             : 0.5f - std::sqrt(static_cast<float>(toInside[i].DistSq()));
+      float value = 128.0f + distance * scale;
+      dst[col] = static_cast<unsigned char>(std::min(std::max(value, 0.0f), 255.0f));
+    }
+  }
+
+  if (m_dirtyY1 == m_dirtyY2)
+  {
+    m_dirtyY1 = y;
+    m_dirtyY2 = y + h;
+  }
+  else
+  {
+    m_dirtyY1 = std::min<unsigned int>(m_dirtyY1, y);
+    m_dirtyY2 = std::max<unsigned int>(m_dirtyY2, y + h);
+  }
+}
+
+bool CGUIFontGlyphAtlas::GetDirtyRows(unsigned int& y1, unsigned int& y2) const
+{
+  y1 = m_dirtyY1;
+  y2 = m_dirtyY2;
+  return y1 != y2;
+}
+
+void CGUIFontGlyphAtlas::ClearDirty()
+{
+  m_dirtyY1 = m_dirtyY2 = 0;
+}
+
+void CGUIFontGlyphAtlas::SetHwTexture(unsigned int texture, unsigned int height)
+{
+  m_hwTexture = texture;
+  m_hwHeight = height;
+}
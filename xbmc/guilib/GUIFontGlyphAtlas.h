@@ -0,0 +1,135 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+\file GUIFontGlyphAtlas.h
+\brief
+*/
+
+#include <stdint.h>
+#include <unordered_map>
+#include <vector>
+
+#include "utils/auto_buffer.h"
+
+struct FT_FaceRec_;
+struct FT_StrokerRec_;
+typedef struct FT_FaceRec_ *FT_Face;
+typedef struct FT_StrokerRec_ *FT_Stroker;
+
+/*!
+ \ingroup textures
+ \brief Signed distance field glyph cache shared by all sizes of a font face
+
+ Glyphs are rasterized once at GLYPH_ATLAS_REFERENCE_SIZE and stored as
+ distance to the glyph outline, with 128 on the outline, higher values
+ inside and lower values outside. Fonts scale the glyphs to their own size
+ and the renderer thresholds the interpolated distance, so one atlas serves
+ every size of the face.
+
+ The atlas has a fixed width and grows in height, keeping the position of
+ the glyphs already cached. Fonts compare GetGeneration() to notice the
+ texture height, and thus their normalized texture coordinates, changed.
+ */
+class CGUIFontGlyphAtlas
+{
+public:
+  static const unsigned int REFERENCE_SIZE;  ///< pixel size glyphs are rasterized at
+  static const unsigned int SPREAD;          ///< distance in pixels the field covers on each side of the outline
+
+  struct Glyph
+  {
+    unsigned int x, y;          ///< top left of the glyph within the atlas
+    unsigned int width, height; ///< size of the glyph within the atlas, including the spread
+    float left, top;            ///< offset of the top left corner from the pen position, y pointing up
+    float advance;              ///< horizontal advance
+  };
+
+  CGUIFontGlyphAtlas();
+  ~CGUIFontGlyphAtlas();
+
+  /*! \brief Take ownership of the face and stroker used to rasterize glyphs
+   \param face face set to REFERENCE_SIZE
+   \param stroker stroker for bordered fonts, may be nullptr
+   \param fontFileInMemory memory backing the face, if any
+   */
+  void SetFace(FT_Face face, FT_Stroker stroker, XUTILS::auto_buffer& fontFileInMemory);
+  FT_Face GetFace() const { return m_face; }
+  FT_Stroker GetStroker() const { return m_stroker; }
+
+  /*! \brief Look up a cached glyph
+   \param key letter and style of the glyph
+   \return the glyph or nullptr if it hasn't been added yet
+   */
+  const Glyph* Find(uint32_t key) const;
+
+  /*! \brief Convert a rasterized glyph to a distance field and add it to the atlas
+   \param key letter and style of the glyph
+   \param coverage 8 bit coverage of the glyph
+   \param width width of the coverage bitmap
+   \param height height of the coverage bitmap
+   \param pitch bytes per row of the coverage bitmap
+   \param left horizontal offset of the bitmap from the pen position
+   \param top vertical offset of the bitmap top from the baseline, y pointing up
+   \param advance horizontal advance of the glyph
+   \return the added glyph or nullptr if the atlas is full
+   */
+  const Glyph* Add(uint32_t key, const unsigned char* coverage, unsigned int width, unsigned int height,
+                   unsigned int pitch, int left, int top, float advance);
+
+  /*! \brief Limit the height the atlas may grow to, e.g. to the maximum texture size */
+  void SetMaxHeight(unsigned int maxHeight) { m_maxHeight = maxHeight; }
+
+  unsigned int GetWidth() const { return m_width; }
+  unsigned int GetHeight() const { return m_height; }
+  const unsigned char* GetPixels() const { return m_pixels.data(); }
+  unsigned int GetGeneration() const { return m_generation; }
+  unsigned int GetGlyphCount() const { return m_glyphs.size(); }
+  size_t GetMemoryUsage() const { return m_pixels.size(); }
+
+  /*! \brief Rows changed since the last call to ClearDirty()
+   \return false if nothing changed
+   */
+  bool GetDirtyRows(unsigned int& y1, unsigned int& y2) const;
+  void ClearDirty();
+
+  /*! \brief Hardware texture holding the atlas, managed by the renderer */
+  unsigned int GetHwTexture() const { return m_hwTexture; }
+  unsigned int GetHwHeight() const { return m_hwHeight; }
+  void SetHwTexture(unsigned int texture, unsigned int height);
+
+private:
+  CGUIFontGlyphAtlas(const CGUIFontGlyphAtlas&) = delete;
+  CGUIFontGlyphAtlas& operator=(const CGUIFontGlyphAtlas&) = delete;
+
+  bool Reserve(unsigned int width, unsigned int height, unsigned int& x, unsigned int& y);
+  void WriteDistanceField(const unsigned char* coverage, unsigned int width, unsigned int height,
+                          unsigned int pitch, unsigned int x, unsigned int y);
+
+  FT_Face m_face = nullptr;
+  FT_Stroker m_stroker = nullptr;
+  XUTILS::auto_buffer m_fontFileInMemory;
+
+  std::unordered_map<uint32_t, Glyph> m_glyphs;
+  std::vector<unsigned char> m_pixels;
+  unsigned int m_width;
+  unsigned int m_height = 0;
+  unsigned int m_maxHeight;
+  unsigned int m_posX = 0;
+  unsigned int m_posY = 0;
+  unsigned int m_rowHeight = 0;
+  unsigned int m_generation = 0;
+
+  unsigned int m_dirtyY1 = 0;
+  unsigned int m_dirtyY2 = 0;
+
+  unsigned int m_hwTexture = 0;
+  unsigned int m_hwHeight = 0;
+};
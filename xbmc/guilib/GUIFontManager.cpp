@@ -15,10 +15,13 @@
 #include "addons/FontResource.h"
 #include "GUIFontTTF.h"
 #include "GUIFont.h"
+#include "GUITextLayoutCache.h"
 #include "utils/XMLUtils.h"
 #include "GUIControlFactory.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
@@ -209,6 +212,9 @@ void GUIFontManager::ReloadTTFFonts(void)
   if (!m_vecFonts.size())
     return;   // we haven't even loaded fonts in yet
 
+  // cached layouts were measured with the old font sizes
+  CGUITextLayoutCache::GetInstance().Flush();
+
   for (unsigned int i = 0; i < m_vecFonts.size(); i++)
   {
     CGUIFont* font = m_vecFonts[i];
@@ -247,6 +253,7 @@ void GUIFontManager::Unload(const std::string& strFontName)
   {
     if (StringUtils::EqualsNoCase((*iFont)->GetFontName(), strFontName))
     {
+      CGUITextLayoutCache::GetInstance().Flush();
       delete (*iFont);
       m_vecFonts.erase(iFont);
       return;
@@ -328,6 +335,8 @@ CGUIFont* GUIFontManager::GetDefaultFont(bool border)
 
 void GUIFontManager::Clear()
 {
+  CGUITextLayoutCache::GetInstance().Flush();
+
   for (int i = 0; i < (int)m_vecFonts.size(); ++i)
   {
     CGUIFont* pFont = m_vecFonts[i];
@@ -345,6 +354,9 @@ void GUIFontManager::LoadFonts(const std::string& fontSet)
   const std::string strPath = g_SkinInfo->GetSkinPath("Font.xml", &m_skinResolution);
   CLog::Log(LOGINFO, "Loading fonts from %s", strPath.c_str());
 
+  CGUITextLayoutCache::GetInstance().SetCapacity(
+    CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextLayoutCacheSize);
+
   CXBMCTinyXML xmlDoc;
   if (!xmlDoc.LoadFile(strPath))
   {
@@ -7,6 +7,7 @@
  */
 
 #include "GUIFont.h"
+#include "GUIFontGlyphAtlas.h"
 #include "GUIFontTTF.h"
 #include "GUIFontManager.h"
 #include "Texture.h"
@@ -15,12 +16,16 @@
 #include "filesystem/SpecialProtocol.h"
 #include "utils/MathUtils.h"
 #include "utils/log.h"
+#include "utils/StringUtils.h"
 #include "rendering/RenderSystem.h"
 #include "windowing/WinSystem.h"
 #include "URL.h"
 #include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SystemClock.h"
 
+#include <map>
 #include <math.h>
 #include <memory>
 #include <queue>
@@ -149,6 +154,51 @@ private:
 XBMC_GLOBAL_REF(CFreeTypeLibrary, g_freeTypeLibrary); // our freetype library
 #define g_freeTypeLibrary XBMC_GLOBAL_USE(CFreeTypeLibrary)
 
+std::shared_ptr<CGUIFontGlyphAtlas> CGUIFontTTFBase::GetGlyphAtlas(const std::string& strFilename, float aspect, bool border)
+{
+  // fonts are only loaded and rendered with the graphics context locked
+  static std::map<std::string, std::weak_ptr<CGUIFontGlyphAtlas>> atlases;
+
+  std::string key = StringUtils::Format("%s|%f|%d", strFilename.c_str(), aspect, border ? 1 : 0);
+  std::shared_ptr<CGUIFontGlyphAtlas> atlas = atlases[key].lock();
+  if (atlas)
+    return atlas;
+
+  XUTILS::auto_buffer fontFileInMemory;
+  FT_Face face = g_freeTypeLibrary.GetFont(strFilename, static_cast<float>(CGUIFontGlyphAtlas::REFERENCE_SIZE), aspect, fontFileInMemory);
+  if (!face)
+    return nullptr;
+
+  FT_Stroker stroker = nullptr;
+  if (border)
+  {
+    // same relative strength as CGUIFontTTFBase::Load
+    FT_Pos strength = FT_MulFix(face->units_per_EM, face->size->metrics.y_scale) / 12;
+    if (strength < 128)
+      strength = 128;
+
+    stroker = g_freeTypeLibrary.GetStroker();
+    if (stroker)
+      FT_Stroker_Set(stroker, strength, FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+  }
+
+  atlas = std::make_shared<CGUIFontGlyphAtlas>();
+  atlas->SetFace(face, stroker, fontFileInMemory);
+  atlas->SetMaxHeight(std::min(atlas->GetWidth() * 8, CServiceBroker::GetRenderSystem()->GetMaxTextureSize()));
+  atlases[key] = atlas;
+
+  // drop entries of released atlases
+  for (auto it = atlases.begin(); it != atlases.end();)
+  {
+    if (it->second.expired())
+      it = atlases.erase(it);
+    else
+      ++it;
+  }
+
+  return atlas;
+}
+
 CGUIFontTTFBase::CGUIFontTTFBase(const std::string& strFileName) : m_staticCache(*this), m_dynamicCache(*this)
 {
   m_texture = NULL;
@@ -217,6 +267,9 @@ void CGUIFontTTFBase::Clear()
 {
   delete(m_texture);
   m_texture = NULL;
+  m_glyphAtlas.reset();
+  m_glyphAtlasGeneration = 0;
+  m_glyphScale = 1.0f;
   delete[] m_char;
   memset(m_charquick, 0, sizeof(m_charquick));
   m_char = NULL;
@@ -321,6 +374,20 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   m_posX = m_textureWidth;
   m_posY = -(int)GetTextureLineHeight();
 
+  m_glyphAtlas.reset();
+  m_glyphAtlasGeneration = 0;
+  m_glyphScale = 1.0f;
+  if (SupportsGlyphAtlas() &&
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiFontGlyphAtlas)
+  {
+    m_glyphAtlas = GetGlyphAtlas(strFilename, aspect, border);
+    if (m_glyphAtlas)
+    {
+      m_glyphScale = height / CGUIFontGlyphAtlas::REFERENCE_SIZE;
+      SyncGlyphAtlas();
+    }
+  }
+
   // cache the ellipses width
   Character *ellipse = GetCharacter(L'.');
   if (ellipse) m_ellipsesWidth = ellipse->advance;
@@ -330,7 +397,7 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
 
 void CGUIFontTTFBase::Begin()
 {
-  if (m_nestedBeginCount == 0 && m_texture != NULL && FirstBegin())
+  if (m_nestedBeginCount == 0 && (m_texture != NULL || m_glyphAtlas) && FirstBegin())
   {
     m_vertexTrans.clear();
     m_vertex.clear();
@@ -359,6 +426,9 @@ void CGUIFontTTFBase::DrawTextInternal(float x, float y, const std::vector<UTILS
 
   Begin();
 
+  // another size of our face may have grown the shared glyph atlas
+  SyncGlyphAtlas();
+
   uint32_t rawAlignment = alignment;
   bool dirtyCache(false);
   bool hardwareClipping = m_renderSystem->ScissorsCanEffectClipping();
@@ -570,7 +640,7 @@ float CGUIFontTTFBase::GetTextWidthInternal(vecText::const_iterator start, vecTe
       // and not advance distance - this makes sure that italic text isn't
       // choped on the end (as render width is larger than advance then).
       if (start == end)
-        width += std::max(c->right - c->left + c->offsetX, c->advance);
+        width += std::max((c->right - c->left) * m_glyphScale + c->offsetX, c->advance);
       else
         width += c->advance;
     }
@@ -691,39 +761,52 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
   return m_char + low;
 }
 
-bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
+FT_Glyph CGUIFontTTFBase::RenderGlyph(FT_Face face, FT_Stroker stroker, wchar_t letter, uint32_t style)
 {
-  int glyph_index = FT_Get_Char_Index( m_face, letter );
+  int glyph_index = FT_Get_Char_Index( face, letter );
 
   FT_Glyph glyph = NULL;
-  if (FT_Load_Glyph( m_face, glyph_index, FT_LOAD_TARGET_LIGHT ))
+  if (FT_Load_Glyph( face, glyph_index, FT_LOAD_TARGET_LIGHT ))
   {
     CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
-    return false;
+    return NULL;
   }
   // make bold if applicable
   if (style & FONT_STYLE_BOLD)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_BOLD);
+    SetGlyphStrength(face->glyph, GLYPH_STRENGTH_BOLD);
   // and italics if applicable
   if (style & FONT_STYLE_ITALICS)
-    ObliqueGlyph(m_face->glyph);
+    ObliqueGlyph(face->glyph);
   // and light if applicable
   if (style & FONT_STYLE_LIGHT)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_LIGHT);
+    SetGlyphStrength(face->glyph, GLYPH_STRENGTH_LIGHT);
   // grab the glyph
-  if (FT_Get_Glyph(m_face->glyph, &glyph))
+  if (FT_Get_Glyph(face->glyph, &glyph))
   {
     CLog::Log(LOGDEBUG, "%s Failed to get glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
-    return false;
+    return NULL;
   }
-  if (m_stroker)
-    FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
+  if (stroker)
+    FT_Glyph_StrokeBorder(&glyph, stroker, 0, 1);
   // render the glyph
   if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, NULL, 1))
   {
     CLog::Log(LOGDEBUG, "%s Failed to render glyph %x to a bitmap", __FUNCTION__, static_cast<uint32_t>(letter));
-    return false;
+    FT_Done_Glyph(glyph);
+    return NULL;
   }
+  return glyph;
+}
+
+bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
+{
+  if (m_glyphAtlas)
+    return CacheCharacterFromAtlas(letter, style, ch);
+
+  FT_Glyph glyph = RenderGlyph(m_face, m_stroker, letter, style);
+  if (!glyph)
+    return false;
+
   FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
   FT_Bitmap bitmap = bitGlyph->bitmap;
   bool isEmptyGlyph = (bitmap.width == 0 || bitmap.rows == 0);
@@ -803,12 +886,65 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
   return true;
 }
 
+bool CGUIFontTTFBase::CacheCharacterFromAtlas(wchar_t letter, uint32_t style, Character *ch)
+{
+  character_t key = (style << 16) | letter;
+  const CGUIFontGlyphAtlas::Glyph* cached = m_glyphAtlas->Find(key);
+  if (!cached)
+  {
+    FT_Glyph glyph = RenderGlyph(m_glyphAtlas->GetFace(), m_glyphAtlas->GetStroker(), letter, style);
+    if (!glyph)
+      return false;
+
+    FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
+    cached = m_glyphAtlas->Add(key, bitGlyph->bitmap.buffer, bitGlyph->bitmap.width, bitGlyph->bitmap.rows,
+                               std::abs(bitGlyph->bitmap.pitch), bitGlyph->left, bitGlyph->top,
+                               (float)m_glyphAtlas->GetFace()->glyph->advance.x / 64);
+    FT_Done_Glyph(glyph);
+
+    if (!cached)
+    {
+      CLog::Log(LOGDEBUG, "%s: Glyph atlas of %s is full", __FUNCTION__, m_strFilename.c_str());
+      return false;
+    }
+    SyncGlyphAtlas();
+  }
+
+  // left/top/right/bottom stay in atlas pixels, RenderCharacter scales them to our size
+  ch->letterAndStyle = key;
+  ch->offsetX = (short)MathUtils::round_int(cached->left * m_glyphScale);
+  ch->offsetY = (short)MathUtils::round_int(m_cellBaseLine - cached->top * m_glyphScale);
+  ch->left = (float)cached->x;
+  ch->top = (float)cached->y;
+  ch->right = ch->left + cached->width;
+  ch->bottom = ch->top + cached->height;
+  ch->advance = (float)MathUtils::round_int(cached->advance * m_glyphScale);
+  m_numChars++;
+
+  return true;
+}
+
+void CGUIFontTTFBase::SyncGlyphAtlas()
+{
+  if (!m_glyphAtlas || m_glyphAtlas->GetGeneration() == m_glyphAtlasGeneration)
+    return;
+
+  // the atlas grew, which changes the texture coordinates of every cached string
+  m_glyphAtlasGeneration = m_glyphAtlas->GetGeneration();
+  m_textureWidth = m_glyphAtlas->GetWidth();
+  m_textureHeight = m_glyphAtlas->GetHeight();
+  m_textureScaleX = 1.0f / m_textureWidth;
+  m_textureScaleY = 1.0f / m_textureHeight;
+  m_staticCache.Flush();
+  m_dynamicCache.Flush();
+}
+
 void CGUIFontTTFBase::RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices)
 {
   // actual image width isn't same as the character width as that is
   // just baseline width and height should include the descent
-  const float width = ch->right - ch->left;
-  const float height = ch->bottom - ch->top;
+  const float width = (ch->right - ch->left) * m_glyphScale;
+  const float height = (ch->bottom - ch->top) * m_glyphScale;
 
   // return early if nothing to render
   if (width == 0 || height == 0)
@@ -974,8 +1110,8 @@ void CGUIFontTTFBase::SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength)
     return;
 
   /* some reasonable strength */
-  FT_Pos strength = FT_MulFix( m_face->units_per_EM,
-                    m_face->size->metrics.y_scale ) / glyphStrength;
+  FT_Pos strength = FT_MulFix( slot->face->units_per_EM,
+                    slot->face->size->metrics.y_scale ) / glyphStrength;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox( &slot->outline, &bbox_before );
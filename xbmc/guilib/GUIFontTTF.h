@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <stdint.h>
 #include <vector>
@@ -27,6 +28,7 @@ using namespace DirectX::PackedVector;
 constexpr size_t LOOKUPTABLE_SIZE = 256 * 8;
 
 class CBaseTexture;
+class CGUIFontGlyphAtlas;
 class CRenderSystemBase;
 
 struct FT_FaceRec_;
@@ -40,6 +42,7 @@ typedef struct FT_LibraryRec_ *FT_Library;
 typedef struct FT_GlyphSlotRec_ *FT_GlyphSlot;
 typedef struct FT_BitmapGlyphRec_ *FT_BitmapGlyph;
 typedef struct FT_StrokerRec_ *FT_Stroker;
+typedef struct FT_GlyphRec_ *FT_Glyph;
 
 typedef uint32_t character_t;
 typedef std::vector<character_t> vecText;
@@ -112,6 +115,7 @@ protected:
   // Stuff for pre-rendering for speed
   inline Character *GetCharacter(character_t letter);
   bool CacheCharacter(wchar_t letter, uint32_t style, Character *ch);
+  bool CacheCharacterFromAtlas(wchar_t letter, uint32_t style, Character *ch);
   void RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices);
   void ClearCharacterCache();
 
@@ -119,12 +123,25 @@ protected:
   virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
   virtual void DeleteHardwareTexture() = 0;
 
+  /*! \brief Whether the renderer can draw glyphs from a signed distance field atlas */
+  virtual bool SupportsGlyphAtlas() const { return false; }
+
+  /*! \brief Pick up a change of the shared glyph atlas' size made by another font */
+  void SyncGlyphAtlas();
+
   // modifying glyphs
-  void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
+  static void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
   static void ObliqueGlyph(FT_GlyphSlot slot);
+  static FT_Glyph RenderGlyph(FT_Face face, FT_Stroker stroker, wchar_t letter, uint32_t style);
+
+  static std::shared_ptr<CGUIFontGlyphAtlas> GetGlyphAtlas(const std::string& strFilename, float aspect, bool border);
 
   CBaseTexture* m_texture;        // texture that holds our rendered characters (8bit alpha only)
 
+  std::shared_ptr<CGUIFontGlyphAtlas> m_glyphAtlas; // distance field glyphs shared with the other sizes of our face, replaces m_texture
+  unsigned int m_glyphAtlasGeneration = 0;
+  float m_glyphScale = 1.0f;         // size of our glyphs relative to the cached ones
+
   unsigned int m_textureWidth;       // width of our texture
   unsigned int m_textureHeight;      // height of our texture
   int m_posX;                        // current position in the texture
@@ -8,6 +8,7 @@
 
 #include "GUIFont.h"
 #include "GUIFontTTFGL.h"
+#include "GUIFontGlyphAtlas.h"
 #include "GUIFontManager.h"
 #include "Texture.h"
 #include "TextureManager.h"
@@ -68,48 +69,95 @@ bool CGUIFontTTFGL::FirstBegin()
   GLenum internalFormat = GL_ALPHA;
 #endif
 
-  if (m_textureStatus == TEXTURE_REALLOCATED)
+  if (m_glyphAtlas)
   {
-    if (glIsTexture(m_nTexture))
-      CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_nTexture);
-    m_textureStatus = TEXTURE_VOID;
+    if (!UploadGlyphAtlas(internalFormat, pixformat))
+      return false;
   }
-
-  if (m_textureStatus == TEXTURE_VOID)
+  else
   {
-    // Have OpenGL generate a texture object handle for us
-    glGenTextures(1, (GLuint*) &m_nTexture);
+    if (m_textureStatus == TEXTURE_REALLOCATED)
+    {
+      if (glIsTexture(m_nTexture))
+        CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_nTexture);
+      m_textureStatus = TEXTURE_VOID;
+    }
 
-    // Bind the texture object
-    glBindTexture(GL_TEXTURE_2D, m_nTexture);
+    if (m_textureStatus == TEXTURE_VOID)
+    {
+      // Have OpenGL generate a texture object handle for us
+      glGenTextures(1, (GLuint*) &m_nTexture);
 
-    // Set the texture's stretching properties
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+      // Bind the texture object
+      glBindTexture(GL_TEXTURE_2D, m_nTexture);
 
-    // Set the texture image -- THIS WORKS, so the pixels must be wrong.
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_texture->GetWidth(), m_texture->GetHeight(), 0,
-        pixformat, GL_UNSIGNED_BYTE, 0);
+      // Set the texture's stretching properties
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+      glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 
-    VerifyGLState();
-    m_textureStatus = TEXTURE_UPDATED;
-  }
+      // Set the texture image -- THIS WORKS, so the pixels must be wrong.
+      glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_texture->GetWidth(), m_texture->GetHeight(), 0,
+          pixformat, GL_UNSIGNED_BYTE, 0);
 
-  if (m_textureStatus == TEXTURE_UPDATED)
-  {
-    glBindTexture(GL_TEXTURE_2D, m_nTexture);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_updateY1, m_texture->GetWidth(), m_updateY2 - m_updateY1, pixformat, GL_UNSIGNED_BYTE,
-        m_texture->GetPixels() + m_updateY1 * m_texture->GetPitch());
+      VerifyGLState();
+      m_textureStatus = TEXTURE_UPDATED;
+    }
 
-    m_updateY1 = m_updateY2 = 0;
-    m_textureStatus = TEXTURE_READY;
+    if (m_textureStatus == TEXTURE_UPDATED)
+    {
+      glBindTexture(GL_TEXTURE_2D, m_nTexture);
+      glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_updateY1, m_texture->GetWidth(), m_updateY2 - m_updateY1, pixformat, GL_UNSIGNED_BYTE,
+          m_texture->GetPixels() + m_updateY1 * m_texture->GetPitch());
+
+      m_updateY1 = m_updateY2 = 0;
+      m_textureStatus = TEXTURE_READY;
+    }
   }
 
   // Turn Blending On
   glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
   glEnable(GL_BLEND);
   glActiveTexture(GL_TEXTURE0);
-  glBindTexture(GL_TEXTURE_2D, m_nTexture);
+  glBindTexture(GL_TEXTURE_2D, m_glyphAtlas ? m_glyphAtlas->GetHwTexture() : m_nTexture);
+  return true;
+}
+
+bool CGUIFontTTFGL::UploadGlyphAtlas(GLenum internalFormat, GLenum pixformat)
+{
+  unsigned int width = m_glyphAtlas->GetWidth();
+  unsigned int height = m_glyphAtlas->GetHeight();
+  if (height == 0)
+    return false;
+
+  // the atlas is shared with the other sizes of our face, whichever font
+  // draws first after a change uploads it
+  GLuint texture = m_glyphAtlas->GetHwTexture();
+  if (texture == 0 || m_glyphAtlas->GetHwHeight() != height)
+  {
+    if (texture != 0)
+      CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(texture);
+
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, width, height, 0,
+        pixformat, GL_UNSIGNED_BYTE, m_glyphAtlas->GetPixels());
+
+    VerifyGLState();
+    m_glyphAtlas->SetHwTexture(texture, height);
+    m_glyphAtlas->ClearDirty();
+    return true;
+  }
+
+  unsigned int y1, y2;
+  if (m_glyphAtlas->GetDirtyRows(y1, y2))
+  {
+    glBindTexture(GL_TEXTURE_2D, texture);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, y1, width, y2 - y1, pixformat, GL_UNSIGNED_BYTE,
+        m_glyphAtlas->GetPixels() + y1 * width);
+    m_glyphAtlas->ClearDirty();
+  }
   return true;
 }
 
@@ -117,7 +165,7 @@ void CGUIFontTTFGL::LastEnd()
 {
 #ifdef HAS_GL
   CRenderSystemGL* renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
-  renderSystem->EnableShader(SM_FONTS);
+  renderSystem->EnableShader(m_glyphAtlas ? SM_FONTS_SDF : SM_FONTS);
 
   GLint posLoc = renderSystem->ShaderGetPos();
   GLint colLoc = renderSystem->ShaderGetCol();
@@ -160,6 +208,7 @@ void CGUIFontTTFGL::LastEnd()
     glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, GL_FALSE, sizeof(SVertex), BUFFER_OFFSET(offsetof(SVertex, u)));
 
     glDrawArrays(GL_TRIANGLES, 0, vecVertices.size());
+    renderSystem->AddDrawCall();
 
     glBindBuffer(GL_ARRAY_BUFFER, 0);
     glDeleteBuffers(1, &VertexVBO);
@@ -207,6 +256,7 @@ void CGUIFontTTFGL::LastEnd()
     glVertexAttribPointer(tex0Loc, 2, GL_FLOAT,  GL_FALSE, sizeof(SVertex), (char*)vertices + offsetof(SVertex, u));
 
     glDrawArrays(GL_TRIANGLES, 0, vecVertices.size());
+    renderSystem->AddDrawCall();
   }
 #endif
 
@@ -260,6 +310,7 @@ void CGUIFontTTFGL::LastEnd()
         glVertexAttribPointer(tex0Loc, 2, GL_FLOAT,         GL_FALSE, sizeof(SVertex), (GLvoid *) (character*sizeof(SVertex)*4 + offsetof(SVertex, u)));
 
         glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+        renderSystem->AddDrawCall();
       }
 
       glMatrixModview.Pop();
@@ -32,10 +32,16 @@ protected:
   CBaseTexture* ReallocTexture(unsigned int& newHeight) override;
   bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override;
   void DeleteHardwareTexture() override;
+#if defined(HAS_GL)
+  // GLES would need OES_standard_derivatives for the distance field shader
+  bool SupportsGlyphAtlas() const override { return true; }
+#endif
 
   static GLuint m_elementArrayHandle;
 
 private:
+  bool UploadGlyphAtlas(GLenum internalFormat, GLenum pixformat);
+
   unsigned int m_updateY1;
   unsigned int m_updateY2;
 
@@ -7,6 +7,7 @@
  */
 
 #include "GUIIncludes.h"
+#include "GUIXMLCache.h"
 #include "addons/Skin.h"
 #include "GUIInfoManager.h"
 #include "guilib/guiinfo/GUIInfoLabel.h"
@@ -95,9 +96,13 @@ void CGUIIncludes::Clear()
   m_expressions.clear();
 }
 
-void CGUIIncludes::Load(const std::string &file)
+void CGUIIncludes::Load(const std::string &file, CGUIXMLCache* xmlCache /* = nullptr */)
 {
-  if (!Load_Internal(file))
+  m_xmlCache = xmlCache;
+  bool loaded = Load_Internal(file);
+  m_xmlCache = nullptr;
+
+  if (!loaded)
     return;
   FlattenExpressions();
   FlattenSkinVariableConditions();
@@ -110,7 +115,7 @@ bool CGUIIncludes::Load_Internal(const std::string &file)
     return true;
 
   CXBMCTinyXML doc;
-  if (!doc.LoadFile(file))
+  if (!(m_xmlCache ? m_xmlCache->LoadFile(file, doc) : doc.LoadFile(file)))
   {
     CLog::Log(LOGINFO, "Error loading include file %s: %s (row: %i, col: %i)", file.c_str(), doc.ErrorDesc(), doc.ErrorRow(), doc.ErrorCol());
     return false;
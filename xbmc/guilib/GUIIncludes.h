@@ -17,6 +17,7 @@
 #include "interfaces/info/InfoBool.h"
 
 // forward definitions
+class CGUIXMLCache;
 class TiXmlElement;
 namespace INFO
 {
@@ -40,8 +41,9 @@ public:
    conditions after loading all other included files.
 
    \param file the file to load
+   \param xmlCache cache holding prefetched skin files, or nullptr to load them from disk
   */
-  void Load(const std::string &file);
+  void Load(const std::string &file, CGUIXMLCache* xmlCache = nullptr);
 
   /*!
    \brief Resolve all include components (defaults, constants, variables, expressions and includes)
@@ -130,4 +132,6 @@ private:
 
   std::set<std::string> m_expressionAttributes;
   std::set<std::string> m_expressionNodes;
+
+  CGUIXMLCache* m_xmlCache = nullptr;
 };
@@ -129,6 +129,11 @@ public:
   bool HasOverlay() const;
   virtual bool IsFileItem() const { return false; };
 
+  /*! \brief Format labels whose formatting was deferred until the item is shown
+   Called by containers before they process the item.
+   */
+  virtual void FormatDeferredLabels() {};
+
   void SetLayout(CGUIListItemLayoutPtr layout);
   CGUIListItemLayout *GetLayout();
 
@@ -7,6 +7,7 @@
  */
 
 #include "GUITextLayout.h"
+#include "GUITextLayoutCache.h"
 #include "GUIFont.h"
 #include "GUIComponent.h"
 #include "GUIControl.h"
@@ -208,9 +209,16 @@ bool CGUITextLayout::Update(const std::string &text, float maxWidth, bool forceU
 
   m_lastUtf8Text = text;
   m_lastUpdateW = false;
+
+  STextLayoutKey key = GetLayoutKey(maxWidth, forceLTRReadingOrder);
+  key.utf8 = text;
+  if (LoadCachedLayout(key))
+    return true;
+
   std::wstring utf16;
   g_charsetConverter.utf8ToW(text, utf16, false);
   UpdateCommon(utf16, maxWidth, forceLTRReadingOrder);
+  StoreCachedLayout(key);
   return true;
 }
 
@@ -221,10 +229,51 @@ bool CGUITextLayout::UpdateW(const std::wstring &text, float maxWidth /*= 0*/, b
 
   m_lastText = text;
   m_lastUpdateW = true;
+
+  STextLayoutKey key = GetLayoutKey(maxWidth, forceLTRReadingOrder);
+  key.utf16 = text;
+  if (LoadCachedLayout(key))
+    return true;
+
   UpdateCommon(text, maxWidth, forceLTRReadingOrder);
+  StoreCachedLayout(key);
+  return true;
+}
+
+STextLayoutKey CGUITextLayout::GetLayoutKey(float maxWidth, bool forceLTRReadingOrder) const
+{
+  STextLayoutKey key;
+  key.font = m_font;
+  key.maxWidth = (m_wrap && maxWidth > 0) ? maxWidth : 0;
+  key.maxHeight = m_maxHeight;
+  key.textColor = m_textColor;
+  key.forceLTRReadingOrder = forceLTRReadingOrder;
+  return key;
+}
+
+bool CGUITextLayout::LoadCachedLayout(const STextLayoutKey& key)
+{
+  STextLayout layout;
+  if (!CGUITextLayoutCache::GetInstance().Lookup(key, layout))
+    return false;
+
+  m_lines = std::move(layout.lines);
+  m_colors = std::move(layout.colors);
+  m_textWidth = layout.textWidth;
+  m_textHeight = layout.textHeight;
   return true;
 }
 
+void CGUITextLayout::StoreCachedLayout(const STextLayoutKey& key) const
+{
+  STextLayout layout;
+  layout.lines = m_lines;
+  layout.colors = m_colors;
+  layout.textWidth = m_textWidth;
+  layout.textHeight = m_textHeight;
+  CGUITextLayoutCache::GetInstance().Store(key, layout);
+}
+
 void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool forceLTRReadingOrder)
 {
   // parse the text for style information
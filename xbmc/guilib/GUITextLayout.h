@@ -23,6 +23,7 @@
 
 class CGUIFont;
 class CScrollInfo;
+struct STextLayoutKey;
 
 // Process will be:
 
@@ -112,6 +113,11 @@ protected:
   void CalcTextExtent();
   void UpdateCommon(const std::wstring &text, float maxWidth, bool forceLTRReadingOrder);
 
+  /*! \brief Layout parameters for the shared layout cache, without the text */
+  STextLayoutKey GetLayoutKey(float maxWidth, bool forceLTRReadingOrder) const;
+  bool LoadCachedLayout(const STextLayoutKey& key);
+  void StoreCachedLayout(const STextLayoutKey& key) const;
+
   /*! \brief Returns the text, utf8 encoded
    \return utf8 text
    */
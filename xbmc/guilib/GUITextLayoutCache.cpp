@@ -0,0 +1,113 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUITextLayoutCache.h"
+#include "GUIControlProfiler.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <functional>
+
+bool STextLayoutKey::operator==(const STextLayoutKey& right) const
+{
+  return font == right.font &&
+         maxWidth == right.maxWidth &&
+         maxHeight == right.maxHeight &&
+         textColor == right.textColor &&
+         forceLTRReadingOrder == right.forceLTRReadingOrder &&
+         utf8 == right.utf8 &&
+         utf16 == right.utf16;
+}
+
+size_t STextLayoutKeyHash::operator()(const STextLayoutKey& key) const
+{
+  size_t hash = key.utf16.empty() ? std::hash<std::string>()(key.utf8) : std::hash<std::wstring>()(key.utf16);
+  auto combine = [&hash](size_t value) { hash ^= value + 0x9e3779b9 + (hash << 6) + (hash >> 2); };
+  combine(std::hash<const CGUIFont*>()(key.font));
+  combine(std::hash<float>()(key.maxWidth));
+  combine(std::hash<float>()(key.maxHeight));
+  combine(key.textColor);
+  return hash;
+}
+
+CGUITextLayoutCache& CGUITextLayoutCache::GetInstance()
+{
+  static CGUITextLayoutCache instance;
+  return instance;
+}
+
+bool CGUITextLayoutCache::Lookup(const STextLayoutKey& key, STextLayout& layout)
+{
+  CSingleLock lock(m_critSection);
+  if (m_capacity == 0)
+    return false;
+
+  auto it = m_index.find(key);
+  bool hit = it != m_index.end();
+  if (hit)
+  {
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    layout = it->second->second;
+    m_hits++;
+  }
+  else
+    m_misses++;
+
+  if (CGUIControlProfiler::IsRunning())
+    CGUIControlProfiler::Instance().AddTextLayoutLookup(hit);
+  return hit;
+}
+
+void CGUITextLayoutCache::Store(const STextLayoutKey& key, const STextLayout& layout)
+{
+  CSingleLock lock(m_critSection);
+  if (m_capacity == 0)
+    return;
+
+  auto it = m_index.find(key);
+  if (it != m_index.end())
+  {
+    it->second->second = layout;
+    m_entries.splice(m_entries.begin(), m_entries, it->second);
+    return;
+  }
+
+  m_entries.emplace_front(key, layout);
+  m_index.insert(std::make_pair(key, m_entries.begin()));
+
+  while (m_entries.size() > m_capacity)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+}
+
+void CGUITextLayoutCache::Flush()
+{
+  CSingleLock lock(m_critSection);
+  if (m_hits + m_misses > 0)
+    CLog::Log(LOGDEBUG, "CGUITextLayoutCache::%s - %u layouts dropped, %.1f%% of %llu lookups hit",
+              __FUNCTION__, static_cast<unsigned int>(m_entries.size()),
+              100.0 * m_hits / (m_hits + m_misses), static_cast<unsigned long long>(m_hits + m_misses));
+
+  m_index.clear();
+  m_entries.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
+
+void CGUITextLayoutCache::SetCapacity(unsigned int capacity)
+{
+  CSingleLock lock(m_critSection);
+  m_capacity = capacity;
+  while (m_entries.size() > m_capacity)
+  {
+    m_index.erase(m_entries.back().first);
+    m_entries.pop_back();
+  }
+}
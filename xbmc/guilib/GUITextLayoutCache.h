@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "GUITextLayout.h"
+#include "threads/CriticalSection.h"
+
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*!
+ \ingroup textures
+ \brief Layout parameters a cached text layout was produced with
+ */
+struct STextLayoutKey
+{
+  const CGUIFont* font = nullptr;
+  std::string utf8;             ///< text as passed to CGUITextLayout::Update
+  std::wstring utf16;           ///< text as passed to CGUITextLayout::UpdateW
+  float maxWidth = 0;           ///< wrapping width, 0 if the text isn't wrapped
+  float maxHeight = 0;
+  UTILS::Color textColor = 0;
+  bool forceLTRReadingOrder = false;
+
+  bool operator==(const STextLayoutKey& right) const;
+};
+
+struct STextLayoutKeyHash
+{
+  size_t operator()(const STextLayoutKey& key) const;
+};
+
+/*!
+ \ingroup textures
+ \brief Result of parsing, wrapping and bidi flipping a label's text
+ */
+struct STextLayout
+{
+  std::vector<CGUIString> lines;
+  std::vector<UTILS::Color> colors;
+  float textWidth = 0;
+  float textHeight = 0;
+};
+
+/*!
+ \ingroup textures
+ \brief Least recently used cache of text layouts shared by all controls
+
+ Containers lay out the same strings again as their items scroll in and
+ out of view. The cache hands out the lines of an earlier layout with the
+ same font, text and constraints, which skips the charset conversion, style
+ parsing, wrapping and bidi processing.
+
+ Cached layouts refer to fonts by pointer, so the font manager flushes the
+ cache whenever it unloads or reloads fonts.
+ */
+class CGUITextLayoutCache
+{
+public:
+  static CGUITextLayoutCache& GetInstance();
+
+  /*! \brief Look up a layout and mark it as most recently used
+   \param key layout parameters
+   \param layout [out] the cached layout
+   \return true if the layout was cached, false otherwise
+   */
+  bool Lookup(const STextLayoutKey& key, STextLayout& layout);
+
+  /*! \brief Add a layout, dropping the least recently used one if the cache is full */
+  void Store(const STextLayoutKey& key, const STextLayout& layout);
+
+  /*! \brief Drop all layouts, e.g. when the fonts they were laid out with go away */
+  void Flush();
+
+  /*! \brief Maximum number of layouts kept, 0 disables the cache */
+  void SetCapacity(unsigned int capacity);
+  unsigned int GetCapacity() const { return m_capacity; }
+
+  unsigned int GetSize() const { return m_entries.size(); }
+  uint64_t GetHits() const { return m_hits; }
+  uint64_t GetMisses() const { return m_misses; }
+
+private:
+  CGUITextLayoutCache() = default;
+  CGUITextLayoutCache(const CGUITextLayoutCache&) = delete;
+  CGUITextLayoutCache& operator=(const CGUITextLayoutCache&) = delete;
+
+  typedef std::list<std::pair<STextLayoutKey, STextLayout>> LayoutList;
+
+  LayoutList m_entries; ///< most recently used first
+  std::unordered_map<STextLayoutKey, LayoutList::iterator, STextLayoutKeyHash> m_index;
+  unsigned int m_capacity = 1024;
+  uint64_t m_hits = 0;
+  uint64_t m_misses = 0;
+  CCriticalSection m_critSection;
+};
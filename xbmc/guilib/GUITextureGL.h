@@ -11,9 +11,10 @@
 #include "system_gl.h"
 
 #include "GUITexture.h"
+#include "rendering/gl/RenderSystemGL.h"
 #include "utils/Color.h"
 
-class CRenderSystemGL;
+#include <vector>
 
 class CGUITextureGL : public CGUITextureBase
 {
@@ -27,17 +28,8 @@ protected:
   void End() override;
 
 private:
-  GLubyte m_col[4];
-
-  struct PackedVertex
-  {
-    float x, y, z;
-    float u1, v1;
-    float u2, v2;
-  };
-
-  std::vector<PackedVertex> m_packedVertices;
-  std::vector<GLushort> m_idx;
+  SGUIBatchState m_batchState;
+  std::vector<SGUIBatchVertex> m_packedVertices;
   CRenderSystemGL *m_renderSystem;
 };
 
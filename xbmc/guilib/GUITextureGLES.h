@@ -12,18 +12,9 @@
 
 #include "system_gl.h"
 #include <vector>
+#include "rendering/gles/RenderSystemGLES.h"
 #include "utils/Color.h"
 
-struct PackedVertex
-{
-  float x, y, z;
-  float u1, v1;
-  float u2, v2;
-};
-typedef std::vector<PackedVertex> PackedVertices;
-
-class CRenderSystemGLES;
-
 class CGUITextureGLES : public CGUITextureBase
 {
 public:
@@ -34,10 +25,8 @@ protected:
   void Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation);
   void End();
 
-  GLubyte m_col[4];
-
-  PackedVertices m_packedVertices;
-  std::vector<GLushort> m_idx;
+  SGUIBatchState m_batchState;
+  std::vector<SGUIBatchVertex> m_packedVertices;
   CRenderSystemGLES *m_renderSystem;
 };
 
@@ -131,7 +131,12 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
     CXBMCTinyXML xmlDoc;
     std::string strPathLower = strPath;
     StringUtils::ToLower(strPathLower);
-    if (!xmlDoc.LoadFile(strPath) && !xmlDoc.LoadFile(strPathLower) && !xmlDoc.LoadFile(strLowerPath))
+    // the skin may have parsed the file already
+    auto loadFile = [&xmlDoc](const std::string &path)
+    {
+      return g_SkinInfo ? g_SkinInfo->LoadSkinXML(path, xmlDoc) : xmlDoc.LoadFile(path);
+    };
+    if (!loadFile(strPath) && !loadFile(strPathLower) && !loadFile(strLowerPath))
     {
       CLog::Log(LOGERROR, "Unable to load window XML: %s. Line %d\n%s", strPath.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorDesc());
       SetID(WINDOW_INVALID);
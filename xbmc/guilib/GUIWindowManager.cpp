@@ -1164,11 +1164,34 @@ void CGUIWindowManager::RenderEx() const
   */
 }
 
+bool CGUIWindowManager::UsePartialPresent() const
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (!advancedSettings->m_guiPartialPresent || advancedSettings->m_guiVisualizeDirtyRegions)
+    return false;
+  if (advancedSettings->m_guiAlgorithmDirtyRegions != DIRTYREGION_SOLVER_UNION &&
+      advancedSettings->m_guiAlgorithmDirtyRegions != DIRTYREGION_SOLVER_COST_REDUCTION)
+    return false;
+
+  // without the age every frame would be a full redraw, the preserved back
+  // buffer of the regular dirty region rendering does better
+  if (!CServiceBroker::GetWinSystem()->SupportsBufferAge())
+    return false;
+
+  // stereo views render the windows twice per frame, and video is drawn
+  // outside of the controls' dirty regions
+  return CServiceBroker::GetWinSystem()->GetGfxContext().GetStereoMode() == RENDER_STEREO_MODE_OFF &&
+         !g_application.GetAppPlayer().IsRenderingVideo();
+}
+
 bool CGUIWindowManager::Render()
 {
   assert(g_application.IsCurrentThread());
   CSingleExit lock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
+  bool partialPresent = UsePartialPresent();
+  m_tracker.SetBufferAge(partialPresent ? CServiceBroker::GetWinSystem()->GetBufferAge() : -1);
+
   CDirtyRegionList dirtyRegions = m_tracker.GetDirtyRegions();
 
   bool hasRendered = false;
@@ -1186,6 +1209,31 @@ bool CGUIWindowManager::Render()
       hasRendered = true;
     }
   }
+  else if (partialPresent)
+  {
+    // if nothing changed since the last presented frame it is still on
+    // screen, otherwise bring the back buffer up to date with it
+    CDirtyRegionList damage = m_tracker.GetFrameDamage();
+    if (!damage.empty())
+    {
+      if (m_tracker.NeedsFullRedraw())
+        RenderPass();
+      else
+      {
+        for (const auto& region : dirtyRegions)
+        {
+          if (region.IsEmpty())
+            continue;
+
+          CServiceBroker::GetWinSystem()->GetGfxContext().SetScissors(region);
+          RenderPass();
+        }
+        CServiceBroker::GetWinSystem()->GetGfxContext().ResetScissors();
+      }
+      CServiceBroker::GetWinSystem()->SetPresentDamage(damage);
+      hasRendered = true;
+    }
+  }
   else
   {
     for (CDirtyRegionList::const_iterator i = dirtyRegions.begin(); i != dirtyRegions.end(); ++i)
@@ -1210,12 +1258,13 @@ bool CGUIWindowManager::Render()
       CGUITexture::DrawQuad(*i, 0x4c00ff00);
   }
 
+  m_presented = hasRendered;
   return hasRendered;
 }
 
 void CGUIWindowManager::AfterRender()
 {
-  m_tracker.CleanMarkedRegions();
+  m_tracker.CleanMarkedRegions(m_presented);
 
   CGUIWindow* pWindow = GetWindow(GetActiveWindow());
   if (pWindow)
@@ -217,6 +217,9 @@ public:
 private:
   void RenderPass() const;
 
+  /*! \brief Whether to redraw and present only what changed since the back buffer was last on screen */
+  bool UsePartialPresent() const;
+
   void LoadNotOnDemandWindows();
   void UnloadNotOnDemandWindows();
   void AddToWindowHistory(int newWindowID);
@@ -267,4 +270,5 @@ private:
 
   CDirtyRegionList m_dirtyregions;
   CDirtyRegionTracker m_tracker;
+  bool m_presented = false;
 };
@@ -0,0 +1,104 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIXMLCache.h"
+#include "filesystem/SpecialProtocol.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+
+class CGUIXMLCache::CEntry
+{
+public:
+  CEvent m_done{true};
+  std::unique_ptr<TiXmlElement> m_root;
+};
+
+CGUIXMLCache::~CGUIXMLCache()
+{
+  Clear();
+}
+
+std::string CGUIXMLCache::GetKey(const std::string& file)
+{
+  // skin files are looked up with differing case, see CGUIWindow::LoadXML
+  std::string key = CSpecialProtocol::TranslatePath(file);
+  StringUtils::ToLower(key);
+  return key;
+}
+
+void CGUIXMLCache::Prefetch(const std::vector<std::string>& files)
+{
+  CSingleLock lock(m_critSection);
+  for (const auto& file : files)
+  {
+    std::string key = GetKey(file);
+    if (m_entries.find(key) != m_entries.end())
+      continue;
+
+    // the job keeps the entry alive, so Clear() doesn't have to wait for it
+    auto entry = std::make_shared<CEntry>();
+    m_entries.insert(std::make_pair(key, entry));
+    CJobManager::GetInstance().Submit([entry, file]() {
+      CXBMCTinyXML doc;
+      if (doc.LoadFile(file) && doc.RootElement())
+        entry->m_root.reset(static_cast<TiXmlElement*>(doc.RootElement()->Clone()));
+      entry->m_done.Set();
+    }, CJob::PRIORITY_HIGH);
+  }
+}
+
+bool CGUIXMLCache::LoadFile(const std::string& file, CXBMCTinyXML& doc)
+{
+  std::shared_ptr<CEntry> entry;
+  {
+    CSingleLock lock(m_critSection);
+    auto it = m_entries.find(GetKey(file));
+    if (it != m_entries.end())
+    {
+      entry = it->second;
+      m_entries.erase(it);
+    }
+  }
+
+  if (entry)
+  {
+    entry->m_done.Wait();
+    if (entry->m_root)
+    {
+      doc.Clear();
+      doc.LinkEndChild(entry->m_root.release());
+
+      CSingleLock lock(m_critSection);
+      m_hits++;
+      return true;
+    }
+  }
+
+  // not prefetched or not parsable, load it here to get the error details
+  {
+    CSingleLock lock(m_critSection);
+    m_misses++;
+  }
+  return doc.LoadFile(file);
+}
+
+void CGUIXMLCache::Clear()
+{
+  CSingleLock lock(m_critSection);
+  if (m_hits || m_misses || !m_entries.empty())
+    CLog::Log(LOGDEBUG, "CGUIXMLCache::%s - %u prefetched files used, %u loaded directly, %u unused",
+              __FUNCTION__, m_hits, m_misses, static_cast<unsigned int>(m_entries.size()));
+
+  m_entries.clear();
+  m_hits = 0;
+  m_misses = 0;
+}
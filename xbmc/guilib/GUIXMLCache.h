@@ -0,0 +1,59 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+class CXBMCTinyXML;
+
+/*!
+ \ingroup guilib
+ \brief Parses skin XML files ahead of use on the job manager's worker threads
+
+ Prefetch() queues one job per file. LoadFile() hands out the parsed tree,
+ waiting for its job if it hasn't finished yet, and falls back to parsing
+ the file itself for files that weren't prefetched. Every prefetched tree
+ is handed out once, later loads of the same file read it from disk again.
+ */
+class CGUIXMLCache
+{
+public:
+  CGUIXMLCache() = default;
+  ~CGUIXMLCache();
+
+  /*! \brief Queue files for parsing on the worker threads
+   \param files paths of the files to parse
+   */
+  void Prefetch(const std::vector<std::string>& files);
+
+  /*! \brief Load a file, taking its tree from the cache if it was prefetched
+   \param file path of the file to load
+   \param doc [out] document to load the file into
+   \return true if the file was loaded, false otherwise
+   */
+  bool LoadFile(const std::string& file, CXBMCTinyXML& doc);
+
+  /*! \brief Drop all prefetched trees that haven't been handed out yet */
+  void Clear();
+
+private:
+  class CEntry;
+
+  static std::string GetKey(const std::string& file);
+
+  std::map<std::string, std::shared_ptr<CEntry>> m_entries;
+  unsigned int m_hits = 0;
+  unsigned int m_misses = 0;
+  CCriticalSection m_critSection;
+};
@@ -341,6 +341,11 @@ bool CGLSLShaderProgram::Enable()
 {
   if (OK())
   {
+    // queued GUI quads have to be drawn before anything rendered with this program
+    CRenderSystemBase* renderSystem = CServiceBroker::GetRenderSystem();
+    if (renderSystem)
+      renderSystem->FlushGUIBatch();
+
     glUseProgram(m_shaderProgram);
     if (OnEnabled())
     {
@@ -83,11 +83,18 @@ public:
   virtual void LoadToGPU() = 0;
   virtual void BindToUnit(unsigned int unit) = 0;
 
+  /*! \brief Map a buffer the next LoadToGPU() uploads from instead of the pixels
+   The buffer may be filled from any thread, LoadToGPU() has to be called on the render thread afterwards.
+   \return buffer for GetPitch() * GetRows() bytes, nullptr if the renderer uploads the pixels directly
+   */
+  virtual unsigned char* MapUploadBuffer() { return nullptr; }
+
   unsigned char* GetPixels() const { return m_pixels; }
   unsigned int GetPitch() const { return GetPitch(m_textureWidth); }
   unsigned int GetRows() const { return GetRows(m_textureHeight); }
   unsigned int GetTextureWidth() const { return m_textureWidth; }
   unsigned int GetTextureHeight() const { return m_textureHeight; }
+  unsigned int GetFormat() const { return m_format; }
   unsigned int GetWidth() const { return m_imageWidth; }
   unsigned int GetHeight() const { return m_imageHeight; }
   /*! \brief return the original width of the image, before scaling/cropping */
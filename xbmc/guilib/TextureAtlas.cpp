@@ -0,0 +1,212 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureAtlas.h"
+#include "ServiceBroker.h"
+#include "TextureManager.h"
+#include "rendering/RenderSystem.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+#define ATLAS_PAGE_SIZE 1024
+#define ATLAS_MAX_IMAGE_SIZE 256
+// border of repeated edge pixels around every image, so that linear
+// filtering doesn't pick up the neighbouring images
+#define ATLAS_PADDING 1
+
+CTextureAtlasPage::CTextureAtlasPage(unsigned int size)
+  : CTexture(size, size, XB_FMT_A8R8G8B8)
+  , m_size(size)
+  , m_shadow(size * size, 0)
+{
+}
+
+void CTextureAtlasPage::LoadToGPU()
+{
+  if (m_dirty)
+  {
+    Update(m_size, m_size, m_size * 4, XB_FMT_A8R8G8B8, reinterpret_cast<const unsigned char*>(m_shadow.data()), false);
+    m_dirty = false;
+  }
+  CTexture::LoadToGPU();
+}
+
+bool CTextureAtlasPage::Reserve(unsigned int width, unsigned int height, Region& region)
+{
+  // reuse the region of a released image first
+  for (auto it = m_freeRegions.begin(); it != m_freeRegions.end(); ++it)
+  {
+    if (it->width >= width && it->height >= height)
+    {
+      region = *it;
+      m_freeRegions.erase(it);
+      return true;
+    }
+  }
+
+  // then the lowest shelf with enough room left
+  Shelf* best = nullptr;
+  for (auto& shelf : m_shelves)
+  {
+    if (shelf.height >= height && m_size - shelf.x >= width &&
+        (!best || shelf.height < best->height))
+      best = &shelf;
+  }
+
+  // don't waste a tall shelf on a small image while there is room for a new one
+  unsigned int top = m_shelves.empty() ? 0 : m_shelves.back().y + m_shelves.back().height;
+  if ((!best || best->height > 2 * height) && m_size - top >= height && width <= m_size)
+  {
+    m_shelves.push_back({top, height, 0});
+    best = &m_shelves.back();
+  }
+
+  if (!best)
+    return false;
+
+  region.x = best->x;
+  region.y = best->y;
+  region.width = width;
+  region.height = best->height;
+  best->x += width;
+  return true;
+}
+
+bool CTextureAtlasPage::Insert(const CBaseTexture& texture, unsigned int& x, unsigned int& y)
+{
+  unsigned int width = texture.GetWidth();
+  unsigned int height = texture.GetHeight();
+
+  Region region;
+  if (!Reserve(width + 2 * ATLAS_PADDING, height + 2 * ATLAS_PADDING, region))
+    return false;
+
+  region.imageWidth = width;
+  region.imageHeight = height;
+  m_regions.push_back(region);
+  m_usedPixels += width * height;
+
+  x = region.x + ATLAS_PADDING;
+  y = region.y + ATLAS_PADDING;
+
+  const unsigned char* pixels = texture.GetPixels();
+  unsigned int pitch = texture.GetPitch();
+  for (int row = -ATLAS_PADDING; row < static_cast<int>(height) + ATLAS_PADDING; ++row)
+  {
+    int srcRow = std::min(std::max(row, 0), static_cast<int>(height) - 1);
+    const uint32_t* src = reinterpret_cast<const uint32_t*>(pixels + srcRow * pitch);
+    uint32_t* dst = &m_shadow[(y + row) * m_size + x];
+
+    memcpy(dst, src, width * 4);
+    for (int col = 1; col <= ATLAS_PADDING; ++col)
+    {
+      dst[-col] = src[0];
+      dst[width - 1 + col] = src[width - 1];
+    }
+  }
+
+  m_dirty = true;
+  return true;
+}
+
+void CTextureAtlasPage::Remove(unsigned int x, unsigned int y)
+{
+  for (auto it = m_regions.begin(); it != m_regions.end(); ++it)
+  {
+    if (it->x + ATLAS_PADDING == x && it->y + ATLAS_PADDING == y)
+    {
+      m_usedPixels -= it->imageWidth * it->imageHeight;
+      m_freeRegions.push_back(*it);
+      m_regions.erase(it);
+      return;
+    }
+  }
+}
+
+CTextureAtlas::~CTextureAtlas() = default;
+
+bool CTextureAtlas::CanPack(const CBaseTexture& texture)
+{
+  return texture.GetPixels() != nullptr &&
+         texture.GetFormat() == XB_FMT_A8R8G8B8 &&
+         texture.GetWidth() > 0 && texture.GetWidth() <= ATLAS_MAX_IMAGE_SIZE &&
+         texture.GetHeight() > 0 && texture.GetHeight() <= ATLAS_MAX_IMAGE_SIZE &&
+         !texture.IsMipmapped() &&
+         texture.GetScalingMethod() == TEXTURE_SCALING::LINEAR &&
+         texture.GetOrientation() == 0;
+}
+
+bool CTextureAtlas::Add(const CBaseTexture& texture, CTextureArray& array)
+{
+  if (!CanPack(texture))
+    return false;
+
+  unsigned int x = 0, y = 0;
+  CTextureAtlasPage* page = nullptr;
+  for (auto& candidate : m_pages)
+  {
+    if (candidate->Insert(texture, x, y))
+    {
+      page = candidate.get();
+      break;
+    }
+  }
+
+  if (!page)
+  {
+    unsigned int size = std::min<unsigned int>(ATLAS_PAGE_SIZE, CServiceBroker::GetRenderSystem()->GetMaxTextureSize());
+    if (size < ATLAS_MAX_IMAGE_SIZE + 2 * ATLAS_PADDING)
+      return false;
+
+    m_pages.emplace_back(new CTextureAtlasPage(size));
+    page = m_pages.back().get();
+    if (!page->Insert(texture, x, y))
+      return false;
+  }
+
+  array.Add(page, 100);
+  array.m_texCoordsOffset = CPoint(static_cast<float>(x) / page->GetSize(), static_cast<float>(y) / page->GetSize());
+  return true;
+}
+
+void CTextureAtlas::Release(const CTextureArray& array)
+{
+  if (array.m_textures.empty())
+    return;
+
+  for (auto it = m_pages.begin(); it != m_pages.end(); ++it)
+  {
+    CTextureAtlasPage* page = it->get();
+    if (page != array.m_textures[0])
+      continue;
+
+    unsigned int x = static_cast<unsigned int>(std::lround(array.m_texCoordsOffset.x * page->GetSize()));
+    unsigned int y = static_cast<unsigned int>(std::lround(array.m_texCoordsOffset.y * page->GetSize()));
+    page->Remove(x, y);
+    if (page->IsEmpty())
+      m_pages.erase(it);
+    return;
+  }
+}
+
+void CTextureAtlas::Dump() const
+{
+  uint64_t used = 0, total = 0;
+  unsigned int images = 0;
+  for (const auto& page : m_pages)
+  {
+    used += page->GetUsedPixels();
+    total += static_cast<uint64_t>(page->GetSize()) * page->GetSize();
+    images += page->GetImageCount();
+  }
+
+  CLog::Log(LOGDEBUG, "{0}: {1} textures in {2} atlas pages, {3:.1f}% used", __FUNCTION__,
+    images, m_pages.size(), total ? 100.0 * used / total : 0.0);
+}
@@ -0,0 +1,115 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "Texture.h"
+
+#include <memory>
+#include <stdint.h>
+#include <vector>
+
+class CTextureArray;
+
+/*!
+ \ingroup textures
+ \brief Page of a texture atlas
+
+ Keeps a copy of its pixels in system memory, so that images can be added
+ after the page has been uploaded. Changes are uploaded with the next
+ LoadToGPU().
+ */
+class CTextureAtlasPage : public CTexture
+{
+public:
+  explicit CTextureAtlasPage(unsigned int size);
+
+  void LoadToGPU() override;
+
+  /*! \brief Copy an image into a free region of the page
+   \param texture the image, has to hold its pixels in A8R8G8B8 format
+   \param x [out] left edge of the image within the page
+   \param y [out] top edge of the image within the page
+   \return true if the image was copied, false if the page is full
+   */
+  bool Insert(const CBaseTexture& texture, unsigned int& x, unsigned int& y);
+
+  /*! \brief Free the region of an image added with Insert() */
+  void Remove(unsigned int x, unsigned int y);
+
+  bool IsEmpty() const { return m_regions.empty(); }
+  unsigned int GetSize() const { return m_size; }
+  unsigned int GetImageCount() const { return m_regions.size(); }
+  uint64_t GetUsedPixels() const { return m_usedPixels; }
+
+private:
+  struct Region
+  {
+    unsigned int x;
+    unsigned int y;
+    unsigned int width;
+    unsigned int height;
+    unsigned int imageWidth;
+    unsigned int imageHeight;
+  };
+
+  struct Shelf
+  {
+    unsigned int y;
+    unsigned int height;
+    unsigned int x;
+  };
+
+  bool Reserve(unsigned int width, unsigned int height, Region& region);
+
+  unsigned int m_size;
+  std::vector<uint32_t> m_shadow;
+  std::vector<Shelf> m_shelves;
+  std::vector<Region> m_regions;
+  std::vector<Region> m_freeRegions;
+  uint64_t m_usedPixels = 0;
+  bool m_dirty = true;
+};
+
+/*!
+ \ingroup textures
+ \brief Packs small textures into shared pages
+
+ Skins use many small images for buttons, icons and borders. Drawing them
+ from a few large textures avoids switching textures between controls and
+ lets the renderer draw neighbouring controls together.
+ */
+class CTextureAtlas
+{
+public:
+  CTextureAtlas() = default;
+  ~CTextureAtlas();
+
+  /*! \brief Check whether a texture may be packed into the atlas
+   \param texture the texture to check
+   \return true if the texture is small enough and holds A8R8G8B8 pixels
+   */
+  static bool CanPack(const CBaseTexture& texture);
+
+  /*! \brief Copy a texture into an atlas page
+   On success the page is added to the texture array, with the texture
+   coordinates offset to the region holding the image.
+   \param texture the texture to pack
+   \param array [in/out] empty texture array to add the page to
+   \return true if the texture was packed
+   */
+  bool Add(const CBaseTexture& texture, CTextureArray& array);
+
+  /*! \brief Free the region of a texture array set up by Add() */
+  void Release(const CTextureArray& array);
+
+  void Dump() const;
+
+private:
+  std::vector<std::unique_ptr<CTextureAtlasPage>> m_pages;
+};
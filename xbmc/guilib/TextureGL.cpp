@@ -44,6 +44,37 @@ void CGLTexture::DestroyTextureObject()
 {
   if (m_texture)
     CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_texture);
+
+  // deleting the buffer unmaps it as well
+  if (m_uploadBuffer)
+  {
+    glDeleteBuffers(1, &m_uploadBuffer);
+    m_uploadBuffer = 0;
+  }
+}
+
+unsigned char* CGLTexture::MapUploadBuffer()
+{
+#ifndef HAS_GLES
+  if (!m_pixels || m_uploadBuffer || !m_isOglVersion3orNewer)
+    return nullptr;
+
+  GLsizeiptr size = GetPitch() * GetRows();
+  glGenBuffers(1, &m_uploadBuffer);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadBuffer);
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW);
+  void* buffer = glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT);
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  if (!buffer)
+  {
+    glDeleteBuffers(1, &m_uploadBuffer);
+    m_uploadBuffer = 0;
+  }
+  return static_cast<unsigned char*>(buffer);
+#else
+  return nullptr;
+#endif
 }
 
 void CGLTexture::LoadToGPU()
@@ -103,6 +134,16 @@ void CGLTexture::LoadToGPU()
   }
 
 #ifndef HAS_GLES
+  const unsigned char* pixels = m_pixels;
+  if (m_uploadBuffer)
+  {
+    // the pixels were copied to the upload buffer already, the driver
+    // transfers them to the texture without stalling the render thread
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_uploadBuffer);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    pixels = nullptr;
+  }
+
   GLenum format = GL_BGRA;
   GLint numcomponents = GL_RGBA;
 
@@ -131,13 +172,13 @@ void CGLTexture::LoadToGPU()
   {
     glTexImage2D(GL_TEXTURE_2D, 0, numcomponents,
                  m_textureWidth, m_textureHeight, 0,
-                 format, GL_UNSIGNED_BYTE, m_pixels);
+                 format, GL_UNSIGNED_BYTE, pixels);
   }
   else
   {
     glCompressedTexImage2D(GL_TEXTURE_2D, 0, format,
                            m_textureWidth, m_textureHeight, 0,
-                           GetPitch() * GetRows(), m_pixels);
+                           GetPitch() * GetRows(), pixels);
   }
 
   if (IsMipmapped() && m_isOglVersion3orNewer)
@@ -147,6 +188,13 @@ void CGLTexture::LoadToGPU()
 
   glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 
+  if (m_uploadBuffer)
+  {
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    glDeleteBuffers(1, &m_uploadBuffer);
+    m_uploadBuffer = 0;
+  }
+
 #else	// GLES version
 
   // All incoming textures are BGRA, which GLES does not necessarily support.
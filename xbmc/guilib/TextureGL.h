@@ -25,9 +25,13 @@ public:
   void DestroyTextureObject() override;
   void LoadToGPU() override;
   void BindToUnit(unsigned int unit) override;
+  unsigned char* MapUploadBuffer() override;
+
+  GLuint GetTextureObject() const { return m_texture; }
 
 protected:
   GLuint m_texture = 0;
   bool m_isOglVersion3orNewer = false;
+  GLuint m_uploadBuffer = 0; ///< pixel buffer object LoadToGPU() uploads from, if mapped
 };
 
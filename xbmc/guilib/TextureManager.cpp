@@ -11,8 +11,11 @@
 #include <cassert>
 
 #include "addons/Skin.h"
+#include "ServiceBroker.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "windowing/GraphicContext.h"
 #include "Texture.h"
 #include "threads/SingleLock.h"
@@ -43,6 +46,7 @@ CTextureArray::CTextureArray(int width, int height, int loops,  bool texCoordsAr
   m_texWidth = 0;
   m_texHeight = 0;
   m_texCoordsArePixels = false;
+  m_texCoordsOffset = CPoint();
 }
 
 CTextureArray::CTextureArray()
@@ -69,6 +73,7 @@ void CTextureArray::Reset()
   m_texWidth = 0;
   m_texHeight = 0;
   m_texCoordsArePixels = false;
+  m_texCoordsOffset = CPoint();
 }
 
 void CTextureArray::Add(CBaseTexture *texture, int delay)
@@ -180,7 +185,16 @@ void CTextureMap::Flush()
 
 void CTextureMap::FreeTexture()
 {
-  m_texture.Free();
+  if (m_atlas)
+  {
+    // the atlas page is shared with other textures, only give back our region
+    CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
+    m_atlas->Release(m_texture);
+    m_atlas = nullptr;
+    m_texture.Reset();
+  }
+  else
+    m_texture.Free();
 }
 
 void CTextureMap::SetHeight(int height)
@@ -206,6 +220,16 @@ void CTextureMap::Add(CBaseTexture* texture, int delay)
     m_memUsage += sizeof(CTexture) + (texture->GetTextureWidth() * texture->GetTextureHeight() * 4);
 }
 
+bool CTextureMap::AddToAtlas(const CBaseTexture& texture, CTextureAtlas& atlas)
+{
+  if (!m_texture.m_textures.empty() || !atlas.Add(texture, m_texture))
+    return false;
+
+  m_atlas = &atlas;
+  m_memUsage += texture.GetWidth() * texture.GetHeight() * 4;
+  return true;
+}
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -442,7 +466,10 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
   if (!pTexture) return emptyTexture;
 
   CTextureMap* pMap = new CTextureMap(strTextureName, width, height, 0);
-  pMap->Add(pTexture, 100);
+  if (bundle >= 0 && CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureAtlas && pMap->AddToAtlas(*pTexture, m_atlas))
+    delete pTexture;
+  else
+    pMap->Add(pTexture, 100);
   m_vecTextures.push_back(pMap);
 
 #ifdef _DEBUG_TEXTURES
@@ -550,6 +577,8 @@ void CGUITextureManager::Dump() const
     if (!pMap->IsEmpty())
       pMap->Dump();
   }
+
+  m_atlas.Dump();
 }
 
 void CGUITextureManager::Flush()
@@ -12,8 +12,10 @@
 #include <vector>
 #include <utility>
 
+#include "TextureAtlas.h"
 #include "TextureBundle.h"
 #include "threads/CriticalSection.h"
+#include "utils/Geometry.h"
 
 #include "GUIComponent.h"
 
@@ -44,6 +46,7 @@ public:
   int m_texWidth;
   int m_texHeight;
   bool m_texCoordsArePixels;
+  CPoint m_texCoordsOffset; ///< offset of the image within the texture, for textures packed into an atlas
 };
 
 /*!
@@ -61,6 +64,7 @@ public:
   virtual ~CTextureMap();
 
   void Add(CBaseTexture* texture, int delay);
+  bool AddToAtlas(const CBaseTexture& texture, CTextureAtlas& atlas);
   bool Release();
 
   const std::string& GetName() const;
@@ -78,6 +82,7 @@ protected:
   std::string m_textureName;
   unsigned int m_referenceCount;
   uint32_t m_memUsage;
+  CTextureAtlas* m_atlas = nullptr;
 };
 
 /*!
@@ -118,6 +123,7 @@ protected:
   typedef std::list<std::pair<CTextureMap*, unsigned int> >::iterator ilistUnused;
   // we have 2 texture bundles (one for the base textures, one for the theme)
   CTextureBundle m_TexBundle[2];
+  CTextureAtlas m_atlas;
 
   std::vector<std::string> m_texturePaths;
   CCriticalSection m_section;
@@ -30,6 +30,8 @@ public:
   void UpdateAVInfo(const AudioStreamInfo& audioInfo, const VideoStreamInfo& videoInfo, const SubtitleStreamInfo& subtitleInfo) override
   { m_audioInfo = audioInfo, m_videoInfo = videoInfo, m_subtitleInfo = subtitleInfo; }
 
+  const std::atomic<unsigned int>* GetBoolChangeCounter(const CGUIInfo &info) const override { return nullptr; }
+
 protected:
   VideoStreamInfo m_videoInfo;
   AudioStreamInfo m_audioInfo;
@@ -107,6 +107,17 @@ bool CGUIInfoProviders::GetBool(bool& value, const CGUIListItem *item, int conte
   return false;
 }
 
+const std::atomic<unsigned int>* CGUIInfoProviders::GetBoolChangeCounter(const CGUIInfo &info) const
+{
+  for (const auto& provider : m_providers)
+  {
+    const std::atomic<unsigned int>* counter = provider->GetBoolChangeCounter(info);
+    if (counter)
+      return counter;
+  }
+  return nullptr;
+}
+
 void CGUIInfoProviders::UpdateAVInfo(const AudioStreamInfo& audioInfo, const VideoStreamInfo& videoInfo, const SubtitleStreamInfo& subtitleInfo)
 {
   for (const auto& provider : m_providers)
@@ -97,6 +97,13 @@ public:
    */
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const;
 
+  /*!
+   * @brief Get the change counter of a GUIInfoManager bool value from one of the registered providers.
+   * @param info The GUI info (label id + additional data).
+   * @return The change counter, nullptr if none of the providers signals changes of the value.
+   */
+  const std::atomic<unsigned int>* GetBoolChangeCounter(const CGUIInfo &info) const;
+
   /*!
    * @brief Set new audio/video/subtitle stream info data at all registered providers.
    * @param audioInfo New audio stream info.
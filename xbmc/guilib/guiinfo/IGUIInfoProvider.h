@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 class CFileItem;
@@ -68,6 +69,14 @@ public:
    */
   virtual bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const = 0;
 
+  /*!
+   * @brief Get the change counter of a GUIInfoManager bool value. The provider increments the counter
+   * whenever the value may have changed, so bools depending on it need not be evaluated every frame.
+   * @param info The GUI info (label id + additional data).
+   * @return The change counter, nullptr if the provider does not signal changes of the value.
+   */
+  virtual const std::atomic<unsigned int>* GetBoolChangeCounter(const CGUIInfo &info) const = 0;
+
   /*!
    * @brief Set new audio/video stream info data.
    * @param audioInfo New audio stream info.
@@ -56,8 +56,9 @@ void CLibraryGUIInfo::SetLibraryBool(int condition, bool value)
       m_libraryHasCompilations = value ? 1 : 0;
       break;
     default:
-      break;
+      return;
   }
+  ++m_libraryChangeCounter;
 }
 
 void CLibraryGUIInfo::ResetLibraryBools()
@@ -70,6 +71,28 @@ void CLibraryGUIInfo::ResetLibraryBools()
   m_libraryHasSingles = -1;
   m_libraryHasCompilations = -1;
   m_libraryRoleCounts.clear();
+  ++m_libraryChangeCounter;
+}
+
+const std::atomic<unsigned int>* CLibraryGUIInfo::GetBoolChangeCounter(const CGUIInfo &info) const
+{
+  switch (info.m_info)
+  {
+    // the library bools are only re-queried after SetLibraryBool() or ResetLibraryBools(),
+    // or when the database couldn't be opened
+    case LIBRARY_HAS_MUSIC:
+    case LIBRARY_HAS_MOVIES:
+    case LIBRARY_HAS_MOVIE_SETS:
+    case LIBRARY_HAS_TVSHOWS:
+    case LIBRARY_HAS_MUSICVIDEOS:
+    case LIBRARY_HAS_SINGLES:
+    case LIBRARY_HAS_COMPILATIONS:
+    case LIBRARY_HAS_VIDEO:
+    case LIBRARY_HAS_ROLE:
+      return &m_libraryChangeCounter;
+  }
+
+  return nullptr;
 }
 
 bool CLibraryGUIInfo::InitCurrentItem(CFileItem *item)
@@ -104,6 +127,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           m_libraryHasMusic = (db.GetSongsCount() > 0) ? 1 : 0;
           db.Close();
         }
+        else
+          ++m_libraryChangeCounter;
       }
       value = m_libraryHasMusic > 0;
       return true;
@@ -118,6 +143,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           m_libraryHasMovies = db.HasContent(VIDEODB_CONTENT_MOVIES) ? 1 : 0;
           db.Close();
         }
+        else
+          ++m_libraryChangeCounter;
       }
       value = m_libraryHasMovies > 0;
       return true;
@@ -132,6 +159,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           m_libraryHasMovieSets = db.HasSets() ? 1 : 0;
           db.Close();
         }
+        else
+          ++m_libraryChangeCounter;
       }
       value = m_libraryHasMovieSets > 0;
       return true;
@@ -146,6 +175,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           m_libraryHasTVShows = db.HasContent(VIDEODB_CONTENT_TVSHOWS) ? 1 : 0;
           db.Close();
         }
+        else
+          ++m_libraryChangeCounter;
       }
       value = m_libraryHasTVShows > 0;
       return true;
@@ -160,6 +191,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           m_libraryHasMusicVideos = db.HasContent(VIDEODB_CONTENT_MUSICVIDEOS) ? 1 : 0;
           db.Close();
         }
+        else
+          ++m_libraryChangeCounter;
       }
       value = m_libraryHasMusicVideos > 0;
       return true;
@@ -174,6 +207,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           m_libraryHasSingles = (db.GetSinglesCount() > 0) ? 1 : 0;
           db.Close();
         }
+        else
+          ++m_libraryChangeCounter;
       }
       value = m_libraryHasSingles > 0;
       return true;
@@ -188,6 +223,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           m_libraryHasCompilations = (db.GetCompilationAlbumsCount() > 0) ? 1 : 0;
           db.Close();
         }
+        else
+          ++m_libraryChangeCounter;
       }
       value = m_libraryHasCompilations > 0;
       return true;
@@ -221,6 +258,8 @@ bool CLibraryGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contex
           db.Close();
           m_libraryRoleCounts.emplace_back(std::make_pair(strRole, artistcount));
         }
+        else
+          ++m_libraryChangeCounter;
       }
       value = artistcount > 0;
       return true;
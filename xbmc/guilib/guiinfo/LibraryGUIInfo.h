@@ -34,6 +34,7 @@ public:
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const override;
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
+  const std::atomic<unsigned int>* GetBoolChangeCounter(const CGUIInfo &info) const override;
 
   bool GetLibraryBool(int condition) const;
   void SetLibraryBool(int condition, bool value);
@@ -51,6 +52,8 @@ private:
   //Count of artists in music library contributing to song by role e.g. composers, conductors etc.
   //For checking visibility of custom nodes for a role.
   mutable std::vector<std::pair<std::string, int>> m_libraryRoleCounts;
+
+  mutable std::atomic<unsigned int> m_libraryChangeCounter{0};
 };
 
 } // namespace GUIINFO
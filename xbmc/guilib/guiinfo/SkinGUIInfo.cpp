@@ -116,3 +116,16 @@ bool CSkinGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contextWi
 
   return false;
 }
+
+const std::atomic<unsigned int>* CSkinGUIInfo::GetBoolChangeCounter(const CGUIInfo &info) const
+{
+  switch (info.m_info)
+  {
+    case SKIN_BOOL:
+    case SKIN_STRING_IS_EQUAL:
+    case SKIN_STRING:
+      return &CSkinSettings::GetInstance().GetChangeCounter();
+  }
+
+  return nullptr;
+}
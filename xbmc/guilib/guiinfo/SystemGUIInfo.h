@@ -32,6 +32,7 @@ public:
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const override;
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
+  const std::atomic<unsigned int>* GetBoolChangeCounter(const CGUIInfo &info) const override;
 
   float GetFPS() const { return m_fps; };
   void UpdateFPS();
@@ -49,6 +50,7 @@ private:
   float m_fps = 0.0;
   unsigned int m_frameCounter = 0;
   unsigned int m_lastFPSTime = 0;
+  std::atomic<unsigned int> m_constantCounter{0}; ///< never changes, for bools with a constant value
 };
 
 } // namespace GUIINFO
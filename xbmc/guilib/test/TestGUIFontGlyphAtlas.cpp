@@ -0,0 +1,213 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUIFontGlyphAtlas.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include <ft2build.h>
+#include FT_FREETYPE_H
+
+#include "gtest/gtest.h"
+
+namespace
+{
+// filled square of the given size, the way FreeType hands out a glyph bitmap
+std::vector<unsigned char> Square(unsigned int size)
+{
+  return std::vector<unsigned char>(size * size, 255);
+}
+}
+
+TEST(TestGUIFontGlyphAtlas, DistanceField)
+{
+  CGUIFontGlyphAtlas atlas;
+  std::vector<unsigned char> coverage = Square(8);
+  const CGUIFontGlyphAtlas::Glyph* glyph = atlas.Add('A', coverage.data(), 8, 8, 8, 1, 10, 9.0f);
+  ASSERT_TRUE(glyph != nullptr);
+
+  // the field extends SPREAD pixels beyond the bitmap on each side
+  EXPECT_EQ(8 + 2 * CGUIFontGlyphAtlas::SPREAD, glyph->width);
+  EXPECT_EQ(8 + 2 * CGUIFontGlyphAtlas::SPREAD, glyph->height);
+  EXPECT_EQ(1.0f - CGUIFontGlyphAtlas::SPREAD, glyph->left);
+  EXPECT_EQ(10.0f + CGUIFontGlyphAtlas::SPREAD, glyph->top);
+  EXPECT_EQ(9.0f, glyph->advance);
+
+  const unsigned char* pixels = atlas.GetPixels();
+  unsigned int pitch = atlas.GetWidth();
+  unsigned int centre = glyph->x + glyph->width / 2;
+  unsigned int middle = glyph->y + glyph->height / 2;
+
+  // inside above 128, outside below, falling off towards the border
+  EXPECT_GT(pixels[middle * pitch + centre], 128);
+  EXPECT_LT(pixels[glyph->y * pitch + glyph->x], 128);
+  EXPECT_GT(pixels[middle * pitch + glyph->x + CGUIFontGlyphAtlas::SPREAD],
+            pixels[middle * pitch + glyph->x + CGUIFontGlyphAtlas::SPREAD - 1]);
+
+  EXPECT_EQ(glyph, atlas.Find('A'));
+  EXPECT_EQ(nullptr, atlas.Find('B'));
+}
+
+TEST(TestGUIFontGlyphAtlas, EmptyGlyph)
+{
+  CGUIFontGlyphAtlas atlas;
+  const CGUIFontGlyphAtlas::Glyph* glyph = atlas.Add(' ', nullptr, 0, 0, 0, 0, 0, 4.0f);
+  ASSERT_TRUE(glyph != nullptr);
+  EXPECT_EQ(0u, glyph->width);
+  EXPECT_EQ(4.0f, glyph->advance);
+  EXPECT_EQ(0u, atlas.GetHeight());
+}
+
+TEST(TestGUIFontGlyphAtlas, Grow)
+{
+  CGUIFontGlyphAtlas atlas;
+  std::vector<unsigned char> coverage = Square(56);
+
+  const CGUIFontGlyphAtlas::Glyph* first = atlas.Add(0, coverage.data(), 56, 56, 56, 0, 56, 56.0f);
+  ASSERT_TRUE(first != nullptr);
+  unsigned int generation = atlas.GetGeneration();
+  unsigned int height = atlas.GetHeight();
+  unsigned int x = first->x, y = first->y;
+  unsigned char sample = atlas.GetPixels()[(y + 32) * atlas.GetWidth() + x + 32];
+
+  // fill enough rows to force the atlas to grow
+  unsigned int perRow = atlas.GetWidth() / (first->width + 1);
+  for (unsigned int i = 1; i <= perRow * (height / first->height + 1); i++)
+    ASSERT_TRUE(atlas.Add(i, coverage.data(), 56, 56, 56, 0, 56, 56.0f) != nullptr);
+
+  EXPECT_GT(atlas.GetHeight(), height);
+  EXPECT_GT(atlas.GetGeneration(), generation);
+
+  // cached glyphs keep their place and pixels
+  const CGUIFontGlyphAtlas::Glyph* again = atlas.Find(0);
+  ASSERT_TRUE(again != nullptr);
+  EXPECT_EQ(x, again->x);
+  EXPECT_EQ(y, again->y);
+  EXPECT_EQ(sample, atlas.GetPixels()[(y + 32) * atlas.GetWidth() + x + 32]);
+
+  unsigned int y1, y2;
+  EXPECT_TRUE(atlas.GetDirtyRows(y1, y2));
+  atlas.ClearDirty();
+  EXPECT_FALSE(atlas.GetDirtyRows(y1, y2));
+}
+
+TEST(TestGUIFontGlyphAtlas, Full)
+{
+  CGUIFontGlyphAtlas atlas;
+  atlas.SetMaxHeight(128);
+  std::vector<unsigned char> coverage = Square(100);
+
+  unsigned int added = 0;
+  while (atlas.Add(added, coverage.data(), 100, 100, 100, 0, 100, 100.0f))
+    added++;
+  EXPECT_GT(added, 0u);
+  EXPECT_EQ(128u, atlas.GetHeight());
+}
+
+/* Compares the glyph cache of one bitmap texture per font size against the
+ * shared atlas for a CJK string set. Set KODI_TEST_CJK_FONT to the path of a
+ * font with CJK coverage to run it.
+ */
+TEST(TestGUIFontGlyphAtlas, CJKBenchmark)
+{
+  const char* fontPath = getenv("KODI_TEST_CJK_FONT");
+  if (!fontPath)
+  {
+    std::cout << "KODI_TEST_CJK_FONT not set, skipping the CJK glyph cache benchmark" << std::endl;
+    return;
+  }
+
+  FT_Library library;
+  ASSERT_EQ(0, FT_Init_FreeType(&library));
+
+  // a few thousand common ideographs and kana, rendered at the sizes skins use
+  std::vector<FT_ULong> letters;
+  for (FT_ULong c = 0x3041; c < 0x3097; c++)
+    letters.push_back(c);
+  for (FT_ULong c = 0x4E00; c < 0x4E00 + 3000; c++)
+    letters.push_back(c);
+  const unsigned int sizes[] = { 16, 20, 24, 30, 36, 46 };
+
+  typedef std::chrono::steady_clock clock;
+
+  // per size bitmap glyphs, packed into a 1024 wide texture the way CGUIFontTTFBase does
+  size_t bitmapBytes = 0;
+  auto start = clock::now();
+  for (unsigned int size : sizes)
+  {
+    FT_Face face;
+    ASSERT_EQ(0, FT_New_Face(library, fontPath, 0, &face));
+    FT_Set_Pixel_Sizes(face, 0, size);
+
+    unsigned int posX = 0, rowHeight = 0, height = 0;
+    for (FT_ULong letter : letters)
+    {
+      if (FT_Load_Char(face, letter, FT_LOAD_RENDER | FT_LOAD_TARGET_LIGHT))
+        continue;
+      unsigned int width = face->glyph->bitmap.width + 1;
+      if (posX + width > 1024)
+      {
+        height += rowHeight;
+        posX = 0;
+        rowHeight = 0;
+      }
+      posX += width;
+      rowHeight = std::max(rowHeight, face->glyph->bitmap.rows + 1);
+    }
+    height += rowHeight;
+
+    // the texture grows in powers of two
+    unsigned int textureHeight = 1;
+    while (textureHeight < height)
+      textureHeight *= 2;
+    bitmapBytes += 1024 * textureHeight;
+    FT_Done_Face(face);
+  }
+  auto bitmapTime = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start).count();
+
+  // one distance field atlas shared by all sizes
+  start = clock::now();
+  {
+    CGUIFontGlyphAtlas atlas;
+    FT_Face face;
+    ASSERT_EQ(0, FT_New_Face(library, fontPath, 0, &face));
+    FT_Set_Pixel_Sizes(face, 0, CGUIFontGlyphAtlas::REFERENCE_SIZE);
+    XUTILS::auto_buffer noMemory;
+    atlas.SetFace(face, nullptr, noMemory);
+
+    unsigned int missing = 0;
+    for (unsigned int size : sizes)
+    {
+      (void)size;
+      for (FT_ULong letter : letters)
+      {
+        if (atlas.Find(letter))
+          continue;
+        if (FT_Load_Char(face, letter, FT_LOAD_RENDER | FT_LOAD_TARGET_LIGHT))
+          continue;
+        const FT_Bitmap& bitmap = face->glyph->bitmap;
+        if (!atlas.Add(letter, bitmap.buffer, bitmap.width, bitmap.rows, std::abs(bitmap.pitch),
+                       face->glyph->bitmap_left, face->glyph->bitmap_top, face->glyph->advance.x / 64.0f))
+          missing++;
+      }
+    }
+    auto atlasTime = std::chrono::duration_cast<std::chrono::milliseconds>(clock::now() - start).count();
+
+    std::cout << letters.size() << " letters at " << sizeof(sizes) / sizeof(sizes[0]) << " sizes: "
+              << "bitmap textures " << bitmapBytes / 1024 << " KiB in " << bitmapTime << " ms, "
+              << "glyph atlas " << atlas.GetMemoryUsage() / 1024 << " KiB in " << atlasTime << " ms"
+              << " (" << atlas.GetGlyphCount() << " glyphs, " << missing << " didn't fit)" << std::endl;
+
+    EXPECT_LT(atlas.GetMemoryUsage(), bitmapBytes);
+  }
+
+  FT_Done_FreeType(library);
+}
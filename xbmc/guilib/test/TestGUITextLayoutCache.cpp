@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "guilib/GUITextLayoutCache.h"
+
+#include "gtest/gtest.h"
+
+namespace
+{
+STextLayoutKey Key(const std::string& text, float maxWidth = 0)
+{
+  STextLayoutKey key;
+  key.utf8 = text;
+  key.maxWidth = maxWidth;
+  return key;
+}
+
+STextLayout Layout(float width)
+{
+  STextLayout layout;
+  layout.textWidth = width;
+  return layout;
+}
+}
+
+class TestGUITextLayoutCache : public testing::Test
+{
+protected:
+  TestGUITextLayoutCache() : m_cache(CGUITextLayoutCache::GetInstance())
+  {
+    m_capacity = m_cache.GetCapacity();
+    m_cache.Flush();
+  }
+
+  ~TestGUITextLayoutCache() override
+  {
+    m_cache.Flush();
+    m_cache.SetCapacity(m_capacity);
+  }
+
+  CGUITextLayoutCache& m_cache;
+  unsigned int m_capacity;
+};
+
+TEST_F(TestGUITextLayoutCache, LookupAndStore)
+{
+  STextLayout layout;
+  EXPECT_FALSE(m_cache.Lookup(Key("foo"), layout));
+
+  m_cache.Store(Key("foo"), Layout(10));
+  ASSERT_TRUE(m_cache.Lookup(Key("foo"), layout));
+  EXPECT_EQ(10, layout.textWidth);
+
+  // the wrapping width is part of the key
+  EXPECT_FALSE(m_cache.Lookup(Key("foo", 100), layout));
+
+  EXPECT_EQ(1u, m_cache.GetHits());
+  EXPECT_EQ(2u, m_cache.GetMisses());
+}
+
+TEST_F(TestGUITextLayoutCache, LeastRecentlyUsed)
+{
+  m_cache.SetCapacity(2);
+  m_cache.Store(Key("a"), Layout(1));
+  m_cache.Store(Key("b"), Layout(2));
+
+  STextLayout layout;
+  EXPECT_TRUE(m_cache.Lookup(Key("a"), layout));
+
+  // "b" is the least recently used one now
+  m_cache.Store(Key("c"), Layout(3));
+  EXPECT_EQ(2u, m_cache.GetSize());
+  EXPECT_TRUE(m_cache.Lookup(Key("a"), layout));
+  EXPECT_FALSE(m_cache.Lookup(Key("b"), layout));
+  EXPECT_TRUE(m_cache.Lookup(Key("c"), layout));
+}
+
+TEST_F(TestGUITextLayoutCache, Disabled)
+{
+  m_cache.SetCapacity(0);
+  m_cache.Store(Key("a"), Layout(1));
+
+  STextLayout layout;
+  EXPECT_FALSE(m_cache.Lookup(Key("a"), layout));
+  EXPECT_EQ(0u, m_cache.GetSize());
+}
@@ -9,6 +9,8 @@
 #include "InfoBool.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+
 namespace INFO
 {
   InfoBool::InfoBool(const std::string &expression, int context, unsigned int &refreshCounter)
@@ -17,8 +19,18 @@ namespace INFO
       m_listItemDependent(false),
       m_expression(expression),
       m_refreshCounter(0),
-      m_parentRefreshCounter(refreshCounter)
+      m_parentRefreshCounter(refreshCounter),
+      m_changeStamp(0),
+      m_evaluated(false)
   {
     StringUtils::ToLower(m_expression);
   }
+
+  void InfoBool::SetDependencies(const Dependencies &dependencies)
+  {
+    m_dependencies = dependencies;
+    std::sort(m_dependencies.begin(), m_dependencies.end());
+    m_dependencies.erase(std::unique(m_dependencies.begin(), m_dependencies.end()), m_dependencies.end());
+    m_evaluated = false;
+  }
 }
@@ -8,8 +8,10 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 #include <memory>
+#include <vector>
 
 class CGUIListItem;
 
@@ -35,6 +37,16 @@ public:
   {
     if (item && m_listItemDependent)
       Update(item);
+    else if (!m_dependencies.empty())
+    {
+      const unsigned int changeStamp = GetChangeStamp();
+      if (changeStamp != m_changeStamp || !m_evaluated)
+      {
+        m_changeStamp = changeStamp;
+        m_evaluated = true;
+        Update(NULL);
+      }
+    }
     else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
     {
       Update(NULL);
@@ -66,6 +78,25 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+
+  /*! \brief Whether this info bool always has the same value
+   Constant bools are folded when expressions are compiled.
+   */
+  virtual bool IsConstant() const { return false; }
+
+  typedef std::vector<const std::atomic<unsigned int>*> Dependencies;
+
+  /*! \brief Set the change counters of the inputs of this info bool
+   Once set, the bool is only updated when one of the counters changes,
+   instead of once per frame.
+   \param dependencies the change counters, empty to update once per frame
+   */
+  void SetDependencies(const Dependencies &dependencies);
+
+  /*! \brief Get the change counters of the inputs of this info bool
+   \return the change counters, empty if the bool is updated once per frame
+   */
+  const Dependencies &GetDependencies() const { return m_dependencies; }
 protected:
 
   bool m_value;                ///< current value
@@ -74,8 +105,19 @@ protected:
   std::string  m_expression;   ///< original expression
 
 private:
+  unsigned int GetChangeStamp() const
+  {
+    unsigned int stamp = 0;
+    for (const auto &counter : m_dependencies)
+      stamp += counter->load(std::memory_order_relaxed);
+    return stamp;
+  }
+
   unsigned int m_refreshCounter;
   unsigned int &m_parentRefreshCounter;
+  Dependencies m_dependencies;
+  unsigned int m_changeStamp;
+  bool m_evaluated;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
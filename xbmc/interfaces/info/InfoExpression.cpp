@@ -12,14 +12,28 @@
 #include "GUIInfoManager.h"
 #include "guilib/GUIComponent.h"
 #include "ServiceBroker.h"
+#include <algorithm>
 #include <list>
 #include <memory>
 
 using namespace INFO;
 
+namespace
+{
+// how often the order of the compiled expression is revisited
+const unsigned int REORDER_INTERVAL = 256;
+const uint32_t NO_JUMP = UINT32_MAX;
+}
+
 void InfoSingle::Initialize()
 {
-  m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  CGUIInfoManager &infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  m_condition = infoMgr.TranslateSingleString(m_expression, m_listItemDependent);
+  m_constant = infoMgr.IsConstantCondition(m_condition);
+
+  Dependencies dependencies;
+  if (!m_listItemDependent && infoMgr.GetBoolDependencies(m_condition, dependencies))
+    SetDependencies(dependencies);
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
@@ -34,20 +48,107 @@ void InfoExpression::Initialize()
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", m_expression.c_str());
     m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
   }
+  Compile();
+
+  if (m_listItemDependent || m_leaves.empty())
+    return;
+
+  Dependencies dependencies;
+  for (const auto &leaf : m_leaves)
+  {
+    const Dependencies &leafDependencies = leaf->GetDependencies();
+    if (leafDependencies.empty())
+      return;
+    dependencies.insert(dependencies.end(), leafDependencies.begin(), leafDependencies.end());
+  }
+  SetDependencies(dependencies);
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  m_value = Evaluate(item);
+
+  // move the nodes which decide the value of their group most often to the
+  // front, so that less leaves are evaluated next time
+  if (m_expression_tree && ++m_evaluations >= REORDER_INTERVAL)
+  {
+    if (m_expression_tree->Reorder(m_program))
+      Compile();
+    else
+    {
+      for (auto &instruction : m_program)
+        instruction.taken = 0;
+    }
+    m_evaluations = 0;
+  }
+}
+
+bool InfoExpression::Evaluate(const CGUIListItem *item)
+{
+  Instruction *program = m_program.data();
+  const uint32_t size = static_cast<uint32_t>(m_program.size());
+  bool result = false;
+  uint32_t pc = 0;
+  while (pc < size)
+  {
+    Instruction &instruction = program[pc++];
+    switch (instruction.opcode)
+    {
+      case Instruction::OP_LEAF:
+        result = instruction.invert ^ m_leaves[instruction.operand]->Get(item);
+        break;
+      case Instruction::OP_CONST:
+        result = instruction.invert;
+        break;
+      case Instruction::OP_JUMP_IF_TRUE:
+        if (result)
+        {
+          pc = instruction.operand;
+          ++instruction.taken;
+        }
+        break;
+      case Instruction::OP_JUMP_IF_FALSE:
+        if (!result)
+        {
+          pc = instruction.operand;
+          ++instruction.taken;
+        }
+        break;
+    }
+  }
+  return result;
+}
+
+void InfoExpression::Compile()
+{
+  m_program.clear();
+  m_leaves.clear();
+
+  fold_t folded = m_expression_tree->Compile(m_program, m_leaves);
+  if (folded != FOLD_NONE)
+  {
+    // nothing left to evaluate at runtime
+    m_program.clear();
+    m_leaves.clear();
+    m_program.push_back({ Instruction::OP_CONST, folded == FOLD_TRUE, 0, 0 });
+    m_expression_tree.reset();
+    m_evaluations = 0;
+  }
+  m_program.shrink_to_fit();
+  m_leaves.shrink_to_fit();
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
- * formation of groups of associative nodes. These groups are then reordered at
- * evaluation time such that nodes whose value renders the evaluation of the
- * remainder of the group unnecessary tend to be evaluated first (these are
- * true nodes for OR subexpressions, or false nodes for AND subexpressions).
- * The end effect is to minimise the number of leaf nodes that need to be
- * evaluated in order to determine the value of the expression. The runtime
+ * formation of groups of associative nodes. The tree is then compiled into a
+ * flat program of leaf evaluations and conditional jumps, so that evaluating a
+ * group stops at the first node whose value renders the evaluation of the
+ * remainder of the group unnecessary (true nodes for OR subexpressions, or
+ * false nodes for AND subexpressions). Leaves with a constant value, like
+ * "true" or a platform check, are folded away while compiling.
+ * The groups are periodically reordered such that the nodes which most often
+ * end the evaluation of their group are evaluated first, and the program is
+ * recompiled. The end effect is to minimise the number of leaf nodes that need
+ * to be evaluated in order to determine the value of the expression. The runtime
  * adaptability has the advantage of not being customised for any particular skin.
  *
  * The modifications to the expression at parse time fall into two groups:
@@ -59,9 +160,17 @@ void InfoExpression::Update(const CGUIListItem *item)
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
+InfoExpression::fold_t InfoExpression::InfoLeaf::Compile(Program &program, std::vector<InfoPtr> &leaves)
 {
-  return m_invert ^ m_info->Get(item);
+  if (m_info->IsConstant())
+    return (m_invert ^ m_info->Get()) ? FOLD_TRUE : FOLD_FALSE;
+
+  auto it = std::find(leaves.begin(), leaves.end(), m_info);
+  if (it == leaves.end())
+    it = leaves.insert(leaves.end(), m_info);
+
+  program.push_back({ Instruction::OP_LEAF, m_invert, static_cast<uint32_t>(it - leaves.begin()), 0 });
+  return FOLD_NONE;
 }
 
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
@@ -84,27 +193,86 @@ void InfoExpression::InfoAssociativeGroup::Merge(std::shared_ptr<InfoAssociative
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
+InfoExpression::fold_t InfoExpression::InfoAssociativeGroup::Compile(Program &program, std::vector<InfoPtr> &leaves)
 {
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
+  /* An OR group is done as soon as one child is true, an AND group as soon as
+   * one child is false, so each child is followed by a jump to the end of the
+   * group. Children with a value known in advance either decide the whole
+   * group, or can be left out.
    */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  const bool use_and = (m_type == NODE_AND);
+  const fold_t decisive = use_and ? FOLD_FALSE : FOLD_TRUE;
+  const size_t programStart = program.size();
+  const size_t leavesStart = leaves.size();
+
+  m_jumps.clear();
+  for (const auto &child : m_children)
+  {
+    fold_t folded = child->Compile(program, leaves);
+    if (folded == decisive)
+    {
+      program.resize(programStart);
+      leaves.resize(leavesStart);
+      m_jumps.clear();
+      return decisive;
+    }
+    if (folded == FOLD_NONE)
+    {
+      // the jump after the last child only counts how often it decided the group
+      m_jumps.push_back(static_cast<uint32_t>(program.size()));
+      program.push_back({ use_and ? Instruction::OP_JUMP_IF_FALSE : Instruction::OP_JUMP_IF_TRUE, false, 0, 0 });
+    }
+    else
+      m_jumps.push_back(NO_JUMP);
+  }
+
+  if (program.size() == programStart)
+  {
+    m_jumps.clear();
+    return use_and ? FOLD_TRUE : FOLD_FALSE;
+  }
+
+  for (uint32_t jump : m_jumps)
+  {
+    if (jump != NO_JUMP)
+      program[jump].operand = static_cast<uint32_t>(program.size());
+  }
+  return FOLD_NONE;
+}
+
+bool InfoExpression::InfoAssociativeGroup::Reorder(const Program &program)
+{
+  // a folded group isn't part of the program, nor are its children
+  if (m_jumps.empty())
+    return false;
+
+  bool reordered = false;
+  std::vector<std::pair<uint32_t, InfoSubexpressionPtr>> children;
+  auto jump = m_jumps.begin();
+  for (const auto &child : m_children)
+  {
+    reordered |= child->Reorder(program);
+    const uint32_t taken = (jump != m_jumps.end() && *jump != NO_JUMP) ? program[*jump].taken : 0;
+    children.emplace_back(taken, child);
+    if (jump != m_jumps.end())
+      ++jump;
+  }
+
+  std::stable_sort(children.begin(), children.end(),
+                   [](const std::pair<uint32_t, InfoSubexpressionPtr> &a, const std::pair<uint32_t, InfoSubexpressionPtr> &b)
+                   { return a.first > b.first; });
+
+  auto child = m_children.begin();
+  for (const auto &sorted : children)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
+    if (*child != sorted.second)
     {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
+      *child = sorted.second;
+      reordered = true;
     }
+    ++child;
   }
-  return use_and ^ result;
+  return reordered;
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
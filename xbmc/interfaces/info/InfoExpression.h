@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <stdint.h>
 #include <vector>
 #include <list>
 #include <stack>
@@ -27,14 +28,18 @@ public:
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
+  bool IsConstant() const override { return m_constant; }
 private:
   int m_condition;             ///< actual condition this represents
+  bool m_constant = false;     ///< whether the condition always has the same value
 };
 
 /*! \brief Class to wrap active boolean expressions
  */
 class InfoExpression : public InfoBool
 {
+  friend class TestInfoExpressionHelper;
+
 public:
   InfoExpression(const std::string &expression, int context, unsigned int &refreshCounter)
     : InfoBool(expression, context, refreshCounter) {};
@@ -61,13 +66,43 @@ private:
     NODE_OR,
   } node_type_t;
 
+  typedef enum
+  {
+    FOLD_NONE,  // value is only known at runtime
+    FOLD_FALSE,
+    FOLD_TRUE,
+  } fold_t;
+
+  // An instruction of the compiled expression. The program has a single
+  // result register, which is also the result of the expression.
+  struct Instruction
+  {
+    typedef enum : uint8_t
+    {
+      OP_LEAF,          // result = value of m_leaves[operand], inverted if invert is set
+      OP_CONST,         // result = invert
+      OP_JUMP_IF_TRUE,  // continue at instruction operand if result is true
+      OP_JUMP_IF_FALSE, // continue at instruction operand if result is false
+    } opcode_t;
+
+    opcode_t opcode;
+    bool invert;
+    uint32_t operand;
+    uint32_t taken;     // number of times a jump was taken since the last compile
+  };
+
+  typedef std::vector<Instruction> Program;
+
   // An abstract base class for nodes in the expression tree
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
     virtual node_type_t Type() const=0;
+    // Appends the instructions for this subexpression, unless its value is known in advance
+    virtual fold_t Compile(Program &program, std::vector<InfoPtr> &leaves) = 0;
+    // Reorders the subexpression by how often parts of it decided its value, true if anything moved
+    virtual bool Reorder(const Program &program) { return false; };
   };
 
   typedef std::shared_ptr<InfoSubexpression> InfoSubexpressionPtr;
@@ -77,8 +112,8 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(info), m_invert(invert) {};
-    bool Evaluate(const CGUIListItem *item) override;
     node_type_t Type() const override { return NODE_LEAF; };
+    fold_t Compile(Program &program, std::vector<InfoPtr> &leaves) override;
   private:
     InfoPtr m_info;
     bool m_invert;
@@ -91,17 +126,25 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(std::shared_ptr<InfoAssociativeGroup> other);
-    bool Evaluate(const CGUIListItem *item) override;
     node_type_t Type() const override { return m_type; };
+    fold_t Compile(Program &program, std::vector<InfoPtr> &leaves) override;
+    bool Reorder(const Program &program) override;
   private:
     node_type_t m_type;
     std::list<InfoSubexpressionPtr> m_children;
+    std::vector<uint32_t> m_jumps; // the jump following each child in the program, or NO_JUMP if it was folded, empty if the group was folded
   };
 
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
   bool Parse(const std::string &expression);
+  void Compile();
+  bool Evaluate(const CGUIListItem *item);
+
   InfoSubexpressionPtr m_expression_tree;
+  Program m_program;
+  std::vector<InfoPtr> m_leaves; ///< the conditions the program refers to
+  unsigned int m_evaluations = 0; ///< evaluations since the last compile
 };
 
 };
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "interfaces/info/InfoExpression.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+namespace INFO
+{
+// a condition with a fixed value, constant like a platform check or not
+class TestCondition : public InfoBool
+{
+public:
+  TestCondition(const std::string &expression, bool value, bool constant, unsigned int &refreshCounter)
+    : InfoBool(expression, 0, refreshCounter), m_constant(constant)
+  {
+    m_value = value;
+  }
+  bool IsConstant() const override { return m_constant; }
+  void SetValue(bool value) { m_value = value; }
+
+private:
+  bool m_constant;
+};
+
+/* Builds expressions without the info manager, the parser needs it to
+ * register the conditions.
+ */
+class TestInfoExpressionHelper
+{
+public:
+  typedef InfoExpression::InfoSubexpressionPtr Node;
+
+  static Node Leaf(const InfoPtr &info)
+  {
+    return std::make_shared<InfoExpression::InfoLeaf>(info, false);
+  }
+  static Node And(const Node &left, const Node &right)
+  {
+    return std::make_shared<InfoExpression::InfoAssociativeGroup>(InfoExpression::NODE_AND, left, right);
+  }
+  static Node Or(const Node &left, const Node &right)
+  {
+    return std::make_shared<InfoExpression::InfoAssociativeGroup>(InfoExpression::NODE_OR, left, right);
+  }
+  static void Compile(InfoExpression &expression, const Node &tree)
+  {
+    expression.m_expression_tree = tree;
+    expression.Compile();
+  }
+  static size_t ProgramSize(const InfoExpression &expression)
+  {
+    return expression.m_program.size();
+  }
+  static size_t LeafCount(const InfoExpression &expression)
+  {
+    return expression.m_leaves.size();
+  }
+};
+}
+
+using namespace INFO;
+
+typedef TestInfoExpressionHelper Helper;
+
+TEST(TestInfoExpression, NestedGroupFoldsToConstant)
+{
+  unsigned int refreshCounter = 0;
+  auto a = std::make_shared<TestCondition>("a", false, false, refreshCounter);
+  auto b = std::make_shared<TestCondition>("b", true, false, refreshCounter);
+  auto c = std::make_shared<TestCondition>("c", true, false, refreshCounter);
+  auto platform = std::make_shared<TestCondition>("system.platform.x", false, true, refreshCounter);
+
+  // [b + [c + system.platform.x]] | a, both groups are partly compiled before they fold
+  InfoExpression expression("test", 0, refreshCounter);
+  Helper::Compile(expression, Helper::Or(Helper::And(Helper::Leaf(b),
+                                                     Helper::And(Helper::Leaf(c), Helper::Leaf(platform))),
+                                         Helper::Leaf(a)));
+
+  // only a and the jump after it are left
+  EXPECT_EQ(2u, Helper::ProgramSize(expression));
+  EXPECT_EQ(1u, Helper::LeafCount(expression));
+
+  // enough evaluations to reorder and recompile a couple of times
+  for (int i = 0; i < 1024; i++)
+  {
+    a->SetValue(i % 3 == 0);
+    EXPECT_EQ(i % 3 == 0, expression.Get());
+  }
+  EXPECT_EQ(2u, Helper::ProgramSize(expression));
+  EXPECT_EQ(1u, Helper::LeafCount(expression));
+}
+
+TEST(TestInfoExpression, FoldsToConstant)
+{
+  unsigned int refreshCounter = 0;
+  auto a = std::make_shared<TestCondition>("a", false, false, refreshCounter);
+  auto platform = std::make_shared<TestCondition>("system.platform.x", true, true, refreshCounter);
+
+  // a | system.platform.x is always true
+  InfoExpression expression("test", 0, refreshCounter);
+  Helper::Compile(expression, Helper::Or(Helper::Leaf(a), Helper::Leaf(platform)));
+
+  EXPECT_EQ(1u, Helper::ProgramSize(expression));
+  EXPECT_EQ(0u, Helper::LeafCount(expression));
+  for (int i = 0; i < 512; i++)
+  {
+    EXPECT_TRUE(expression.Get());
+  }
+}
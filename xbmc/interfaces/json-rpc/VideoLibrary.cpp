@@ -23,6 +23,7 @@ using namespace KODI::MESSAGING;
 JSONRPC_STATUS CVideoLibrary::GetMovies(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   CVideoDatabase videodatabase;
+  videodatabase.SetReadOnly(true);
   if (!videodatabase.Open())
     return InternalError;
 
@@ -133,6 +134,7 @@ JSONRPC_STATUS CVideoLibrary::GetMovieSetDetails(const std::string &method, ITra
 JSONRPC_STATUS CVideoLibrary::GetTVShows(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   CVideoDatabase videodatabase;
+  videodatabase.SetReadOnly(true);
   if (!videodatabase.Open())
     return InternalError;
 
@@ -231,6 +233,7 @@ JSONRPC_STATUS CVideoLibrary::GetSeasonDetails(const std::string &method, ITrans
 JSONRPC_STATUS CVideoLibrary::GetEpisodes(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   CVideoDatabase videodatabase;
+  videodatabase.SetReadOnly(true);
   if (!videodatabase.Open())
     return InternalError;
 
@@ -313,6 +316,7 @@ JSONRPC_STATUS CVideoLibrary::GetEpisodeDetails(const std::string &method, ITran
 JSONRPC_STATUS CVideoLibrary::GetMusicVideos(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   CVideoDatabase videodatabase;
+  videodatabase.SetReadOnly(true);
   if (!videodatabase.Open())
     return InternalError;
 
@@ -1566,6 +1566,17 @@ int CMusicDatabase::AddRole(const std::string &strRole)
   {
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
+
+    std::string key;
+    if (IsBatching() && strRole.find_first_of("%_") == std::string::npos)
+    {
+      key = strRole;
+      StringUtils::ToLower(key);
+      auto it = m_roleCache.find(key);
+      if (it != m_roleCache.end())
+        return it->second;
+    }
+
     strSQL = PrepareSQL("SELECT idRole FROM role WHERE strRole LIKE '%s'", strRole.c_str());
     m_pDS->query(strSQL);
     if (m_pDS->num_rows() > 0)
@@ -1579,6 +1590,9 @@ int CMusicDatabase::AddRole(const std::string &strRole)
       idRole = static_cast<int>(m_pDS->lastinsertid());
       m_pDS->close();
     }
+
+    if (!key.empty())
+      m_roleCache[key] = idRole;
   }
   catch (...)
   {
@@ -2078,14 +2092,14 @@ int CMusicDatabase::AddPath(const std::string& strPath1)
     if (it != m_pathCache.end())
       return it->second;
 
-    strSQL=PrepareSQL( "select * from path where strPath='%s'", strPath.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select * from path where strPath=?";
+    m_pDS->query(strSQL, { dbiplus::field_value(strPath) });
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
       // doesnt exists, add it
-      strSQL=PrepareSQL("insert into path (idPath, strPath) values( NULL, '%s' )", strPath.c_str());
-      m_pDS->exec(strSQL);
+      strSQL = "insert into path (idPath, strPath) values( NULL, ? )";
+      m_pDS->exec(strSQL, { dbiplus::field_value(strPath) });
 
       int idPath = (int)m_pDS->lastinsertid();
       m_pathCache.insert(std::pair<std::string, int>(strPath, idPath));
@@ -2958,6 +2972,21 @@ void CMusicDatabase::EmptyCache()
   m_pathCache.erase(m_pathCache.begin(), m_pathCache.end());
 }
 
+void CMusicDatabase::EmptyBatchCache()
+{
+  // ids added by a rolled back item are no longer valid
+  m_roleCache.clear();
+  EmptyCache();
+
+  if (!IsBatching() && m_songsCountChanged)
+  {
+    m_songsCountChanged = false;
+    CGUIComponent* gui = CServiceBroker::GetGUI();
+    if (gui)
+      gui->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider().SetLibraryBool(LIBRARY_HAS_MUSIC, GetSongsCount() > 0);
+  }
+}
+
 bool CMusicDatabase::Search(const std::string& search, CFileItemList &items)
 {
   unsigned int time = XbmcThreads::SystemClockMillis();
@@ -4571,43 +4600,64 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
       strSQL = "SELECT songview.* FROM songview " + strSQLExtra;
 
     CLog::Log(LOGDEBUG, "%s query = %s", __FUNCTION__, strSQL.c_str());
-    // run query
-    if (!m_pDS->query(strSQL))
-      return false;
-
-    int iRowsFound = m_pDS->num_rows();
-    if (iRowsFound == 0)
-    {
-      m_pDS->close();
-      return true;
-    }
-
-    // Store the total number of songs as a property
-    items.SetProperty("total", total);
 
-    DatabaseResults results;
-    results.reserve(iRowsFound);
     // Avoid sorting with limits when have join with songartistview
     // Limit when SortByNone already applied in SQL,
     // apply sort later to fileitems list rather than dataset
     sorting = sortDescription;
     if (artistData && sortDescription.sortBy != SortByNone)
       sorting.sortBy = SortByNone;
-    if (!SortUtils::SortFromDataset(sorting, MediaTypeSong, m_pDS, results))
-      return false;
+
+    // Without sorting the dataset rows are used in query order, so stream
+    // them rather than materializing the whole result set first
+    const bool streamed = sorting.sortBy == SortByNone;
+    DatabaseResults results;
+    if (streamed)
+    {
+      if (!m_pDS->stream_query(strSQL))
+        return false;
+    }
+    else
+    {
+      // run query
+      if (!m_pDS->query(strSQL))
+        return false;
+
+      int iRowsFound = m_pDS->num_rows();
+      if (iRowsFound == 0)
+      {
+        m_pDS->close();
+        return true;
+      }
+
+      // Store the total number of songs as a property
+      items.SetProperty("total", total);
+
+      results.reserve(iRowsFound);
+      if (!SortUtils::SortFromDataset(sorting, MediaTypeSong, m_pDS, results))
+        return false;
+    }
+
+    const dbiplus::query_data &data = m_pDS->get_result_set().records;
+    auto result = results.cbegin();
+    auto nextRecord = [&]() -> const dbiplus::sql_record*
+    {
+      if (streamed)
+        return m_pDS->stream_next() ? m_pDS->stream_record() : nullptr;
+      if (result == results.cend())
+        return nullptr;
+      unsigned int targetRow = (unsigned int)(result++)->at(FieldRow).asInteger();
+      return data.at(targetRow);
+    };
 
     // Get songs from returned rows. If join songartistview then there is a row for every artist
     items.Reserve(total);
     int songArtistOffset = song_enumCount;
     int songId = -1;
     VECARTISTCREDITS artistCredits;
-    const dbiplus::query_data &data = m_pDS->get_result_set().records;
     int count = 0;
-    for (const auto &i : results)
+    while (const dbiplus::sql_record* const record = nextRecord())
     {
-      unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
       try
       {
         if (songId != record->at(song_idSong).get_asInt())
@@ -4651,6 +4701,10 @@ bool CMusicDatabase::GetSongsFullByWhere(const std::string &baseDir, const Filte
     // cleanup
     m_pDS->close();
 
+    // Store the total number of songs as a property
+    if (streamed && count > 0)
+      items.SetProperty("total", total);
+
     // Finally do any sorting in items list we have not been able to do before in SQL or dataset,
     // that is when have join with songartistview and sorting other than random with limit
     if (artistData && sortDescription.sortBy != SortByNone && !(limitedInSQL && sortDescription.sortBy == SortByRandom))
@@ -9215,6 +9269,12 @@ int CMusicDatabase::GetSongIDFromPath(const std::string &filePath)
 
 bool CMusicDatabase::CommitTransaction()
 {
+  if (IsBatching())
+  { // counting songs for every item would dominate bulk inserts, update once the batch ends
+    m_songsCountChanged = true;
+    return CDatabase::CommitTransaction();
+  }
+
   if (CDatabase::CommitTransaction())
   { // number of items in the db has likely changed, so reset the infomanager cache
     CGUIComponent* gui = CServiceBroker::GetGUI();
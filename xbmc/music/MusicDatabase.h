@@ -622,6 +622,10 @@ void SetLibraryLastUpdated();
 protected:
   std::map<std::string, int> m_genreCache;
   std::map<std::string, int> m_pathCache;
+  std::map<std::string, int> m_roleCache; ///< only used while batching
+  bool m_songsCountChanged = false; ///< library has changed during the current batch
+
+  void EmptyBatchCache() override;
 
   void CreateTables() override;
   void CreateAnalytics() override;
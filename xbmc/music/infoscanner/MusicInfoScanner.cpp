@@ -138,7 +138,10 @@ void CMusicInfoScanner::Process()
 
         // Clear list of albums added by this scan
         m_albumsAdded.clear();
+        // tag reading is local, so group the writes into larger transactions
+        m_musicDatabase.BeginBatch();
         bool scancomplete = DoScan(*it);
+        m_musicDatabase.EndBatch();
         if (scancomplete)
         {
           if (m_albumsAdded.size() > 0)
@@ -476,6 +479,9 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   if (HasNoMedia(strDirectory))
     return true;
 
+  // listing the folder may take a while, don't keep other writers waiting on the batch
+  m_musicDatabase.FlushBatch();
+
   // load subfolder
   CFileItemList items;
   CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetMusicExtensions() + "|.jpg|.tbn|.lrc|.cdg", DIR_FLAG_DEFAULTS);
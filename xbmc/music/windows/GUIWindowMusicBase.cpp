@@ -456,6 +456,9 @@ void CGUIWindowMusicBase::AddItemToPlayList(const CFileItemPtr &pItem, CFileItem
   }
   else
   {
+    // the playlist shows the labels of the item, which no container may have formatted yet
+    pItem->FormatDeferredLabels();
+
     if (pItem->IsPlayList())
     {
       std::unique_ptr<CPlayList> pPlayList (CPlayListFactory::Create(*pItem));
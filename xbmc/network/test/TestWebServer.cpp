@@ -897,3 +897,33 @@ TEST_F(TestWebServer, CanGetCachedRangedFileWithNewerIfRange)
   ASSERT_TRUE(curl.Get(GetUrlOfTestFile(TEST_FILES_RANGES), result));
   CheckRangesTestFileResponse(curl, result, ranges);
 }
+
+TEST_F(TestWebServer, CanReadFileWithParallelRanges)
+{
+  const std::string content = TEST_FILES_DATA_RANGES;
+
+  // tiny chunks to get several requests in flight at once
+  CCurlFile curl;
+  curl.SetParallelRead(3, 4);
+  ASSERT_TRUE(curl.Open(CURL(GetUrlOfTestFile(TEST_FILES_RANGES))));
+  ASSERT_EQ(static_cast<int64_t>(content.size()), curl.GetLength());
+
+  // chunks must be reassembled in file order
+  std::string result;
+  char buffer[3];
+  ssize_t read;
+  while ((read = curl.Read(buffer, sizeof(buffer))) > 0)
+    result.append(buffer, read);
+  EXPECT_EQ(0, read);
+  EXPECT_STREQ(content.c_str(), result.c_str());
+
+  // seeking back restarts the requests at the new position
+  ASSERT_EQ(7, curl.Seek(7, SEEK_SET));
+  result.clear();
+  while (result.size() < 6 && (read = curl.Read(buffer, std::min<size_t>(sizeof(buffer), 6 - result.size()))) > 0)
+    result.append(buffer, read);
+  EXPECT_STREQ("range2", result.c_str());
+  EXPECT_EQ(13, curl.GetPosition());
+
+  curl.Close();
+}
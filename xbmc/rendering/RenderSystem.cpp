@@ -7,6 +7,7 @@
  */
 
 #include "RenderSystem.h"
+#include "guilib/GUIControlProfiler.h"
 #include "guilib/GUIImage.h"
 #include "guilib/GUILabelControl.h"
 #include "guilib/GUIFontManager.h"
@@ -32,6 +33,17 @@ void CRenderSystemBase::GetRenderVersion(unsigned int& major, unsigned int& mino
   minor = m_RenderVersionMinor;
 }
 
+void CRenderSystemBase::ReportFrameStats()
+{
+  if (CGUIControlProfiler::IsRunning())
+  {
+    CGUIControlProfiler::Instance().AddDrawCalls(m_drawCalls);
+    CGUIControlProfiler::Instance().AddTextureBinds(m_textureBinds);
+  }
+  m_drawCalls = 0;
+  m_textureBinds = 0;
+}
+
 bool CRenderSystemBase::SupportsNPOT(bool dxt) const
 {
   if (dxt)
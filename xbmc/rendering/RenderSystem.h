@@ -76,7 +76,30 @@ public:
 
   virtual void ShowSplash(const std::string& message);
 
+  /*!
+   \brief Draw GUI geometry which has been queued for batching
+   Has to be called before anything is rendered that may not be reordered
+   with the queued geometry, e.g. by video or game renderers.
+   */
+  virtual void FlushGUIBatch() {}
+
+  /*!
+   \brief Count a draw call for the GUI control profiler
+   */
+  void AddDrawCall() { m_drawCalls++; }
+
+  /*!
+   \brief Count a texture bind for the GUI control profiler
+   */
+  void AddTextureBind() { m_textureBinds++; }
+
 protected:
+  /*!
+   \brief Hand the draw calls and texture binds of the finished frame to the
+          GUI control profiler
+   */
+  void ReportFrameStats();
+
   bool                m_bRenderCreated;
   bool                m_bVSync;
   unsigned int        m_maxTextureSize;
@@ -90,6 +113,8 @@ protected:
   RENDER_STEREO_VIEW m_stereoView = RENDER_STEREO_VIEW_OFF;
   RENDER_STEREO_MODE m_stereoMode = RENDER_STEREO_MODE_OFF;
   bool m_limitedColorRange = false;
+  unsigned int m_drawCalls = 0;
+  unsigned int m_textureBinds = 0;
 
   std::unique_ptr<CGUIImage> m_splashImage;
   std::unique_ptr<CGUITextLayout> m_splashMessageLayout;
@@ -22,6 +22,13 @@
 #include "platform/linux/XTimeUtils.h"
 #endif
 
+#include <cstring>
+
+#define BUFFER_OFFSET(i) ((char *)NULL + (i))
+
+// limited by the range of GLushort indices
+#define GUI_BATCH_MAX_VERTICES 65536
+
 CRenderSystemGL::CRenderSystemGL() : CRenderSystemBase()
 {
 }
@@ -118,6 +125,8 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIBatch();
+
   m_width = width;
   m_height = height;
 
@@ -194,6 +203,14 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGL::DestroyRenderSystem()
 {
+  m_guiBatchVertices.clear();
+  if (m_guiBatchVertexVBO)
+    glDeleteBuffers(1, &m_guiBatchVertexVBO);
+  if (m_guiBatchIndexVBO)
+    glDeleteBuffers(1, &m_guiBatchIndexVBO);
+  m_guiBatchVertexVBO = 0;
+  m_guiBatchIndexVBO = 0;
+
   if (m_vertexArray != GL_NONE)
   {
     glDeleteVertexArrays(1, &m_vertexArray);
@@ -227,6 +244,9 @@ bool CRenderSystemGL::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIBatch();
+  ReportFrameStats();
+
   return true;
 }
 
@@ -239,6 +259,8 @@ bool CRenderSystemGL::ClearBuffers(UTILS::Color color)
   if(m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return true;
 
+  FlushGUIBatch();
+
   float r = GET_R(color) / 255.0f;
   float g = GET_G(color) / 255.0f;
   float b = GET_B(color) / 255.0f;
@@ -287,6 +309,8 @@ void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   PresentRenderImpl(rendered);
 
   if (!rendered)
@@ -317,6 +341,8 @@ void CRenderSystemGL::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -330,6 +356,8 @@ void CRenderSystemGL::ApplyStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glBindVertexArray(m_vertexArray);
 
   glViewport(m_viewPort[0], m_viewPort[1], m_viewPort[2], m_viewPort[3]);
@@ -348,6 +376,8 @@ void CRenderSystemGL::SetCameraPosition(const CPoint &camera, int screenWidth, i
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
 
@@ -437,6 +467,8 @@ void CRenderSystemGL::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -471,6 +503,9 @@ void CRenderSystemGL::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
+  FlushGUIBatch();
+
   GLint x1 = MathUtils::round_int(rect.x1);
   GLint y1 = MathUtils::round_int(rect.y1);
   GLint x2 = MathUtils::round_int(rect.x2);
@@ -540,6 +575,8 @@ static const GLubyte stipple_3d[] = {
 
 void CRenderSystemGL::SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
 {
+  FlushGUIBatch();
+
   CRenderSystemBase::SetStereoMode(mode, view);
 
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -661,6 +698,14 @@ void CRenderSystemGL::InitialiseShaders()
     CLog::Log(LOGERROR, "GUI Shader gl_shader_frag_fonts.glsl - compile and link failed");
   }
 
+  m_pShader[SM_FONTS_SDF].reset(new CGLShader("gl_shader_frag_fonts_sdf.glsl", defines));
+  if (!m_pShader[SM_FONTS_SDF]->CompileAndLink())
+  {
+    m_pShader[SM_FONTS_SDF]->Free();
+    m_pShader[SM_FONTS_SDF].reset();
+    CLog::Log(LOGERROR, "GUI Shader gl_shader_frag_fonts_sdf.glsl - compile and link failed");
+  }
+
   m_pShader[SM_TEXTURE_NOBLEND].reset(new CGLShader("gl_shader_frag_texture_noblend.glsl", defines));
   if (!m_pShader[SM_TEXTURE_NOBLEND]->CompileAndLink())
   {
@@ -707,10 +752,16 @@ void CRenderSystemGL::ReleaseShaders()
   if (m_pShader[SM_MULTI_BLENDCOLOR])
     m_pShader[SM_MULTI_BLENDCOLOR]->Free();
   m_pShader[SM_MULTI_BLENDCOLOR].reset();
+
+  if (m_pShader[SM_FONTS_SDF])
+    m_pShader[SM_FONTS_SDF]->Free();
+  m_pShader[SM_FONTS_SDF].reset();
 }
 
 void CRenderSystemGL::EnableShader(ESHADERMETHOD method)
 {
+  FlushGUIBatch();
+
   m_method = method;
   if (m_pShader[m_method])
   {
@@ -779,6 +830,193 @@ GLint CRenderSystemGL::ShaderGetModel()
   return -1;
 }
 
+bool SGUIBatchState::operator==(const SGUIBatchState& right) const
+{
+  return texture == right.texture &&
+         diffuse == right.diffuse &&
+         method == right.method &&
+         blend == right.blend &&
+         memcmp(col, right.col, sizeof(col)) == 0;
+}
+
+void CRenderSystemGL::AddGUIQuads(const SGUIBatchState& state, const SGUIBatchVertex* vertices, size_t count)
+{
+  if (!m_guiBatchVertices.empty() && !(m_guiBatchState == state))
+    DrawGUIBatch();
+
+  m_guiBatchState = state;
+  while (count > 0)
+  {
+    if (m_guiBatchVertices.size() == GUI_BATCH_MAX_VERTICES)
+      DrawGUIBatch();
+
+    size_t n = std::min<size_t>(count, GUI_BATCH_MAX_VERTICES - m_guiBatchVertices.size());
+    m_guiBatchVertices.insert(m_guiBatchVertices.end(), vertices, vertices + n);
+    vertices += n;
+    count -= n;
+  }
+}
+
+void CRenderSystemGL::FlushGUIBatch()
+{
+  // the shaders enabled by DrawGUIBatch() end up here again
+  if (m_guiBatchVertices.empty() || m_guiBatchFlushing)
+    return;
+
+  // a flush may be triggered halfway through somebody else setting up
+  // their textures and blending, so leave the state as it was found
+  GLint program, activeTexture, texture0, texture1 = 0, arrayBuffer, elementBuffer, vertexArray = 0;
+  GLint blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha;
+  GLboolean blend = glIsEnabled(GL_BLEND);
+  glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+  glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+  glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &arrayBuffer);
+  glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+  glGetIntegerv(GL_BLEND_SRC_RGB, &blendSrcRGB);
+  glGetIntegerv(GL_BLEND_DST_RGB, &blendDstRGB);
+  glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcAlpha);
+  glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstAlpha);
+  if (m_vertexArray != GL_NONE)
+    glGetIntegerv(GL_VERTEX_ARRAY_BINDING, &vertexArray);
+  glActiveTexture(GL_TEXTURE0);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture0);
+  glActiveTexture(GL_TEXTURE1);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture1);
+
+  ESHADERMETHOD method = m_method;
+  DrawGUIBatch();
+  m_method = method;
+
+  glUseProgram(program);
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_2D, texture1);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, texture0);
+  glActiveTexture(activeTexture);
+  glBlendFuncSeparate(blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha);
+  if (blend)
+    glEnable(GL_BLEND);
+  else
+    glDisable(GL_BLEND);
+  if (m_vertexArray != GL_NONE)
+    glBindVertexArray(vertexArray);
+  glBindBuffer(GL_ARRAY_BUFFER, arrayBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer);
+}
+
+void CRenderSystemGL::DrawGUIBatch()
+{
+  if (m_guiBatchVertices.empty())
+    return;
+
+  m_guiBatchFlushing = true;
+
+  const SGUIBatchState& state = m_guiBatchState;
+  const bool multi = state.method == SM_MULTI || state.method == SM_MULTI_BLENDCOLOR;
+
+  if (m_vertexArray != GL_NONE)
+    glBindVertexArray(m_vertexArray);
+
+  if (!m_guiBatchVertexVBO)
+  {
+    // the quads always use the same six indices, so build them once for the
+    // largest possible batch
+    std::vector<GLushort> idx;
+    idx.reserve(GUI_BATCH_MAX_VERTICES / 4 * 6);
+    for (unsigned int i = 0; i < GUI_BATCH_MAX_VERTICES; i += 4)
+    {
+      idx.push_back(i + 0);
+      idx.push_back(i + 1);
+      idx.push_back(i + 2);
+      idx.push_back(i + 2);
+      idx.push_back(i + 3);
+      idx.push_back(i + 0);
+    }
+
+    glGenBuffers(1, &m_guiBatchVertexVBO);
+    glGenBuffers(1, &m_guiBatchIndexVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_guiBatchIndexVBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * idx.size(), idx.data(), GL_STATIC_DRAW);
+  }
+
+  // textures packed into the same atlas page are often still bound
+  GLint bound;
+  if (multi)
+  {
+    glActiveTexture(GL_TEXTURE1);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+    if (static_cast<GLuint>(bound) != state.diffuse)
+    {
+      glBindTexture(GL_TEXTURE_2D, state.diffuse);
+      AddTextureBind();
+    }
+  }
+  glActiveTexture(GL_TEXTURE0);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+  if (static_cast<GLuint>(bound) != state.texture)
+  {
+    glBindTexture(GL_TEXTURE_2D, state.texture);
+    AddTextureBind();
+  }
+
+  if (state.blend)
+  {
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+    glEnable(GL_BLEND);
+  }
+  else
+  {
+    glDisable(GL_BLEND);
+  }
+
+  EnableShader(state.method);
+
+  GLint posLoc  = ShaderGetPos();
+  GLint tex0Loc = ShaderGetCoord0();
+  GLint tex1Loc = ShaderGetCoord1();
+  GLint uniColLoc = ShaderGetUniCol();
+
+  if (uniColLoc >= 0)
+  {
+    glUniform4f(uniColLoc, (state.col[0] / 255.0f), (state.col[1] / 255.0f), (state.col[2] / 255.0f), (state.col[3] / 255.0f));
+  }
+
+  // orphan the previous contents so the driver doesn't have to wait for the
+  // last batch to finish drawing
+  glBindBuffer(GL_ARRAY_BUFFER, m_guiBatchVertexVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(SGUIBatchVertex) * m_guiBatchVertices.size(), m_guiBatchVertices.data(), GL_STREAM_DRAW);
+
+  if (multi)
+  {
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(SGUIBatchVertex), BUFFER_OFFSET(offsetof(SGUIBatchVertex, u2)));
+    glEnableVertexAttribArray(tex1Loc);
+  }
+
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(SGUIBatchVertex), BUFFER_OFFSET(offsetof(SGUIBatchVertex, x)));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(SGUIBatchVertex), BUFFER_OFFSET(offsetof(SGUIBatchVertex, u1)));
+  glEnableVertexAttribArray(tex0Loc);
+
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_guiBatchIndexVBO);
+  glDrawElements(GL_TRIANGLES, m_guiBatchVertices.size() * 6 / 4, GL_UNSIGNED_SHORT, 0);
+  AddDrawCall();
+
+  if (multi)
+    glDisableVertexAttribArray(tex1Loc);
+
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glEnable(GL_BLEND);
+
+  DisableShader();
+
+  m_guiBatchVertices.clear();
+  m_guiBatchFlushing = false;
+}
+
 std::string CRenderSystemGL::GetShaderPath(const std::string &filename)
 {
   std::string path = "GL/1.2/";
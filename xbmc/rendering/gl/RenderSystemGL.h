@@ -15,6 +15,7 @@
 
 #include <array>
 #include <memory>
+#include <vector>
 
 enum ESHADERMETHOD
 {
@@ -25,9 +26,34 @@ enum ESHADERMETHOD
   SM_FONTS,
   SM_TEXTURE_NOBLEND,
   SM_MULTI_BLENDCOLOR,
+  SM_FONTS_SDF,
   SM_MAX
 };
 
+/*!
+ \brief Vertex of a textured GUI quad, see CRenderSystemGL::AddGUIQuads
+ */
+struct SGUIBatchVertex
+{
+  float x, y, z;
+  float u1, v1;
+  float u2, v2;
+};
+
+/*!
+ \brief Render state shared by all quads of a GUI batch
+ */
+struct SGUIBatchState
+{
+  GLuint texture = 0;
+  GLuint diffuse = 0;
+  ESHADERMETHOD method = SM_TEXTURE;
+  bool blend = true;
+  GLubyte col[4] = {};
+
+  bool operator==(const SGUIBatchState& right) const;
+};
+
 class CRenderSystemGL : public CRenderSystemBase
 {
 public:
@@ -82,12 +108,24 @@ public:
   GLint ShaderGetUniCol();
   GLint ShaderGetModel();
 
+  /*!
+   \brief Queue textured quads for rendering
+   Consecutive quads with an equal render state are drawn with a single draw
+   call once the state changes or the batch is flushed.
+   \param state the textures, shader and blending to draw the quads with
+   \param vertices four vertices per quad
+   \param count number of vertices
+   */
+  void AddGUIQuads(const SGUIBatchState& state, const SGUIBatchVertex* vertices, size_t count);
+  void FlushGUIBatch() override;
+
 protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
   void CalculateMaxTexturesize();
   void InitialiseShaders();
   void ReleaseShaders();
+  void DrawGUIBatch();
 
   bool m_bVsyncInit = false;
   int m_width;
@@ -104,4 +142,10 @@ protected:
   std::array<std::unique_ptr<CGLShader>, SM_MAX> m_pShader;
   ESHADERMETHOD m_method = SM_DEFAULT;
   GLuint m_vertexArray = GL_NONE;
+
+  SGUIBatchState m_guiBatchState;
+  std::vector<SGUIBatchVertex> m_guiBatchVertices;
+  GLuint m_guiBatchVertexVBO = 0;
+  GLuint m_guiBatchIndexVBO = 0;
+  bool m_guiBatchFlushing = false;
 };
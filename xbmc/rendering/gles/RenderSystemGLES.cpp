@@ -25,6 +25,13 @@
 #include "utils/EGLUtils.h"
 #endif
 
+#include <cstring>
+
+#define BUFFER_OFFSET(i) ((char *)NULL + (i))
+
+// limited by the range of GLushort indices
+#define GUI_BATCH_MAX_VERTICES 65536
+
 CRenderSystemGLES::CRenderSystemGLES()
  : CRenderSystemBase()
 {
@@ -153,6 +160,14 @@ bool CRenderSystemGLES::DestroyRenderSystem()
   glFinish();
   PresentRenderImpl(true);
 
+  m_guiBatchVertices.clear();
+  if (m_guiBatchVertexVBO)
+    glDeleteBuffers(1, &m_guiBatchVertexVBO);
+  if (m_guiBatchIndexVBO)
+    glDeleteBuffers(1, &m_guiBatchIndexVBO);
+  m_guiBatchVertexVBO = 0;
+  m_guiBatchIndexVBO = 0;
+
   ReleaseShaders();
   m_bRenderCreated = false;
 
@@ -182,6 +197,9 @@ bool CRenderSystemGLES::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIBatch();
+  ReportFrameStats();
+
   return true;
 }
 
@@ -190,6 +208,8 @@ bool CRenderSystemGLES::ClearBuffers(UTILS::Color color)
   if (!m_bRenderCreated)
     return false;
 
+  FlushGUIBatch();
+
   float r = GET_R(color) / 255.0f;
   float g = GET_G(color) / 255.0f;
   float b = GET_B(color) / 255.0f;
@@ -228,6 +248,8 @@ void CRenderSystemGLES::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   PresentRenderImpl(rendered);
 
   // if video is rendered to a separate layer, we should not block this thread
@@ -258,6 +280,8 @@ void CRenderSystemGLES::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -273,6 +297,8 @@ void CRenderSystemGLES::ApplyStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glMatrixProject.PopLoad();
   glMatrixModview.PopLoad();
   glMatrixTexture.PopLoad();
@@ -287,6 +313,8 @@ void CRenderSystemGLES::SetCameraPosition(const CPoint &camera, int screenWidth,
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   CPoint offset = camera - CPoint(screenWidth*0.5f, screenHeight*0.5f);
 
   float w = (float)m_viewPort[2]*0.5f;
@@ -335,6 +363,8 @@ void CRenderSystemGLES::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  FlushGUIBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -369,6 +399,9 @@ void CRenderSystemGLES::SetScissors(const CRect &rect)
 {
   if (!m_bRenderCreated)
     return;
+
+  FlushGUIBatch();
+
   GLint x1 = MathUtils::round_int(rect.x1);
   GLint y1 = MathUtils::round_int(rect.y1);
   GLint x2 = MathUtils::round_int(rect.x2);
@@ -532,6 +565,8 @@ void CRenderSystemGLES::ReleaseShaders()
 
 void CRenderSystemGLES::EnableGUIShader(ESHADERMETHOD method)
 {
+  FlushGUIBatch();
+
   m_method = method;
   if (m_pShader[m_method])
   {
@@ -644,3 +679,183 @@ GLint CRenderSystemGLES::GUIShaderGetModel()
 
   return -1;
 }
+
+bool SGUIBatchState::operator==(const SGUIBatchState& right) const
+{
+  return texture == right.texture &&
+         diffuse == right.diffuse &&
+         method == right.method &&
+         blend == right.blend &&
+         memcmp(col, right.col, sizeof(col)) == 0;
+}
+
+void CRenderSystemGLES::AddGUIQuads(const SGUIBatchState& state, const SGUIBatchVertex* vertices, size_t count)
+{
+  if (!m_guiBatchVertices.empty() && !(m_guiBatchState == state))
+    DrawGUIBatch();
+
+  m_guiBatchState = state;
+  while (count > 0)
+  {
+    if (m_guiBatchVertices.size() == GUI_BATCH_MAX_VERTICES)
+      DrawGUIBatch();
+
+    size_t n = std::min<size_t>(count, GUI_BATCH_MAX_VERTICES - m_guiBatchVertices.size());
+    m_guiBatchVertices.insert(m_guiBatchVertices.end(), vertices, vertices + n);
+    vertices += n;
+    count -= n;
+  }
+}
+
+void CRenderSystemGLES::FlushGUIBatch()
+{
+  // the shaders enabled by DrawGUIBatch() end up here again
+  if (m_guiBatchVertices.empty() || m_guiBatchFlushing)
+    return;
+
+  // a flush may be triggered halfway through somebody else setting up
+  // their textures and blending, so leave the state as it was found
+  GLint program, activeTexture, texture0, texture1 = 0, arrayBuffer, elementBuffer;
+  GLint blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha;
+  GLboolean blend = glIsEnabled(GL_BLEND);
+  glGetIntegerv(GL_CURRENT_PROGRAM, &program);
+  glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+  glGetIntegerv(GL_ARRAY_BUFFER_BINDING, &arrayBuffer);
+  glGetIntegerv(GL_ELEMENT_ARRAY_BUFFER_BINDING, &elementBuffer);
+  glGetIntegerv(GL_BLEND_SRC_RGB, &blendSrcRGB);
+  glGetIntegerv(GL_BLEND_DST_RGB, &blendDstRGB);
+  glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcAlpha);
+  glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstAlpha);
+  glActiveTexture(GL_TEXTURE0);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture0);
+  glActiveTexture(GL_TEXTURE1);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &texture1);
+
+  ESHADERMETHOD method = m_method;
+  DrawGUIBatch();
+  m_method = method;
+
+  glUseProgram(program);
+  glActiveTexture(GL_TEXTURE1);
+  glBindTexture(GL_TEXTURE_2D, texture1);
+  glActiveTexture(GL_TEXTURE0);
+  glBindTexture(GL_TEXTURE_2D, texture0);
+  glActiveTexture(activeTexture);
+  glBlendFuncSeparate(blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha);
+  if (blend)
+    glEnable(GL_BLEND);
+  else
+    glDisable(GL_BLEND);
+  glBindBuffer(GL_ARRAY_BUFFER, arrayBuffer);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elementBuffer);
+}
+
+void CRenderSystemGLES::DrawGUIBatch()
+{
+  if (m_guiBatchVertices.empty())
+    return;
+
+  m_guiBatchFlushing = true;
+
+  const SGUIBatchState& state = m_guiBatchState;
+  const bool multi = state.method == SM_MULTI || state.method == SM_MULTI_BLENDCOLOR;
+
+  if (!m_guiBatchVertexVBO)
+  {
+    // the quads always use the same six indices, so build them once for the
+    // largest possible batch
+    std::vector<GLushort> idx;
+    idx.reserve(GUI_BATCH_MAX_VERTICES / 4 * 6);
+    for (unsigned int i = 0; i < GUI_BATCH_MAX_VERTICES; i += 4)
+    {
+      idx.push_back(i + 0);
+      idx.push_back(i + 1);
+      idx.push_back(i + 2);
+      idx.push_back(i + 2);
+      idx.push_back(i + 3);
+      idx.push_back(i + 0);
+    }
+
+    glGenBuffers(1, &m_guiBatchVertexVBO);
+    glGenBuffers(1, &m_guiBatchIndexVBO);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_guiBatchIndexVBO);
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort) * idx.size(), idx.data(), GL_STATIC_DRAW);
+  }
+
+  // textures packed into the same atlas page are often still bound
+  GLint bound;
+  if (multi)
+  {
+    glActiveTexture(GL_TEXTURE1);
+    glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+    if (static_cast<GLuint>(bound) != state.diffuse)
+    {
+      glBindTexture(GL_TEXTURE_2D, state.diffuse);
+      AddTextureBind();
+    }
+  }
+  glActiveTexture(GL_TEXTURE0);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &bound);
+  if (static_cast<GLuint>(bound) != state.texture)
+  {
+    glBindTexture(GL_TEXTURE_2D, state.texture);
+    AddTextureBind();
+  }
+
+  if (state.blend)
+  {
+    glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+    glEnable(GL_BLEND);
+  }
+  else
+  {
+    glDisable(GL_BLEND);
+  }
+
+  EnableGUIShader(state.method);
+
+  GLint posLoc  = GUIShaderGetPos();
+  GLint tex0Loc = GUIShaderGetCoord0();
+  GLint tex1Loc = GUIShaderGetCoord1();
+  GLint uniColLoc = GUIShaderGetUniCol();
+
+  if (uniColLoc >= 0)
+  {
+    glUniform4f(uniColLoc, (state.col[0] / 255.0f), (state.col[1] / 255.0f), (state.col[2] / 255.0f), (state.col[3] / 255.0f));
+  }
+
+  // orphan the previous contents so the driver doesn't have to wait for the
+  // last batch to finish drawing
+  glBindBuffer(GL_ARRAY_BUFFER, m_guiBatchVertexVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(SGUIBatchVertex) * m_guiBatchVertices.size(), m_guiBatchVertices.data(), GL_STREAM_DRAW);
+
+  if (multi)
+  {
+    glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(SGUIBatchVertex), BUFFER_OFFSET(offsetof(SGUIBatchVertex, u2)));
+    glEnableVertexAttribArray(tex1Loc);
+  }
+
+  glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(SGUIBatchVertex), BUFFER_OFFSET(offsetof(SGUIBatchVertex, x)));
+  glEnableVertexAttribArray(posLoc);
+  glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(SGUIBatchVertex), BUFFER_OFFSET(offsetof(SGUIBatchVertex, u1)));
+  glEnableVertexAttribArray(tex0Loc);
+
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_guiBatchIndexVBO);
+  glDrawElements(GL_TRIANGLES, m_guiBatchVertices.size() * 6 / 4, GL_UNSIGNED_SHORT, 0);
+  AddDrawCall();
+
+  if (multi)
+    glDisableVertexAttribArray(tex1Loc);
+
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glEnable(GL_BLEND);
+
+  DisableGUIShader();
+
+  m_guiBatchVertices.clear();
+  m_guiBatchFlushing = false;
+}
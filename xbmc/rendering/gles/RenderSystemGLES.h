@@ -14,6 +14,7 @@
 #include "GLESShader.h"
 
 #include <array>
+#include <vector>
 
 enum ESHADERMETHOD
 {
@@ -31,6 +32,30 @@ enum ESHADERMETHOD
   SM_MAX
 };
 
+/*!
+ \brief Vertex of a textured GUI quad, see CRenderSystemGLES::AddGUIQuads
+ */
+struct SGUIBatchVertex
+{
+  float x, y, z;
+  float u1, v1;
+  float u2, v2;
+};
+
+/*!
+ \brief Render state shared by all quads of a GUI batch
+ */
+struct SGUIBatchState
+{
+  GLuint texture = 0;
+  GLuint diffuse = 0;
+  ESHADERMETHOD method = SM_TEXTURE;
+  bool blend = true;
+  GLubyte col[4] = {};
+
+  bool operator==(const SGUIBatchState& right) const;
+};
+
 class CRenderSystemGLES : public CRenderSystemBase
 {
 public:
@@ -86,10 +111,22 @@ public:
   GLint GUIShaderGetBrightness();
   GLint GUIShaderGetModel();
 
+  /*!
+   \brief Queue textured quads for rendering
+   Consecutive quads with an equal render state are drawn with a single draw
+   call once the state changes or the batch is flushed.
+   \param state the textures, shader and blending to draw the quads with
+   \param vertices four vertices per quad
+   \param count number of vertices
+   */
+  void AddGUIQuads(const SGUIBatchState& state, const SGUIBatchVertex* vertices, size_t count);
+  void FlushGUIBatch() override;
+
 protected:
   virtual void SetVSyncImpl(bool enable) = 0;
   virtual void PresentRenderImpl(bool rendered) = 0;
   void CalculateMaxTexturesize();
+  void DrawGUIBatch();
 
   bool m_bVsyncInit{false};
   int m_width;
@@ -101,5 +138,11 @@ protected:
   ESHADERMETHOD m_method = SM_DEFAULT;
 
   GLint      m_viewPort[4];
+
+  SGUIBatchState m_guiBatchState;
+  std::vector<SGUIBatchVertex> m_guiBatchVertices;
+  GLuint m_guiBatchVertexVBO = 0;
+  GLuint m_guiBatchIndexVBO = 0;
+  bool m_guiBatchFlushing = false;
 };
 
@@ -135,6 +135,7 @@ void CAdvancedSettings::Initialize()
   //default hold time of 25 ms, this allows a 20 hertz sine to pass undistorted
   m_limiterHold = 0.025f;
   m_limiterRelease = 0.1f;
+  m_audioLowLatency = false;
 
   m_seekSteps = { 10, 30, 60, 180, 300, 600, 1800 };
 
@@ -176,6 +177,7 @@ void CAdvancedSettings::Initialize()
   m_videoFpsDetect = 1;
   m_maxTempo = 1.55f;
   m_videoPreferStereoStream = false;
+  m_videoPacketQueueRingSize = 0;
 
   m_mediacodecForceSoftwareRendering = false;
 
@@ -365,6 +367,7 @@ void CAdvancedSettings::Initialize()
   m_curlconnecttimeout = 30;
   m_curllowspeedtime = 20;
   m_curlretries = 2;
+  m_curlParallelConnections = 1;
   m_curlDisableIPV6 = false;      //Certain hardware/OS combinations have trouble
                                   //with ipv6.
 
@@ -409,6 +412,8 @@ void CAdvancedSettings::Initialize()
   // the following setting determines the readRate of a player data
   // as multiply of the default data read rate
   m_cacheReadFactor = 4.0f;
+  m_cacheMemoryMapLocal = false;
+  m_cacheSegmentCacheSize = 0;
 
   m_addonPackageFolderSize = 200;
 
@@ -421,11 +426,22 @@ void CAdvancedSettings::Initialize()
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiTrackInfoDependencies = true;
+  m_guiTextureAtlas = false;
+  m_guiParallelSkinLoad = false;
+  m_guiFontGlyphAtlas = false;
+  m_guiTextLayoutCacheSize = 1024;
+  m_guiPartialPresent = false;
+  m_guiTextureUploadBudget = 3;
+  m_guiDeferLabelFormatting = false;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
 
   m_databaseMusic.Reset();
   m_databaseVideo.Reset();
+  m_databasePoolSize = 4;
+  m_databaseWalMode = true;
+  m_databaseBatchSize = 200;
 
   m_pictureExtensions = ".png|.jpg|.jpeg|.bmp|.gif|.ico|.tif|.tiff|.tga|.pcx|.cbz|.zip|.rss|.webp|.jp2|.apng";
   m_musicExtensions = ".nsv|.m4a|.flac|.aac|.strm|.pls|.rm|.rma|.mpa|.wav|.wma|.ogg|.mp3|.mp2|.m3u|.gdm|.imf|.m15|.sfx|.uni|.ac3|.dts|.cue|.aif|.aiff|.wpl|.xspf|.ape|.mac|.mpc|.mp+|.mpp|.shn|.zip|.wv|.dsp|.xsp|.xwav|.waa|.wvs|.wam|.gcm|.idsp|.mpdsp|.mss|.spt|.rsd|.sap|.cmc|.cmr|.dmc|.mpt|.mpd|.rmt|.tmc|.tm8|.tm2|.oga|.url|.pxml|.tta|.rss|.wtv|.mka|.tak|.opus|.dff|.dsf|.m4b";
@@ -576,6 +592,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
     XMLUtils::GetFloat(pElement, "limiterhold", m_limiterHold, 0.0f, 100.0f);
     XMLUtils::GetFloat(pElement, "limiterrelease", m_limiterRelease, 0.001f, 100.0f);
+    XMLUtils::GetBoolean(pElement, "lowlatency", m_audioLowLatency);
   }
 
   pElement = pRootElement->FirstChildElement("omx");
@@ -740,6 +757,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "fpsdetect", m_videoFpsDetect, 0, 2);
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
+    // size of the lock-free packet ring of the audio/video player queues, 0 = locked list only
+    XMLUtils::GetUInt(pElement, "packetqueueringsize", m_videoPacketQueueRingSize, 0, 65536);
 
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
@@ -856,6 +875,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "curllowspeedtime", m_curllowspeedtime, 1, 1000);
     XMLUtils::GetInt(pElement, "curlretries", m_curlretries, 0, 10);
     XMLUtils::GetBoolean(pElement,"disableipv6", m_curlDisableIPV6);
+    XMLUtils::GetInt(pElement, "curlparallelconnections", m_curlParallelConnections, 1, 16);
   }
 
   pElement = pRootElement->FirstChildElement("cache");
@@ -864,6 +884,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "memorysize", m_cacheMemSize);
     XMLUtils::GetUInt(pElement, "buffermode", m_cacheBufferMode, 0, 4);
     XMLUtils::GetFloat(pElement, "readfactor", m_cacheReadFactor);
+    XMLUtils::GetBoolean(pElement, "memorymaplocal", m_cacheMemoryMapLocal);
+    XMLUtils::GetUInt(pElement, "segmentcachesize", m_cacheSegmentCacheSize);
   }
 
   pElement = pRootElement->FirstChildElement("jsonrpc");
@@ -1230,6 +1252,14 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pDatabase, "compression", m_databaseSavestates.compression);
   }
 
+  pElement = pRootElement->FirstChildElement("sqlite");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "poolsize", m_databasePoolSize, 0, 16);
+    XMLUtils::GetBoolean(pElement, "walmode", m_databaseWalMode);
+    XMLUtils::GetUInt(pElement, "batchsize", m_databaseBatchSize, 0, 10000);
+  }
+
   pElement = pRootElement->FirstChildElement("enablemultimediakeys");
   if (pElement)
   {
@@ -1242,6 +1272,14 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetBoolean(pElement, "trackinfodependencies", m_guiTrackInfoDependencies);
+    XMLUtils::GetBoolean(pElement, "textureatlas", m_guiTextureAtlas);
+    XMLUtils::GetBoolean(pElement, "parallelskinload", m_guiParallelSkinLoad);
+    XMLUtils::GetBoolean(pElement, "fontglyphatlas", m_guiFontGlyphAtlas);
+    XMLUtils::GetInt(pElement, "textlayoutcachesize", m_guiTextLayoutCacheSize, 0, 65536);
+    XMLUtils::GetBoolean(pElement, "partialpresent", m_guiPartialPresent);
+    XMLUtils::GetInt(pElement, "textureuploadbudget", m_guiTextureUploadBudget, 0, 100);
+    XMLUtils::GetBoolean(pElement, "deferlabelformatting", m_guiDeferLabelFormatting);
   }
 
   std::string seekSteps;
@@ -132,6 +132,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_VideoPlayerIgnoreDTSinWAV;
     float m_limiterHold;
     float m_limiterRelease;
+    bool m_audioLowLatency; /*!< request small sink periods and keep the sink buffer as short as playback without underruns allows */
 
     bool  m_omxDecodeStartWithValidFrame;
 
@@ -183,6 +184,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_mediacodecForceSoftwareRendering;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
+    unsigned int m_videoPacketQueueRingSize;
 
     std::string m_videoDefaultPlayer;
     float m_videoPlayCountMinimumPercent;
@@ -299,6 +301,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_curllowspeedtime;
     int m_curlretries;
     bool m_curlDisableIPV6;
+    int m_curlParallelConnections;
 
     bool m_fullScreen;
     bool m_startFullScreen;
@@ -339,15 +342,28 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     DatabaseSettings m_databaseTV;    // advanced tv database setup
     DatabaseSettings m_databaseEpg;   /*!< advanced EPG database setup */
     DatabaseSettings m_databaseSavestates; /*!< advanced savestate database setup */
+    unsigned int m_databasePoolSize; /*!< idle sqlite connections kept per database, 0 disables pooling */
+    bool m_databaseWalMode; /*!< use write-ahead logging for sqlite databases */
+    unsigned int m_databaseBatchSize; /*!< items per transaction while library scanners write in batches, 0 disables */
 
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    bool m_guiTrackInfoDependencies; /*!< only re-evaluate info bools whose inputs signalled a change */
+    bool m_guiTextureAtlas; /*!< pack small bundled skin textures into shared atlas pages */
+    bool m_guiParallelSkinLoad; /*!< parse the skin XML files on the job manager threads while loading the skin */
+    bool m_guiFontGlyphAtlas; /*!< share one distance field glyph cache between all sizes of a font face */
+    int  m_guiTextLayoutCacheSize; /*!< number of text layouts shared between controls, 0 disables the cache */
+    bool m_guiPartialPresent; /*!< redraw and present only what changed since the back buffer was on screen, needs EGL_EXT_buffer_age */
+    int  m_guiTextureUploadBudget; /*!< milliseconds per frame spent uploading background loaded images to the GPU, 0 uploads all at once */
+    bool m_guiDeferLabelFormatting; /*!< format list item labels once a container shows them instead of when the list is loaded */
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
     unsigned int m_cacheBufferMode;
     float m_cacheReadFactor;
+    bool m_cacheMemoryMapLocal;
+    unsigned int m_cacheSegmentCacheSize; // MB, 0 disables the persistent segment cache
 
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
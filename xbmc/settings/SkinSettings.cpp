@@ -49,6 +49,7 @@ const std::string& CSkinSettings::GetString(int setting) const
 void CSkinSettings::SetString(int setting, const std::string &label)
 {
   g_SkinInfo->SetString(setting, label);
+  ++m_changeCounter;
 }
 
 int CSkinSettings::TranslateBool(const std::string &setting)
@@ -64,16 +65,19 @@ bool CSkinSettings::GetBool(int setting) const
 void CSkinSettings::SetBool(int setting, bool set)
 {
   g_SkinInfo->SetBool(setting, set);
+  ++m_changeCounter;
 }
 
 void CSkinSettings::Reset(const std::string &setting)
 {
   g_SkinInfo->Reset(setting);
+  ++m_changeCounter;
 }
 
 void CSkinSettings::Reset()
 {
   g_SkinInfo->Reset();
+  ++m_changeCounter;
 
   CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
   infoMgr.ResetCache();
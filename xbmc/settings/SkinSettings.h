@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <set>
 #include <string>
 
@@ -39,6 +40,9 @@ public:
   void Reset(const std::string &setting);
   void Reset();
 
+  /*! \brief Counter incremented whenever a skin setting changes */
+  const std::atomic<unsigned int>& GetChangeCounter() const { return m_changeCounter; }
+
 protected:
   CSkinSettings();
   CSkinSettings(const CSkinSettings&) = delete;
@@ -48,4 +52,5 @@ protected:
 private:
   CCriticalSection m_critical;
   std::set<ADDON::CSkinSettingPtr> m_settings;
+  std::atomic<unsigned int> m_changeCounter{0};
 };
@@ -0,0 +1,117 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+/**
+ * Bounded, lock-free ring buffer for exactly one producer and one consumer
+ * thread.
+ *
+ * Push() may only be called from the producer, Pop(), Front() and ForEach()
+ * only from the consumer. Size() and Empty() are safe from any thread but only
+ * return a snapshot. The capacity is rounded up to the next power of two.
+ */
+template<typename T>
+class CSPSCRingBuffer
+{
+public:
+  explicit CSPSCRingBuffer(size_t capacity = 0)
+  {
+    Reserve(capacity);
+  }
+
+  CSPSCRingBuffer(const CSPSCRingBuffer&) = delete;
+  CSPSCRingBuffer& operator=(const CSPSCRingBuffer&) = delete;
+
+  /**
+   * (Re)allocate the storage. Must not be called while producer or consumer
+   * are active, any contained items are dropped.
+   */
+  void Reserve(size_t capacity)
+  {
+    size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+
+    m_buffer.assign(capacity ? size : 0, T());
+    m_mask = m_buffer.empty() ? 0 : m_buffer.size() - 1;
+    m_readPos.store(0, std::memory_order_relaxed);
+    m_writePos.store(0, std::memory_order_relaxed);
+  }
+
+  size_t Capacity() const { return m_buffer.size(); }
+
+  bool Push(const T& item)
+  {
+    const size_t write = m_writePos.load(std::memory_order_relaxed);
+    if (write - m_readPos.load(std::memory_order_acquire) >= m_buffer.size())
+      return false;
+
+    m_buffer[write & m_mask] = item;
+    m_writePos.store(write + 1, std::memory_order_release);
+    return true;
+  }
+
+  bool Pop(T& item)
+  {
+    const size_t read = m_readPos.load(std::memory_order_relaxed);
+    if (read == m_writePos.load(std::memory_order_acquire))
+      return false;
+
+    item = m_buffer[read & m_mask];
+    m_buffer[read & m_mask] = T();
+    m_readPos.store(read + 1, std::memory_order_release);
+    return true;
+  }
+
+  /** Returns a pointer to the oldest item or nullptr if the buffer is empty */
+  const T* Front() const
+  {
+    const size_t read = m_readPos.load(std::memory_order_relaxed);
+    if (read == m_writePos.load(std::memory_order_acquire))
+      return nullptr;
+
+    return &m_buffer[read & m_mask];
+  }
+
+  /** Visit all items from oldest to newest without removing them */
+  template<typename F>
+  void ForEach(F&& func) const
+  {
+    const size_t write = m_writePos.load(std::memory_order_acquire);
+    for (size_t pos = m_readPos.load(std::memory_order_relaxed); pos != write; ++pos)
+      func(m_buffer[pos & m_mask]);
+  }
+
+  size_t Size() const
+  {
+    // load the read position first, the write position can only be ahead of it
+    const size_t read = m_readPos.load(std::memory_order_acquire);
+    return m_writePos.load(std::memory_order_acquire) - read;
+  }
+
+  bool Empty() const { return Size() == 0; }
+
+private:
+  std::vector<T> m_buffer;
+  size_t m_mask = 0;
+
+  // keep producer and consumer indices on separate cache lines. Padding
+  // rather than alignas, over-aligned types aren't allocated correctly by
+  // new before C++17.
+  static const size_t CACHE_LINE_SIZE = 64;
+  char m_padding0[CACHE_LINE_SIZE];
+  std::atomic<size_t> m_readPos{0};
+  char m_padding1[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+  std::atomic<size_t> m_writePos{0};
+  char m_padding2[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
@@ -0,0 +1,198 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/Event.h"
+#include "threads/IRunnable.h"
+#include "threads/SPSCRingBuffer.h"
+
+#include "threads/test/TestHelpers.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace
+{
+
+class producer : public IRunnable
+{
+  CSPSCRingBuffer<int>& ring;
+  int count;
+public:
+  producer(CSPSCRingBuffer<int>& r, int c) : ring(r), count(c) {}
+
+  void Run() override
+  {
+    for (int i = 1; i <= count; i++)
+    {
+      while (!ring.Push(i))
+        std::this_thread::yield();
+    }
+  }
+};
+
+// hands every item it gets back right away, like an audio stream filling the buffers of the engine
+class echo : public IRunnable
+{
+  CSPSCRingBuffer<int>& in;
+  CSPSCRingBuffer<int>& out;
+  CEvent& inEvent;
+  CEvent& outEvent;
+  int count;
+public:
+  echo(CSPSCRingBuffer<int>& i, CSPSCRingBuffer<int>& o, CEvent& ie, CEvent& oe, int c) :
+    in(i), out(o), inEvent(ie), outEvent(oe), count(c) {}
+
+  void Run() override
+  {
+    int value;
+    for (int i = 0; i < count; )
+    {
+      if (in.Pop(value))
+      {
+        out.Push(value);
+        outEvent.Set();
+        i++;
+      }
+      else if (!inEvent.WaitMSec(1000))
+        break;
+    }
+  }
+};
+
+}
+
+TEST(TestSPSCRingBuffer, General)
+{
+  CSPSCRingBuffer<int> ring(3);
+  EXPECT_EQ(4u, ring.Capacity());
+  EXPECT_TRUE(ring.Empty());
+  EXPECT_EQ(nullptr, ring.Front());
+
+  for (int i = 0; i < 4; i++)
+    EXPECT_TRUE(ring.Push(i));
+  EXPECT_FALSE(ring.Push(4));
+  EXPECT_EQ(4u, ring.Size());
+  EXPECT_EQ(0, *ring.Front());
+
+  int sum = 0;
+  ring.ForEach([&sum](int value){ sum += value; });
+  EXPECT_EQ(6, sum);
+
+  int value = -1;
+  EXPECT_TRUE(ring.Pop(value));
+  EXPECT_EQ(0, value);
+  EXPECT_TRUE(ring.Push(4));
+
+  for (int i = 1; i <= 4; i++)
+  {
+    EXPECT_TRUE(ring.Pop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_FALSE(ring.Pop(value));
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(TestSPSCRingBuffer, NotOverAligned)
+{
+  // owners are created with new, which doesn't honour extended alignment before C++17
+  static_assert(alignof(CSPSCRingBuffer<int>) <= alignof(std::max_align_t), "ring buffer is over-aligned");
+
+  std::unique_ptr<CSPSCRingBuffer<int>> ring(new CSPSCRingBuffer<int>(2));
+  EXPECT_TRUE(ring->Push(1));
+  int value = 0;
+  EXPECT_TRUE(ring->Pop(value));
+  EXPECT_EQ(1, value);
+}
+
+TEST(TestSPSCRingBuffer, ProducerConsumer)
+{
+  const int count = 1000000;
+  CSPSCRingBuffer<int> ring(256);
+
+  producer p(ring, count);
+  thread t(p);
+
+  int expected = 1;
+  while (expected <= count)
+  {
+    int value;
+    if (!ring.Pop(value))
+    {
+      std::this_thread::yield();
+      continue;
+    }
+    ASSERT_EQ(expected, value);
+    expected++;
+  }
+
+  t.join();
+  EXPECT_TRUE(ring.Empty());
+}
+
+TEST(TestSPSCRingBuffer, SignalledLatency)
+{
+  // round trip of an item through two rings with event signalling, the way the
+  // audio engine exchanges sample buffers with its streams
+  const int count = 10000;
+  CSPSCRingBuffer<int> toEcho(16);
+  CSPSCRingBuffer<int> fromEcho(16);
+  CEvent echoEvent;
+  CEvent event;
+
+  echo e(toEcho, fromEcho, echoEvent, event, count);
+  thread t(e);
+
+  // buckets of powers of two microseconds, the last one collects everything above
+  std::vector<unsigned int> histogram(16, 0);
+  std::vector<int64_t> latencies;
+  latencies.reserve(count);
+
+  for (int i = 0; i < count; i++)
+  {
+    auto start = std::chrono::steady_clock::now();
+    ASSERT_TRUE(toEcho.Push(i));
+    echoEvent.Set();
+
+    int value;
+    while (!fromEcho.Pop(value))
+      ASSERT_TRUE(event.WaitMSec(1000));
+    ASSERT_EQ(i, value);
+
+    int64_t us = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+    latencies.push_back(us);
+
+    size_t bucket = 0;
+    while (bucket < histogram.size() - 1 && us >= (1 << bucket))
+      bucket++;
+    histogram[bucket]++;
+  }
+
+  t.join();
+  EXPECT_TRUE(toEcho.Empty());
+  EXPECT_TRUE(fromEcho.Empty());
+
+  std::sort(latencies.begin(), latencies.end());
+  std::cout << "round trip latency of " << count << " items: median " << latencies[count / 2]
+            << " us, 99th percentile " << latencies[count * 99 / 100]
+            << " us, max " << latencies.back() << " us" << std::endl;
+  for (size_t bucket = 0; bucket < histogram.size(); bucket++)
+  {
+    if (!histogram[bucket])
+      continue;
+    if (bucket < histogram.size() - 1)
+      std::cout << "  < " << std::setw(5) << (1 << bucket) << " us: " << histogram[bucket] << std::endl;
+    else
+      std::cout << "  >=" << std::setw(5) << (1 << (bucket - 1)) << " us: " << histogram[bucket] << std::endl;
+  }
+}
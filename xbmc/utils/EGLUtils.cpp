@@ -17,6 +17,7 @@
 
 #include <EGL/eglext.h>
 
+#include <cmath>
 #include <map>
 
 namespace
@@ -461,10 +462,22 @@ void CEGLContextUtils::SurfaceAttrib()
     throw std::logic_error("Setting surface attributes requires a surface");
   }
 
-  // for the non-trivial dirty region modes, we need the EGL buffer to be preserved across updates
-  int guiAlgorithmDirtyRegions = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiAlgorithmDirtyRegions;
-  if (guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_COST_REDUCTION ||
-      guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_UNION)
+  m_hasBufferAge = CEGLUtils::HasExtension(m_eglDisplay, "EGL_EXT_buffer_age");
+  m_swapBuffersWithDamage = nullptr;
+  // the KHR and EXT versions have the same signature
+  if (CEGLUtils::HasExtension(m_eglDisplay, "EGL_KHR_swap_buffers_with_damage"))
+    m_swapBuffersWithDamage = CEGLUtils::GetRequiredProcAddress<SwapBuffersWithDamageProc>("eglSwapBuffersWithDamageKHR");
+  else if (CEGLUtils::HasExtension(m_eglDisplay, "EGL_EXT_swap_buffers_with_damage"))
+    m_swapBuffersWithDamage = CEGLUtils::GetRequiredProcAddress<SwapBuffersWithDamageProc>("eglSwapBuffersWithDamageEXT");
+
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  // for the non-trivial dirty region modes, we need the EGL buffer to be preserved across updates,
+  // unless the GUI redraws what changed since the back buffer was presented
+  int guiAlgorithmDirtyRegions = advancedSettings->m_guiAlgorithmDirtyRegions;
+  if ((guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_COST_REDUCTION ||
+       guiAlgorithmDirtyRegions == DIRTYREGION_SOLVER_UNION) &&
+      !(advancedSettings->m_guiPartialPresent && m_hasBufferAge))
   {
     if (eglSurfaceAttrib(m_eglDisplay, m_eglSurface, EGL_SWAP_BEHAVIOR, EGL_BUFFER_PRESERVED) != EGL_TRUE)
     {
@@ -582,5 +595,53 @@ bool CEGLContextUtils::TrySwapBuffers()
     return false;
   }
 
-  return (eglSwapBuffers(m_eglDisplay, m_eglSurface) == EGL_TRUE);
+  bool result;
+  if (m_swapBuffersWithDamage && !m_swapDamage.empty())
+    result = (m_swapBuffersWithDamage(m_eglDisplay, m_eglSurface, m_swapDamage.data(), m_swapDamage.size() / 4) == EGL_TRUE);
+  else
+    result = (eglSwapBuffers(m_eglDisplay, m_eglSurface) == EGL_TRUE);
+
+  // the damage only applies to the frame it was set for
+  m_swapDamage.clear();
+  return result;
+}
+
+int CEGLContextUtils::GetBufferAge() const
+{
+  if (!m_hasBufferAge || m_eglDisplay == EGL_NO_DISPLAY || m_eglSurface == EGL_NO_SURFACE)
+  {
+    return 0;
+  }
+
+  EGLint age = 0;
+  if (eglQuerySurface(m_eglDisplay, m_eglSurface, EGL_BUFFER_AGE_EXT, &age) != EGL_TRUE)
+  {
+    return 0;
+  }
+  return age;
+}
+
+void CEGLContextUtils::SetSwapDamage(const CDirtyRegionList& damage)
+{
+  m_swapDamage.clear();
+  if (!m_swapBuffersWithDamage || m_eglDisplay == EGL_NO_DISPLAY || m_eglSurface == EGL_NO_SURFACE)
+  {
+    return;
+  }
+
+  EGLint height = 0;
+  if (eglQuerySurface(m_eglDisplay, m_eglSurface, EGL_HEIGHT, &height) != EGL_TRUE)
+  {
+    return;
+  }
+
+  // EGL wants x, y, width, height with the origin at the bottom left
+  for (const auto& region : damage)
+  {
+    EGLint x1 = static_cast<EGLint>(std::floor(region.x1));
+    EGLint y1 = static_cast<EGLint>(std::floor(region.y1));
+    EGLint x2 = static_cast<EGLint>(std::ceil(region.x2));
+    EGLint y2 = static_cast<EGLint>(std::ceil(region.y2));
+    m_swapDamage.insert(m_swapDamage.end(), { x1, height - y2, x2 - x1, y2 - y1 });
+  }
 }
@@ -14,7 +14,10 @@
 #include <stdexcept>
 #include <vector>
 
+#include "guilib/DirtyRegion.h"
+
 #include <EGL/egl.h>
+#include <EGL/eglext.h>
 
 class CEGLUtils
 {
@@ -196,6 +199,25 @@ public:
   bool IsPlatformSupported() const;
   EGLint GetConfigAttrib(EGLint attribute) const;
 
+  /**
+   * Get the age of the back buffer with EGL_EXT_buffer_age
+   *
+   * \return number of frames since the back buffer was presented, 0 if its
+   *         contents are undefined or the extension is not supported
+   */
+  int GetBufferAge() const;
+  /**
+   * Whether \ref GetBufferAge reports the age of the back buffer
+   */
+  bool HasBufferAge() const { return m_hasBufferAge; }
+  /**
+   * Set the regions the next \ref TrySwapBuffers reports as changed with
+   * EGL_KHR_swap_buffers_with_damage, it presents the whole surface otherwise
+   *
+   * \param damage changed regions, with the origin at the top left of the surface
+   */
+  void SetSwapDamage(const CDirtyRegionList& damage);
+
   EGLDisplay GetEGLDisplay() const
   {
     return m_eglDisplay;
@@ -223,4 +245,10 @@ private:
   EGLSurface m_eglSurface{EGL_NO_SURFACE};
   EGLContext m_eglContext{EGL_NO_CONTEXT};
   EGLConfig m_eglConfig{};
+
+  bool m_hasBufferAge{false};
+  // eglSwapBuffersWithDamageKHR/EXT, declared here as older headers lack both
+  typedef EGLBoolean (EGLAPIENTRYP SwapBuffersWithDamageProc)(EGLDisplay dpy, EGLSurface surface, const EGLint* rects, EGLint n_rects);
+  SwapBuffersWithDamageProc m_swapBuffersWithDamage{nullptr};
+  std::vector<EGLint> m_swapDamage;
 };
@@ -80,3 +80,29 @@ TEST_F(TestLabelFormatter, FormatLabel2)
 
   EXPECT_TRUE(XBMC_DELETETEMPFILE(tmpfile));
 }
+
+TEST_F(TestLabelFormatter, DeferredFormatting)
+{
+  auto formatter = std::make_shared<const CLabelFormatter>("%F", "%P");
+
+  CFileItem eager("label");
+  eager.SetPath("special://temp/folder/file.mp3");
+  CFileItem deferred(eager);
+
+  formatter->FormatLabels(&eager);
+  deferred.SetDeferredLabelFormatter(formatter);
+  EXPECT_TRUE(deferred.HasDeferredLabels());
+  EXPECT_EQ("label", deferred.GetLabel());
+
+  // copies format on their own
+  CFileItem copy(deferred);
+  EXPECT_TRUE(copy.HasDeferredLabels());
+
+  deferred.FormatDeferredLabels();
+  EXPECT_FALSE(deferred.HasDeferredLabels());
+  EXPECT_EQ(eager.GetLabel(), deferred.GetLabel());
+  EXPECT_EQ(eager.GetLabel2(), deferred.GetLabel2());
+
+  copy.FormatDeferredLabels();
+  EXPECT_EQ(eager.GetLabel(), copy.GetLabel());
+}
@@ -551,8 +551,8 @@ int CVideoDatabase::GetPathId(const std::string& strPath)
 
     URIUtils::AddSlashAtEnd(strPath1);
 
-    strSQL=PrepareSQL("select idPath from path where strPath='%s'",strPath1.c_str());
-    m_pDS->query(strSQL);
+    strSQL = "select idPath from path where strPath=?";
+    m_pDS->query(strSQL, { field_value(strPath1) });
     if (!m_pDS->eof())
       idPath = m_pDS->fv("path.idPath").get_asInt();
 
@@ -1087,9 +1087,8 @@ int CVideoDatabase::GetFileId(const std::string& strFilenameAndPath)
     int idPath = GetPathId(strPath);
     if (idPath >= 0)
     {
-      std::string strSQL;
-      strSQL=PrepareSQL("select idFile from files where strFileName='%s' and idPath=%i", strFileName.c_str(),idPath);
-      m_pDS->query(strSQL);
+      m_pDS->query("select idFile from files where strFileName=? and idPath=?",
+                   { field_value(strFileName), field_value(idPath) });
       if (m_pDS->num_rows() > 0)
       {
         int idFile = m_pDS->fv("files.idFile").get_asInt();
@@ -1434,6 +1433,15 @@ int CVideoDatabase::AddToTable(const std::string& table, const std::string& firs
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
+    const std::string cacheKey = GetBatchCacheKey(table, value.substr(0, 255));
+    if (!cacheKey.empty())
+    {
+      auto it = m_batchIdCache.find(cacheKey);
+      if (it != m_batchIdCache.end())
+        return it->second;
+    }
+
+    int id;
     std::string strSQL = PrepareSQL("select %s from %s where %s like '%s'", firstField.c_str(), table.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
     m_pDS->query(strSQL);
     if (m_pDS->num_rows() == 0)
@@ -1442,15 +1450,17 @@ int CVideoDatabase::AddToTable(const std::string& table, const std::string& firs
       // doesnt exists, add it
       strSQL = PrepareSQL("insert into %s (%s, %s) values(NULL, '%s')", table.c_str(), firstField.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
       m_pDS->exec(strSQL);
-      int id = (int)m_pDS->lastinsertid();
-      return id;
+      id = (int)m_pDS->lastinsertid();
     }
     else
     {
-      int id = m_pDS->fv(firstField.c_str()).get_asInt();
+      id = m_pDS->fv(firstField.c_str()).get_asInt();
       m_pDS->close();
-      return id;
     }
+
+    if (!cacheKey.empty())
+      m_batchIdCache[cacheKey] = id;
+    return id;
   }
   catch (...)
   {
@@ -1637,27 +1647,39 @@ int CVideoDatabase::AddActor(const std::string& name, const std::string& thumbUR
     std::string trimmedName = name.c_str();
     StringUtils::Trim(trimmedName);
 
-    std::string strSQL=PrepareSQL("select actor_id from actor where name like '%s'", trimmedName.substr(0, 255).c_str());
-    m_pDS->query(strSQL);
-    if (m_pDS->num_rows() == 0)
+    const std::string cacheKey = GetBatchCacheKey("actor", trimmedName.substr(0, 255));
+    auto cached = m_batchIdCache.end();
+    if (!cacheKey.empty())
+      cached = m_batchIdCache.find(cacheKey);
+
+    std::string strSQL;
+    if (cached != m_batchIdCache.end())
+      idActor = cached->second;
+    else
     {
+      strSQL=PrepareSQL("select actor_id from actor where name like '%s'", trimmedName.substr(0, 255).c_str());
+      m_pDS->query(strSQL);
+      if (m_pDS->num_rows() > 0)
+        idActor = m_pDS->fv(0).get_asInt();
       m_pDS->close();
+    }
+
+    if (idActor < 0)
+    {
       // doesnt exists, add it
       strSQL=PrepareSQL("insert into actor (actor_id, name, art_urls) values(NULL, '%s', '%s')", trimmedName.substr(0,255).c_str(), thumbURLs.c_str());
       m_pDS->exec(strSQL);
       idActor = (int)m_pDS->lastinsertid();
     }
-    else
+    else if (!thumbURLs.empty())
     {
-      idActor = m_pDS->fv(0).get_asInt();
-      m_pDS->close();
       // update the thumb url's
-      if (!thumbURLs.empty())
-      {
-        strSQL=PrepareSQL("update actor set art_urls = '%s' where actor_id = %i", thumbURLs.c_str(), idActor);
-        m_pDS->exec(strSQL);
-      }
+      strSQL=PrepareSQL("update actor set art_urls = '%s' where actor_id = %i", thumbURLs.c_str(), idActor);
+      m_pDS->exec(strSQL);
     }
+
+    if (!cacheKey.empty())
+      m_batchIdCache[cacheKey] = idActor;
     // add artwork
     if (!thumb.empty())
       SetArtForItem(idActor, "actor", "thumb", thumb);
@@ -1672,6 +1694,21 @@ int CVideoDatabase::AddActor(const std::string& name, const std::string& thumbUR
 
 
 
+std::string CVideoDatabase::GetBatchCacheKey(const std::string &table, const std::string &value) const
+{
+  if (!IsBatching() || value.find_first_of("%_") != std::string::npos)
+    return std::string();
+
+  std::string key = table + "|" + value;
+  StringUtils::ToLower(key);
+  return key;
+}
+
+void CVideoDatabase::EmptyBatchCache()
+{
+  m_batchIdCache.clear();
+}
+
 void CVideoDatabase::AddLinkToActor(int mediaId, const char *mediaType, int actorId, const std::string &role, int order)
 {
   std::string sql=PrepareSQL("SELECT 1 FROM actor_link WHERE actor_id=%i AND media_id=%i AND media_type='%s'", actorId, mediaId, mediaType);
@@ -7018,6 +7055,46 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
+    auto addMovie = [&](const dbiplus::sql_record* const record)
+    {
+      CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
+      if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
+          g_passwordManager.bMasterUser                                   ||
+          g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
+      {
+        CFileItemPtr pItem(new CFileItem(movie));
+
+        CVideoDbUrl itemUrl = videoUrl;
+        std::string path = StringUtils::Format("%i", movie.m_iDbId);
+        itemUrl.AppendPath(path);
+        pItem->SetPath(itemUrl.ToString());
+        pItem->SetDynPath(movie.m_strFileNameAndPath);
+
+        pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
+        items.Add(pItem);
+      }
+    };
+
+    // without sorting the rows are used in query order, so they can be
+    // streamed into items instead of materializing the whole result first
+    if (sortDescription.sortBy == SortByNone)
+    {
+      unsigned int time = XbmcThreads::SystemClockMillis();
+      int iRowsFound = 0;
+      m_pDS->stream_query(strSQL);
+      while (m_pDS->stream_next())
+      {
+        addMovie(m_pDS->stream_record());
+        iRowsFound++;
+      }
+      m_pDS->close();
+      CLog::Log(LOGDEBUG, LOGDATABASE, "%s streamed %d items in %d ms: %s", __FUNCTION__, iRowsFound, XbmcThreads::SystemClockMillis() - time, strSQL.c_str());
+
+      if (iRowsFound > 0)
+        items.SetProperty("total", std::max(total, iRowsFound));
+      return true;
+    }
+
     int iRowsFound = RunQuery(strSQL);
     if (iRowsFound <= 0)
       return iRowsFound == 0;
@@ -7039,24 +7116,7 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
     for (const auto &i : results)
     {
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
-      const dbiplus::sql_record* const record = data.at(targetRow);
-
-      CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
-      if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
-          g_passwordManager.bMasterUser                                   ||
-          g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
-      {
-        CFileItemPtr pItem(new CFileItem(movie));
-
-        CVideoDbUrl itemUrl = videoUrl;
-        std::string path = StringUtils::Format("%i", movie.m_iDbId);
-        itemUrl.AppendPath(path);
-        pItem->SetPath(itemUrl.ToString());
-        pItem->SetDynPath(movie.m_strFileNameAndPath);
-
-        pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
-        items.Add(pItem);
-      }
+      addMovie(data.at(targetRow));
     }
 
     // cleanup
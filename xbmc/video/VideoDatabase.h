@@ -1006,4 +1006,13 @@ private:
 
   static void AnnounceRemove(std::string content, int id, bool scanning = false);
   static void AnnounceUpdate(std::string content, int id);
+
+  /*! \brief Key for m_batchIdCache, empty if the lookup can't be cached.
+   Values are matched with LIKE, so keys are case folded and values
+   containing wildcards are not cached.
+   */
+  std::string GetBatchCacheKey(const std::string &table, const std::string &value) const;
+  void EmptyBatchCache() override;
+
+  std::map<std::string, int> m_batchIdCache; ///< ids of actors, genres, studios, ... added during a batch
 };
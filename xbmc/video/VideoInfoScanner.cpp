@@ -409,6 +409,8 @@ namespace VIDEO
     }
 
     m_database.Open();
+    // group the writes of the items into larger transactions
+    m_database.BeginBatch();
 
     bool FoundSomeInfo = false;
     std::vector<int> seenPaths;
@@ -498,6 +500,7 @@ namespace VIDEO
     if(pDlgProgress)
       pDlgProgress->ShowProgressBar(false);
 
+    m_database.EndBatch();
     m_database.Close();
     return FoundSomeInfo;
   }
@@ -812,6 +815,7 @@ namespace VIDEO
 
       if (updateSeasonArt)
       {
+        m_database.FlushBatch();
         CVideoInfoDownloader loader(scraper);
         loader.GetArtwork(showInfo);
         GetSeasonThumbs(showInfo, seasonArt, CVideoThumbLoader::GetArtTypes(MediaTypeSeason), useLocal && !item->IsPlugin());
@@ -1631,6 +1635,7 @@ namespace VIDEO
             pDlgProgress->Progress();
           }
 
+          m_database.FlushBatch();
           CVideoInfoDownloader imdb(scraper);
           if (!imdb.GetEpisodeList(url, episodes))
             return INFO_NOT_FOUND;
@@ -1729,6 +1734,7 @@ namespace VIDEO
 
       if (bFound)
       {
+        m_database.FlushBatch();
         CVideoInfoDownloader imdb(scraper);
         CFileItem item;
         item.SetPath(file->strPath);
@@ -1764,6 +1770,8 @@ namespace VIDEO
     if (m_handle && !url.strTitle.empty())
       m_handle->SetText(url.strTitle);
 
+    // don't keep the library locked while waiting for the scraper
+    m_database.FlushBatch();
     CVideoInfoDownloader imdb(scraper);
     bool ret = imdb.GetDetails(url, movieDetails, pDialog);
 
@@ -2051,6 +2059,7 @@ namespace VIDEO
   int CVideoInfoScanner::FindVideo(const std::string &title, int year, const ScraperPtr &scraper, CScraperUrl &url, CGUIDialogProgress *progress)
   {
     MOVIELIST movielist;
+    m_database.FlushBatch();
     CVideoInfoDownloader imdb(scraper);
     int returncode = imdb.FindMovie(title, year, movielist, progress);
     if (returncode < 0 || (returncode == 0 && (m_bStop || !DownloadFailed(progress))))
@@ -512,6 +512,9 @@ void CGUIWindowVideoBase::AddItemToPlayList(const CFileItemPtr &pItem, CFileItem
   }
   else
   {
+    // the playlist shows the labels of the item, which no container may have formatted yet
+    pItem->FormatDeferredLabels();
+
     // just an item
     if (pItem->IsPlayList())
     {
@@ -11,6 +11,7 @@
 #include "OSScreenSaver.h"
 #include "VideoSync.h"
 #include "WinEvents.h"
+#include "guilib/DirtyRegion.h"
 #include "guilib/DispResource.h"
 #include "Resolution.h"
 #include <memory>
@@ -86,6 +87,27 @@ public:
    * averaged from past frames and their presentation times
    */
   virtual float GetFrameLatencyAdjustment() { return 0.0; }
+  /**
+   * Get the age of the back buffer the next frame is rendered into
+   *
+   * \return number of frames since the back buffer was presented, or 0 if
+   *         its contents are undefined or the age isn't known
+   */
+  virtual int GetBufferAge() { return 0; }
+  /**
+   * Whether \ref GetBufferAge reports the age of the back buffer, without it
+   * the whole back buffer has to be redrawn every frame it is presented
+   */
+  virtual bool SupportsBufferAge() { return false; }
+  /**
+   * Limit the next presentation to the regions that changed
+   *
+   * Only a hint, the whole back buffer must be up to date when presenting.
+   *
+   * \param damage regions that changed since the last presented frame, in
+   *        GUI coordinates
+   */
+  virtual void SetPresentDamage(const CDirtyRegionList& damage) {}
 
   virtual bool Minimize() { return false; }
   virtual bool Restore() { return false; }
@@ -111,6 +111,21 @@ float CWinSystemAndroidGLESContext::GetFrameLatencyAdjustment()
   return CXBMCApp::GetFrameLatencyMs();
 }
 
+int CWinSystemAndroidGLESContext::GetBufferAge()
+{
+  return m_pGLContext.GetBufferAge();
+}
+
+bool CWinSystemAndroidGLESContext::SupportsBufferAge()
+{
+  return m_pGLContext.HasBufferAge();
+}
+
+void CWinSystemAndroidGLESContext::SetPresentDamage(const CDirtyRegionList& damage)
+{
+  m_pGLContext.SetSwapDamage(damage);
+}
+
 EGLDisplay CWinSystemAndroidGLESContext::GetEGLDisplay() const
 {
   return m_pGLContext.GetEGLDisplay();
@@ -32,6 +32,9 @@ public:
   virtual std::unique_ptr<CVideoSync> GetVideoSync(void *clock) override;
 
   float GetFrameLatencyAdjustment() override;
+  int GetBufferAge() override;
+  bool SupportsBufferAge() override;
+  void SetPresentDamage(const CDirtyRegionList& damage) override;
 
   EGLDisplay GetEGLDisplay() const;
   EGLSurface GetEGLSurface() const;
@@ -148,3 +148,18 @@ EGLConfig  CWinSystemGbmEGLContext::GetEGLConfig() const
 {
   return m_eglContext.GetEGLConfig();
 }
+
+int CWinSystemGbmEGLContext::GetBufferAge()
+{
+  return m_eglContext.GetBufferAge();
+}
+
+bool CWinSystemGbmEGLContext::SupportsBufferAge()
+{
+  return m_eglContext.HasBufferAge();
+}
+
+void CWinSystemGbmEGLContext::SetPresentDamage(const CDirtyRegionList& damage)
+{
+  m_eglContext.SetSwapDamage(damage);
+}
@@ -32,6 +32,10 @@ public:
                        RESOLUTION_INFO& res) override;
   bool DestroyWindow() override;
 
+  int GetBufferAge() override;
+  bool SupportsBufferAge() override;
+  void SetPresentDamage(const CDirtyRegionList& damage) override;
+
   EGLDisplay GetEGLDisplay() const;
   EGLSurface GetEGLSurface() const;
   EGLContext GetEGLContext() const;
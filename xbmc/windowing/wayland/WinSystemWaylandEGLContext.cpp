@@ -151,3 +151,18 @@ EGLDisplay CWinSystemWaylandEGLContext::GetEGLDisplay() const
 {
   return m_eglContext.GetEGLDisplay();
 }
+
+int CWinSystemWaylandEGLContext::GetBufferAge()
+{
+  return m_eglContext.GetBufferAge();
+}
+
+bool CWinSystemWaylandEGLContext::SupportsBufferAge()
+{
+  return m_eglContext.HasBufferAge();
+}
+
+void CWinSystemWaylandEGLContext::SetPresentDamage(const CDirtyRegionList& damage)
+{
+  m_eglContext.SetSwapDamage(damage);
+}
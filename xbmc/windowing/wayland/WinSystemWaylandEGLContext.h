@@ -32,6 +32,10 @@ public:
   bool DestroyWindow() override;
   bool DestroyWindowSystem() override;
 
+  int GetBufferAge() override;
+  bool SupportsBufferAge() override;
+  void SetPresentDamage(const CDirtyRegionList& damage) override;
+
   EGLDisplay GetEGLDisplay() const;
 
 protected:
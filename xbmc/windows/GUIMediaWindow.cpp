@@ -661,11 +661,12 @@ void CGUIMediaWindow::SortItems(CFileItemList &items)
  * \brief Formats item labels
  *
  * This is based on the formatting provided by guiViewState.
+ * Deferred labels are formatted by the containers once they show the item.
  */
-void CGUIMediaWindow::FormatItemLabels(CFileItemList &items, const LABEL_MASKS &labelMasks)
+void CGUIMediaWindow::FormatItemLabels(CFileItemList &items, const LABEL_MASKS &labelMasks, bool deferred /* = false */)
 {
-  CLabelFormatter fileFormatter(labelMasks.m_strLabelFile, labelMasks.m_strLabel2File);
-  CLabelFormatter folderFormatter(labelMasks.m_strLabelFolder, labelMasks.m_strLabel2Folder);
+  auto fileFormatter = std::make_shared<const CLabelFormatter>(labelMasks.m_strLabelFile, labelMasks.m_strLabel2File);
+  auto folderFormatter = std::make_shared<const CLabelFormatter>(labelMasks.m_strLabelFolder, labelMasks.m_strLabel2Folder);
   for (int i=0; i<items.Size(); ++i)
   {
     CFileItemPtr pItem=items[i];
@@ -673,10 +674,14 @@ void CGUIMediaWindow::FormatItemLabels(CFileItemList &items, const LABEL_MASKS &
     if (pItem->IsLabelPreformatted())
       continue;
 
-    if (pItem->m_bIsFolder)
-      folderFormatter.FormatLabels(pItem.get());
+    const std::shared_ptr<const CLabelFormatter>& formatter = pItem->m_bIsFolder ? folderFormatter : fileFormatter;
+    if (deferred)
+      pItem->SetDeferredLabelFormatter(formatter);
     else
-      fileFormatter.FormatLabels(pItem.get());
+    {
+      pItem->SetDeferredLabelFormatter(nullptr);
+      formatter->FormatLabels(pItem.get());
+    }
   }
 
   if (items.GetSortMethod() == SortByLabel)
@@ -694,11 +699,23 @@ void CGUIMediaWindow::FormatAndSort(CFileItemList &items)
 
   if (viewState.get())
   {
+    unsigned int start = XbmcThreads::SystemClockMillis();
+
+    // the labels are only needed up front to sort by them. Only the items shown
+    // by the containers are deferred, other lists are read right away, e.g. to
+    // queue a folder
+    SortBy sortBy = viewState->GetSortMethod().sortBy;
+    bool deferred = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiDeferLabelFormatting &&
+                    sortBy != SortByLabel && &items == m_vecItems;
+
     LABEL_MASKS labelMasks;
     viewState->GetSortMethodLabelMasks(labelMasks);
-    FormatItemLabels(items, labelMasks);
+    FormatItemLabels(items, labelMasks, deferred);
+
+    items.Sort(sortBy, viewState->GetSortOrder(), viewState->GetSortMethod().sortAttributes);
 
-    items.Sort(viewState->GetSortMethod().sortBy, viewState->GetSortOrder(), viewState->GetSortMethod().sortAttributes);
+    CLog::Log(LOGDEBUG, "CGUIMediaWindow::%s - formatted%s and sorted %i items in %u ms", __FUNCTION__,
+              deferred ? " (deferred)" : "", items.Size(), XbmcThreads::SystemClockMillis() - start);
   }
 }
 
@@ -2043,6 +2060,7 @@ bool CGUIMediaWindow::GetFilteredItems(const std::string &filter, CFileItemList
      else if (item->GetLayout())
      match = item->GetLayout()->GetAllText();
      else*/
+    item->FormatDeferredLabels();
     match = item->GetLabel(); // Filter label only for now
 
     if (numericMatch)
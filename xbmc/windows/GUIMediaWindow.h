@@ -79,7 +79,7 @@ protected:
   virtual bool OnContextButton(int itemNumber, CONTEXT_BUTTON button);
   virtual bool OnAddMediaSource() { return false; };
 
-  virtual void FormatItemLabels(CFileItemList &items, const LABEL_MASKS &labelMasks);
+  virtual void FormatItemLabels(CFileItemList &items, const LABEL_MASKS &labelMasks, bool deferred = false);
   virtual void UpdateButtons();
   void SaveControlStates() override;
   void RestoreControlStates() override;
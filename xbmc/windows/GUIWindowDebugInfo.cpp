@@ -13,6 +13,7 @@
 #include "utils/CPUInfo.h"
 #include "utils/log.h"
 #include "CompileInfo.h"
+#include "DatabaseManager.h"
 #include "filesystem/SpecialProtocol.h"
 #include "input/WindowTranslator.h"
 #include "guilib/GUIComponent.h"
@@ -116,6 +117,13 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
                                 stat.ullAvailPhys/1024, stat.ullTotalPhys/1024, CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetSystemInfoProvider().GetFPS(),
                                 strCores.c_str(), ucAppName.c_str(), dCPU, profiling.c_str());
 #endif
+
+    CDatabaseManager::PoolStats dbStats = CServiceBroker::GetDatabaseManager().GetPoolStats();
+    const unsigned int connects = dbStats.reused + dbStats.opened;
+    if (connects > 0)
+      info += StringUtils::Format("\nDB: %u/%u connections reused - wait avg %u ms, max %u ms",
+                                  dbStats.reused, connects,
+                                  static_cast<unsigned int>(dbStats.totalWaitMs / connects), dbStats.maxWaitMs);
   }
 
   // render the skin debug info